@@ -0,0 +1,701 @@
+/*
+ * Copyright 2021 Philipp Mayer - pmayer@cs.sbg.ac.at
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+	Include standard libraries
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <math.h>
+#include <chrono>
+#include <vector>
+
+/*
+	Include my headers
+*/
+#include "settings.h"
+#include "triangulation.h"
+#include "initialPolygonGenerator.h"
+#include "polygonTransformer.h"
+#include "insertion.h"
+#include "translationRetriangulation.h"
+#include "eventQueue.h"
+#include "selectionTree.h"
+#include "predicates.h"
+#include "randomGenerator.h"
+#include "proposalBuffer.h"
+
+/*
+	fpg_bench runs microbenchmarks of the core kernels of fpg and writes the results as JSON,
+	such that they can be compared across commits:
+		fpg_bench [-s <seed>] [-g <engine>] [-n <sizes>] [-l <label>] [-o <output-file>]
+
+	For each size it generates a polygon with this number of vertices like fpg does with the
+	given seed and measures the kernels on its triangulation. The generation itself is not
+	measured.
+
+	Note:
+		- Sizes are given as comma separated list, the default is 1000,100000,1000000
+		- The engine of the random generator is mt19937 (default) or xoshiro, the draws of
+			both engines get measured anyway
+		- Without output file the JSON gets written to stdout
+		- The label, e.g. the commit, gets copied to the JSON
+*/
+
+typedef std::chrono::steady_clock Clock;
+
+/*
+	The result of one benchmark:
+	name 		The name of the kernel
+	size 		The number of vertices of the triangulation, resp. the size of the data
+				structure
+	ops 		The number of measured operations
+	seconds 	The total time of the measured operations
+*/
+struct BenchResult{
+	const char *name;
+	unsigned int size;
+	unsigned long long ops;
+	double seconds;
+};
+
+/*
+	The results of all benchmarks of the run
+*/
+static std::vector<struct BenchResult> results;
+
+/*
+	Keeps the compiler from optimizing the measured computations away
+*/
+static volatile double sink = 0;
+
+/*
+	The number of measured operations of each kind of benchmark
+*/
+const unsigned long long predicateOps = 1000000;
+const unsigned long long intersectionOps = 1000000;
+const unsigned long long treeOps = 1000000;
+const unsigned long long queueRounds = 10000;
+const unsigned long long simplicityOps = 10000;
+const unsigned long long translationOps = 10000;
+const unsigned long long insertionOps = 1000;
+const unsigned long long randomOps = 10000000;
+
+
+/*
+	Define the class BenchItem:
+	An object with a weight as it is needed for SelectionTrees.
+*/
+class BenchItem{
+
+private:
+
+	double weight;
+	STEntry<BenchItem*> *entry;
+
+public:
+
+	BenchItem(const double w) : weight(w), entry(NULL) {}
+
+	void setSTEntry(STEntry<BenchItem*> *ste){ entry = ste; }
+	void setWeight(const double w){ weight = w; }
+
+	STEntry<BenchItem*> *getSTEntry() const{ return entry; }
+	double getWeight() const{ return weight; }
+};
+
+
+/*
+	@param 	start 	A point in time
+	@return 		The time passed since start in seconds
+*/
+static double since(const Clock::time_point start){
+	return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+/*
+	The function addResult() adds the result of a benchmark to the results and reports it.
+
+	@param 	name 		The name of the kernel
+	@param 	size 		The size of the benchmark
+	@param 	ops 		The number of measured operations
+	@param 	seconds 	The total time of the measured operations
+*/
+static void addResult(const char *name, const unsigned int size, const unsigned long long ops,
+	const double seconds){
+	struct BenchResult r = {name, size, ops, seconds};
+
+	results.push_back(r);
+
+	fprintf(stderr, "%-36s %9u %10llu %14.1f ns/op\n", name, size, ops,
+		ops > 0 ? seconds / ops * 1e9 : 0);
+}
+
+/*
+	The function drawTranslation() draws a translation of a vertex like the translation
+	phases of fpg do.
+
+	@param 	T 		The triangulation the polygon lives in
+	@param 	index 	The index of the moving vertex
+	@param 	dx 		The generated x-component of the translation vector
+	@param 	dy 		The generated y-component of the translation vector
+*/
+static void drawTranslation(Triangulation const * const T, int &index, double &dx, double &dy){
+	Vertex *v;
+	double alpha, stddev, r;
+
+	index = (*Settings::generator).getRandomIndex((*T).getActualNumberOfVertices());
+	v = (*T).getVertex(index);
+
+	alpha = (*Settings::generator).getDoubleUniform(- M_PI, M_PI);
+	stddev = (*v).getDirectedEdgeLength(alpha);
+	r = (*Settings::generator).getDoubleNormal(stddev / 2, stddev / Settings::stddevDiv);
+
+	dx = r * cos(alpha);
+	dy = r * sin(alpha);
+}
+
+/*
+	The function generateTriangulation() generates a polygon with n vertices in the same way
+	fpg does without holes.
+
+	@param 	n 		The number of vertices of the polygon
+	@param 	seed 	The seed of the random generator
+	@return 		The triangulation of the polygon
+*/
+static Triangulation *generateTriangulation(const unsigned int n, const unsigned int seed){
+	Triangulation *T;
+	Clock::time_point start = Clock::now();
+
+	Settings::outerSize = n;
+	Settings::initialSize = n < 20 ? n : 20;
+	Settings::initialTranslationNumber = Settings::initialTranslationFactor * Settings::initialSize;
+
+	if(Settings::generator != NULL)
+		delete Settings::generator;
+	Settings::generator = new RandomGenerator(Settings::randomEngine, seed);
+
+	fprintf(stderr, "Generate a polygon with %u vertices...", n);
+
+	T = generateRegularPolygon();
+	strategyNoHoles0(T);
+
+	fprintf(stderr, "done after %f seconds\n", since(start));
+
+	return T;
+}
+
+
+/*
+	B ~ E ~ N ~ C ~ H ~ M ~ A ~ R ~ K ~ S
+*/
+
+/*
+	The function benchSelectionTree() measures the insertion of n objects into a SelectionTree,
+	the update of the weights of randomly selected objects and the random selection of
+	objects.
+
+	@param 	n 	The number of objects in the tree
+*/
+static void benchSelectionTree(const unsigned int n){
+	SelectionTree<BenchItem*> *tree = new SelectionTree<BenchItem*>(true);
+	std::vector<BenchItem*> items;
+	std::vector<int> indices;
+	std::vector<double> weights;
+	Clock::time_point start;
+	unsigned long long i;
+	BenchItem *item;
+
+	items.reserve(n);
+	for(i = 0; i < n; i++)
+		items.push_back(new BenchItem((*Settings::generator).getDoubleUniform(0, 1)));
+
+	start = Clock::now();
+	for(i = 0; i < n; i++)
+		(*tree).insert(items[i]);
+	addResult("selectionTree.insert", n, n, since(start));
+
+	indices.reserve(treeOps);
+	weights.reserve(treeOps);
+	for(i = 0; i < treeOps; i++){
+		indices.push_back((*Settings::generator).getRandomIndex(n));
+		weights.push_back((*Settings::generator).getDoubleUniform(0, 1));
+	}
+
+	start = Clock::now();
+	for(i = 0; i < treeOps; i++){
+		item = items[indices[i]];
+		(*item).setWeight(weights[i]);
+		(*(*item).getSTEntry()).update();
+	}
+	addResult("selectionTree.update", n, treeOps, since(start));
+
+	start = Clock::now();
+	for(i = 0; i < treeOps; i++)
+		sink = sink + (*(*tree).getRandomObject()).getWeight();
+	addResult("selectionTree.sample", n, treeOps, since(start));
+
+	delete tree;
+	for(auto &it : items)
+		delete it;
+}
+
+/*
+	The function benchRandom() measures the draws of uniformly distributed indices and doubles
+	and of normally distributed doubles of a RandomGenerator.
+
+	@param 	e 		The engine of the RandomGenerator
+	@param 	seed 	The seed of the RandomGenerator
+*/
+static void benchRandom(const RandomEngine e, const unsigned int seed){
+	RandomGenerator gen(e, seed);
+	Clock::time_point start;
+	unsigned long long i;
+	double sum = 0;
+	bool mt = e == RandomEngine::MT19937;
+
+	start = Clock::now();
+	for(i = 0; i < randomOps; i++)
+		sum = sum + gen.getRandomIndex(1000000);
+	addResult(mt ? "random.mt19937.index" : "random.xoshiro.index", 0, randomOps, since(start));
+
+	start = Clock::now();
+	for(i = 0; i < randomOps; i++)
+		sum = sum + gen.getDoubleUniform(- M_PI, M_PI);
+	addResult(mt ? "random.mt19937.uniform" : "random.xoshiro.uniform", 0, randomOps, since(start));
+
+	start = Clock::now();
+	for(i = 0; i < randomOps; i++)
+		sum = sum + gen.getDoubleNormal(0, 1);
+	addResult(mt ? "random.mt19937.normal" : "random.xoshiro.normal", 0, randomOps, since(start));
+
+	sink = sink + sum;
+}
+
+/*
+	The function benchProposals() measures the generation of proposals, i.e. of an index, a
+	direction with its cosine and sine and a normally distributed value, once drawn one by
+	one and once taken from a ProposalBuffer.
+
+	@param 	e 		The engine of the RandomGenerator
+	@param 	seed 	The seed of the RandomGenerator
+*/
+static void benchProposals(const RandomEngine e, const unsigned int seed){
+	RandomGenerator gen(e, seed);
+	ProposalBuffer buffer(&gen);
+	Clock::time_point start;
+	unsigned long long i;
+	double sum = 0, alpha, cosAlpha, sinAlpha, z;
+	int index;
+	bool mt = e == RandomEngine::MT19937;
+
+	start = Clock::now();
+	for(i = 0; i < randomOps; i++){
+		index = gen.getRandomIndex(1000000);
+		alpha = gen.getDoubleUniform(- M_PI, M_PI);
+		z = gen.getDoubleNormal(0, 1);
+		sum = sum + index + cos(alpha) + sin(alpha) + z;
+	}
+	addResult(mt ? "proposals.mt19937.single" : "proposals.xoshiro.single", 0, randomOps, since(start));
+
+	buffer.setRange(1000000);
+	start = Clock::now();
+	for(i = 0; i < randomOps; i++){
+		buffer.next(index, alpha, cosAlpha, sinAlpha, z);
+		sum = sum + index + cosAlpha + sinAlpha + z;
+	}
+	addResult(mt ? "proposals.mt19937.buffered" : "proposals.xoshiro.buffered", 0, randomOps, since(start));
+
+	sink = sink + sum;
+}
+
+/*
+	The function benchEventQueue() measures the insertion of events into an EventQueue, the
+	removal of a quarter of them and popping the remaining events. The events belong to
+	triangles of the triangulation and have random event times.
+
+	@param 	T 	The triangulation
+	@param 	q 	The number of events in the queue
+*/
+static void benchEventQueue(Triangulation const * const T, const unsigned int q){
+	EventQueue *Q;
+	std::vector<Triangle*> triangles;
+	std::vector<double> times;
+	Clock::time_point start;
+	double insertTime = 0, removeTime = 0, popTime = 0;
+	unsigned long long r;
+	unsigned int i;
+	Vertex *v;
+
+	// Collect distinct triangles, each by its first vertex, as the removal finds the events
+	// by the triangle IDs
+	for(i = 0; i < (unsigned int)(*T).getActualNumberOfVertices() && triangles.size() < q; i++){
+		v = (*T).getVertex(i);
+
+		for(auto &t : (*v).getTriangles()){
+			if((*t).getVertex(0) == v && triangles.size() < q)
+				triangles.push_back(t);
+		}
+	}
+
+	times.resize(q);
+	v = (*T).getVertex(0);
+
+	for(r = 0; r < queueRounds; r++){
+		Q = new EventQueue(v, v, v);
+
+		for(i = 0; i < q; i++)
+			times[i] = (*Settings::generator).getDoubleUniform(0, 1);
+
+		start = Clock::now();
+		for(i = 0; i < q; i++)
+			(*Q).insertWithoutCheck(times[i], triangles[i]);
+		insertTime = insertTime + since(start);
+
+		start = Clock::now();
+		for(i = 0; i < q; i += 4)
+			(*Q).remove(triangles[i]);
+		removeTime = removeTime + since(start);
+
+		start = Clock::now();
+		while((*Q).size() > 0)
+			sink = sink + (*Q).pop().first;
+		popTime = popTime + since(start);
+
+		delete Q;
+	}
+
+	addResult("eventQueue.insert", q, queueRounds * q, insertTime);
+	addResult("eventQueue.remove", q, queueRounds * ((q + 3) / 4), removeTime);
+	addResult("eventQueue.pop", q, queueRounds * (q - (q + 3) / 4), popTime);
+}
+
+/*
+	The function benchIntersection() measures checkIntersection() for pairs of randomly
+	selected polygon edges.
+
+	@param 	T 	The triangulation
+*/
+static void benchIntersection(Triangulation const * const T){
+	std::vector<TEdge*> edges;
+	Clock::time_point start;
+	unsigned long long i;
+	int n = (*T).getActualNumberOfVertices();
+	int count = 0;
+
+	edges.reserve(2 * intersectionOps);
+	for(i = 0; i < 2 * intersectionOps; i++)
+		edges.push_back((*(*T).getVertex((*Settings::generator).getRandomIndex(n))).getToNext());
+
+	start = Clock::now();
+	for(i = 0; i < intersectionOps; i++)
+		count = count + (int)checkIntersection(edges[2 * i], edges[2 * i + 1], false);
+	addResult("checkIntersection", n, intersectionOps, since(start));
+
+	sink = sink + count;
+}
+
+/*
+	The function benchPredicates() measures the orientation test by orient2d() and by
+	Triangle::signedAreaDouble() for triples of randomly selected vertices.
+
+	@param 	T 	The triangulation
+
+	Note:
+		Triangle::signedAreaDouble() gets called by Triangle::signedArea(), as the arithmetic
+		is double
+*/
+static void benchPredicates(Triangulation const * const T){
+	std::vector<Vertex*> vertices;
+	Clock::time_point start;
+	unsigned long long i;
+	int n = (*T).getActualNumberOfVertices();
+	double sum = 0;
+	point a, b, c;
+	Vertex *v0, *v1, *v2;
+
+	vertices.reserve(3 * predicateOps);
+	for(i = 0; i < 3 * predicateOps; i++)
+		vertices.push_back((*T).getVertex((*Settings::generator).getRandomIndex(n)));
+
+	start = Clock::now();
+	for(i = 0; i < predicateOps; i++){
+		v0 = vertices[3 * i];
+		v1 = vertices[3 * i + 1];
+		v2 = vertices[3 * i + 2];
+
+		a.x = (*v0).getX(); a.y = (*v0).getY();
+		b.x = (*v1).getX(); b.y = (*v1).getY();
+		c.x = (*v2).getX(); c.y = (*v2).getY();
+
+		sum = sum + orient2d(a, b, c);
+	}
+	addResult("orient2d", n, predicateOps, since(start));
+
+	start = Clock::now();
+	for(i = 0; i < predicateOps; i++)
+		sum = sum + Triangle::signedArea(vertices[3 * i], vertices[3 * i + 1],
+			vertices[3 * i + 2]);
+	addResult("signedAreaDouble", n, predicateOps, since(start));
+
+	sink = sink + sum;
+}
+
+/*
+	The function benchSimplicity() measures checkSimplicityOfTranslation() for randomly drawn
+	translations without an orientation change. The translations do not get executed.
+
+	@param 	T 	The triangulation
+*/
+static void benchSimplicity(Triangulation * const T){
+	Translation *trans;
+	Clock::time_point start;
+	unsigned long long ops = 0;
+	double time = 0, dx, dy;
+	int index, count = 0;
+
+	while(ops < simplicityOps){
+		drawTranslation(T, index, dx, dy);
+
+		// The retriangulation engine applies the swapped components, see tryTranslation()
+		trans = new TranslationRetriangulation(T, index, dy, dx);
+
+		if(!(*trans).checkOrientation()){
+			start = Clock::now();
+			count = count + (*trans).checkSimplicityOfTranslation();
+			time = time + since(start);
+
+			ops++;
+		}
+
+		(*trans).discard();
+		delete trans;
+	}
+
+	addResult("checkSimplicityOfTranslation", (*T).getActualNumberOfVertices(), ops, time);
+
+	sink = sink + count;
+}
+
+/*
+	The function benchTranslation() measures tryTranslation() of one engine for randomly drawn
+	translations, i.e. including the checks and rejected translations.
+
+	@param 	T 		The triangulation
+	@param 	name 	The name of the benchmark
+	@param 	kinetic True for the kinetic engine, false for the retriangulation
+*/
+static void benchTranslation(Triangulation * const T, const char *name, const bool kinetic){
+	Clock::time_point start;
+	double time = 0, dx, dy;
+	unsigned long long i;
+	int index;
+
+	Settings::kinetic = kinetic;
+
+	for(i = 0; i < translationOps; i++){
+		drawTranslation(T, index, dx, dy);
+
+		start = Clock::now();
+		tryTranslation(T, index, dx, dy);
+		time = time + since(start);
+	}
+
+	Settings::kinetic = false;
+
+	addResult(name, (*T).getActualNumberOfVertices(), translationOps, time);
+}
+
+/*
+	The function benchInsertion() measures Insertion::execute() for randomly selected edges
+	which are stable enough. Afterwards the new vertices get translated as by fpg.
+
+	@param 	T 	The triangulation
+*/
+static void benchInsertion(Triangulation * const T){
+	Insertion *in;
+	Clock::time_point start;
+	unsigned long long ops = 0;
+	unsigned int n = (*T).getActualNumberOfVertices();
+	double time = 0;
+	TEdge *e;
+
+	while(ops < insertionOps){
+		e = (*T).getRandomEdgeWeighted(0);
+		in = new Insertion(T, 0, e);
+
+		if((*in).checkStability()){
+			start = Clock::now();
+			(*in).execute();
+			time = time + since(start);
+
+			(*in).translate();
+			ops++;
+		}
+
+		delete in;
+	}
+
+	addResult("insertion.execute", n, ops, time);
+}
+
+
+/*
+	O ~ U ~ T ~ P ~ U ~ T
+*/
+
+/*
+	The function writeJSON() writes the results of all benchmarks as JSON.
+
+	@param 	f 		The output stream
+	@param 	seed 	The seed of the random generator
+	@param 	label 	The label of the run, NULL if there is none
+*/
+static void writeJSON(FILE *f, const unsigned int seed, const char *label){
+	unsigned int i;
+	struct BenchResult *r;
+
+	fprintf(f, "{\n");
+	fprintf(f, "\t\"benchmark\": \"fpg_bench\",\n");
+	fprintf(f, "\t\"label\": \"%s\",\n", label != NULL ? label : "");
+	fprintf(f, "\t\"seed\": %u,\n", seed);
+	fprintf(f, "\t\"results\": [\n");
+
+	for(i = 0; i < results.size(); i++){
+		r = &results[i];
+
+		fprintf(f, "\t\t{\"name\": \"%s\", \"size\": %u, \"ops\": %llu, \"seconds\": %.9f, \"nsPerOp\": %.3f}%s\n",
+			(*r).name, (*r).size, (*r).ops, (*r).seconds,
+			(*r).ops > 0 ? (*r).seconds / (*r).ops * 1e9 : 0, i + 1 < results.size() ? "," : "");
+	}
+
+	fprintf(f, "\t]\n");
+	fprintf(f, "}\n");
+}
+
+static void usage(const char *progname, const int err){
+	FILE *f = err ? stderr : stdout;
+
+	fprintf(f, "Usage: %s [options]\n", progname);
+	fprintf(f, "  Options: -s <seed>          Seed of the random generator (default 1)\n");
+	fprintf(f, "           -g <engine>        Random generator mt19937 or xoshiro (default mt19937)\n");
+	fprintf(f, "           -n <sizes>         Comma separated numbers of vertices\n");
+	fprintf(f, "                              (default 1000,100000,1000000)\n");
+	fprintf(f, "           -l <label>         Label of the run in the output, e.g. the commit\n");
+	fprintf(f, "           -o <output-file>   JSON output file (default stdout)\n");
+	fprintf(f, "           -h                 Print this help\n");
+
+	exit(err);
+}
+
+int main(int argc, char *argv[]){
+	Triangulation *T;
+	std::vector<unsigned int> sizes;
+	unsigned int seed = 1;
+	const char *label = NULL, *output = NULL;
+	char *token;
+	FILE *f;
+	int c, n;
+
+	while((c = getopt(argc, argv, "s:g:n:l:o:h")) != -1){
+		switch(c){
+			case 's':
+				seed = atoi(optarg);
+				break;
+			case 'g':
+				if(!strcmp(optarg, "mt19937"))
+					Settings::randomEngine = RandomEngine::MT19937;
+				else if(!strcmp(optarg, "xoshiro"))
+					Settings::randomEngine = RandomEngine::XOSHIRO;
+				else{
+					fprintf(stderr, "Invalid random generator %s\n", optarg);
+					exit(1);
+				}
+				break;
+			case 'n':
+				for(token = strtok(optarg, ","); token != NULL; token = strtok(NULL, ",")){
+					n = atoi(token);
+					if(n < 3){
+						fprintf(stderr, "The polygons must have at least 3 vertices, given number %d\n", n);
+						exit(1);
+					}
+					sizes.push_back(n);
+				}
+				break;
+			case 'l':
+				label = optarg;
+				break;
+			case 'o':
+				output = optarg;
+				break;
+			case 'h':
+				usage(argv[0], 0);
+				break;
+			default:
+				usage(argv[0], 1);
+		}
+	}
+
+	if(sizes.empty())
+		sizes = {1000, 100000, 1000000};
+
+	Settings::feedback = FeedbackMode::MUTE;
+	Settings::fixedSeed = true;
+	Settings::seed = seed;
+	Settings::timer = new Timer();
+	(*Settings::timer).start();
+	exactinit();
+
+	for(auto size : sizes){
+		T = generateTriangulation(size, seed);
+
+		// The kernels which do not change the triangulation first, the insertions last as they
+		// add vertices
+		benchSelectionTree(size);
+		benchIntersection(T);
+		benchPredicates(T);
+		benchSimplicity(T);
+		benchTranslation(T, "translation.retriangulation", false);
+		benchTranslation(T, "translation.kinetic", true);
+		benchInsertion(T);
+	}
+
+	T = generateTriangulation(1000, seed);
+	benchEventQueue(T, 16);
+	benchEventQueue(T, 256);
+
+	benchRandom(RandomEngine::MT19937, seed);
+	benchRandom(RandomEngine::XOSHIRO, seed);
+	benchProposals(RandomEngine::MT19937, seed);
+	benchProposals(RandomEngine::XOSHIRO, seed);
+
+	if(output != NULL){
+		f = fopen(output, "w");
+		if(f == NULL){
+			fprintf(stderr, "Could not open the output file %s\n", output);
+			exit(1);
+		}
+
+		writeJSON(f, seed, label);
+		fclose(f);
+	}else
+		writeJSON(stdout, seed, label);
+
+	exit(0);
+}
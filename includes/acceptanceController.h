@@ -0,0 +1,187 @@
+/*
+ * Copyright 2021 Philipp Mayer - pmayer@cs.sbg.ac.at
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+/*
+	Include standard libraries
+*/
+#include <vector>
+#include <math.h>
+
+#ifndef __ACCEPTANCECONTROLLER_H_
+#define __ACCEPTANCECONTROLLER_H_
+
+/*
+	One adjustment of the acceptance controller.
+*/
+struct ControllerStep{
+	// The number of moves recorded by the controller up to this adjustment
+	unsigned long long tries;
+
+	// The acceptance rate of the moves since the previous adjustment
+	double rate;
+
+	// The scale of the translation distances after the adjustment
+	double scale;
+};
+
+/*
+	An online controller for the distances of the translation phases. The distances are
+	multiplied by a scale which gets adjusted after each window of recorded moves, such that
+	the acceptance rate approaches a target rate. The scale is kept in
+	[1 / maxBias, maxBias].
+*/
+class AcceptanceController{
+
+private:
+
+	/*
+		The acceptance rate the controller aims at
+	*/
+	double target;
+
+	/*
+		The maximum factor by which the distances may be scaled up or down
+	*/
+	double maxBias;
+
+	/*
+		The logarithm of the actual scale, the adjustments work on it to keep them
+		symmetric for scaling up and down
+	*/
+	double logScale;
+
+	/*
+		The number of moves tried and performed since the last adjustment
+	*/
+	unsigned long long windowTries;
+	unsigned long long windowPerformed;
+
+	/*
+		The total number of recorded moves
+	*/
+	unsigned long long totalTries;
+
+	/*
+		All adjustments done so far
+	*/
+	std::vector<ControllerStep> trajectory;
+
+
+	/*
+		The function adjust() updates the scale by the acceptance rate of the actual window
+		and starts a new window.
+	*/
+	void adjust();
+
+
+public:
+
+	/*
+		The minimum number of moves between two adjustments
+	*/
+	static const unsigned int windowSize = 1000;
+
+	/*
+		The factor the deviation of the acceptance rate from the target gets multiplied with
+		to get the change of the logarithmic scale
+	*/
+	static constexpr double gain = 2.0;
+
+
+	/*
+		LIST OF PUBLIC MEMBER FUNCTIONS
+
+		CONSTRUCTORS:
+
+										AcceptanceController(const double t, const double b)
+
+		GETTER:
+
+		double 							getScale() const
+		double 							getTarget() const
+		double 							getMaxBias() const
+		std::vector<ControllerStep> 	const &getTrajectory() const
+
+		OTHERS:
+
+		void 							record(const unsigned long long tries,
+											const unsigned long long performed)
+	*/
+
+
+	/*
+		C ~ O ~ N ~ S ~ T ~ R ~ U ~ C ~ T ~ O ~ R ~ S
+	*/
+
+	/*
+		Constructor:
+		Starts with the scale 1, i.e. with the unbiased distance distribution.
+
+		@param 	t 	The target acceptance rate
+		@param 	b 	The maximum bias of the scale
+	*/
+	AcceptanceController(const double t, const double b);
+
+
+	/*
+		G ~ E ~ T ~ T ~ E ~ R ~ S
+	*/
+
+	/*
+		@return 	The factor the translation distances get multiplied with
+	*/
+	double getScale() const;
+
+	/*
+		@return 	The target acceptance rate
+	*/
+	double getTarget() const;
+
+	/*
+		@return 	The maximum bias of the scale
+	*/
+	double getMaxBias() const;
+
+	/*
+		@return 	All adjustments done so far
+	*/
+	std::vector<ControllerStep> const &getTrajectory() const;
+
+
+	/*
+		O ~ T ~ H ~ E ~ R ~ S
+	*/
+
+	/*
+		The function record() adds the results of moves to the actual window and adjusts the
+		scale if the window is full.
+
+		@param 	tries 		The number of tried moves
+		@param 	performed 	The number of moves which have been executed at least partially
+
+		Note:
+			- The sequential translation phase records each move, so the scale changes at
+				most every windowSize moves
+			- The parallel translation phases record whole phases, as the distances of a
+				phase must not depend on the execution order of its proposals
+			- Moves of a window which is not full yet are kept for the next phase
+	*/
+	void record(const unsigned long long tries, const unsigned long long performed);
+};
+
+#endif
@@ -0,0 +1,200 @@
+/*
+ * Copyright 2021 Philipp Mayer - pmayer@cs.sbg.ac.at
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+/*
+	Include standard libraries
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <cstddef>
+#include <new>
+#include <vector>
+#include <atomic>
+
+#ifndef __ARENA_H_
+#define __ARENA_H_
+
+/*
+	The free slots of the active arena known by one thread.
+*/
+struct ArenaSlots{
+	// The generation of the active arena the slots belong to
+	unsigned int generation;
+
+	// The free slots, indexed by their size divided by the alignment
+	std::vector<void*> free[32];
+};
+
+/*
+	A block of memory the entities of the triangulation get placed in consecutively by the
+	relayout of the triangulation. Entities placed in the active arena do not get freed
+	individually when they are deleted, their slots get reused for new entities of the same
+	size instead. The whole block gets freed when the next relayout has moved all living
+	entities out of it.
+*/
+class Arena{
+
+private:
+
+	/*
+		The memory block and its size in bytes
+	*/
+	char *block;
+	size_t size;
+
+	/*
+		The number of bytes already handed out
+	*/
+	size_t used;
+
+	/*
+		The range of the active arena, entities in this range must not be freed
+	*/
+	static char *activeBegin;
+	static char *activeEnd;
+
+	/*
+		A counter which gets increased whenever another arena gets activated
+	*/
+	static std::atomic<unsigned int> generation;
+
+	/*
+		The free slots of the active arena known by the calling thread
+	*/
+	static thread_local ArenaSlots slots;
+
+
+	/*
+		P ~ R ~ I ~ V ~ A ~ T ~ E 	M ~ E ~ M ~ B ~ E ~ R 	F ~ U ~ N ~ C ~ T ~ I ~ O ~ N ~ S
+	*/
+
+	/*
+		The function getSlots() returns the free slots of the calling thread of the given size.
+		Slots of previously active arenas get dropped.
+
+		@param 	n 	The size of the slots in bytes
+		@return 	The free slots, NULL if there are no slots of that size
+	*/
+	static std::vector<void*> *getSlots(const size_t n);
+
+
+public:
+
+	/*
+		LIST OF PUBLIC MEMBER FUNCTIONS
+
+		CONSTRUCTORS:
+
+							Arena(const size_t n)
+
+		OTHERS:
+
+		void* 				allocate(const size_t n)
+		void 				activate()
+		static bool 		contains(void const * const p)
+		static void* 		acquire(const size_t n)
+		static void 		release(void * const p, const size_t n)
+		static size_t 		getAlignedSize(const size_t n)
+	*/
+
+
+	/*
+		C ~ O ~ N ~ S ~ T ~ R ~ U ~ C ~ T ~ O ~ R ~ S
+	*/
+
+	/*
+		Constructor:
+		Allocates a block of n bytes. Errors with exit code 19 if the block can not be
+		allocated.
+
+		@param 	n 	The size of the block in bytes
+	*/
+	Arena(const size_t n);
+
+
+	/*
+		O ~ T ~ H ~ E ~ R ~ S
+	*/
+
+	/*
+		The function allocate() hands out the next n bytes of the block. Errors with exit
+		code 19 if the block is exhausted.
+
+		@param 	n 	The number of bytes
+		@return 	A pointer to the memory, aligned for any entity
+	*/
+	void *allocate(const size_t n);
+
+	/*
+		The function activate() makes the arena the active one, i.e. deleted entities placed
+		in it do not get freed anymore.
+
+		Note:
+			- There is just one active arena, the previously active arena must not contain
+				any living entity anymore
+			- Must not be called while other threads acquire or release memory
+	*/
+	void activate();
+
+	/*
+		The function contains() checks whether a pointer points into the active arena.
+
+		@param 	p 	The pointer of interest
+		@return 	True if p points into the active arena, otherwise false
+	*/
+	static bool contains(void const * const p);
+
+	/*
+		The function acquire() returns memory for a new entity. It reuses a slot of the active
+		arena the calling thread has released before if there is one of the right size. It is
+		used by the operator new of the entities.
+
+		@param 	n 	The size of the entity in bytes
+		@return 	The memory for the entity
+	*/
+	static void *acquire(const size_t n);
+
+	/*
+		The function release() frees the memory of a deleted entity if it has not been
+		placed in the active arena, otherwise the slot gets reused by acquire(). It is used
+		by the operator delete of the entities.
+
+		@param 	p 	The memory of the deleted entity
+		@param 	n 	The size of the entity in bytes
+	*/
+	static void release(void * const p, const size_t n);
+
+	/*
+		@param 	n 	A number of bytes
+		@return 	The number of bytes allocate() really uses for n bytes
+	*/
+	static size_t getAlignedSize(const size_t n);
+
+
+	/*
+		D ~ E ~ S ~ T ~ R ~ U ~ C ~ T ~ O ~ R
+	*/
+
+	/*
+		Destructor:
+		Frees the block and deactivates the arena if it is the active one.
+	*/
+	~Arena();
+};
+
+#endif
@@ -20,14 +20,20 @@
 #include <getopt.h>
 #include <boost/algorithm/string.hpp>
 
-static const char* short_options = "hn:i:s:aH:o:T:lgvmtwp:kI";
+static const char* short_options = "hn:i:s:aH:o:T:lgvmtwp:kYIj:P:bdBA:M:LS:F:R:C:E:G:QU:Z:f:";
 static struct option long_options[] = {
 		{ "help"                , no_argument      , 0, 'h'},
 		{ "nrofholes"           , required_argument, 0, 'n'},
 		{ "startsize"           , required_argument, 0, 'i'},
+		{ "input"               , required_argument, 0, 'U'},
+		{ "startshape"          , required_argument, 0, 'Z'},
+		{ "initialfactor"       , required_argument, 0, 'f'},
 		{ "seed"                , required_argument, 0, 's'},
+		{ "rng"                 , required_argument, 0, 'G'},
+		{ "batchedproposals"    , no_argument,       0, 'Q'},
 		{ "arithmetic"          , no_argument,       0, 'a'},
 		{ "kinetic"             , no_argument,       0, 'k'},
+		{ "hybrid"              , no_argument,       0, 'Y'},
 		{ "holesizes"           , required_argument, 0, 'H'},
 		{ "initialholes"        , no_argument,       0, 'I'},
 		{ "outputformat"        , required_argument, 0, 'o'},
@@ -39,6 +45,19 @@ static struct option long_options[] = {
 		{ "enablestats"              , no_argument,  0, 't'},
 		{ "disableweightedselection" , no_argument,  0, 'w'},
 		{ "printtriang"				 , required_argument, 0, 'p'},
+		{ "threads"                  , required_argument, 0, 'j'},
+		{ "parallelmode"             , required_argument, 0, 'P'},
+		{ "bulkgrowth"               , no_argument,  0, 'b'},
+		{ "directinsertion"          , no_argument,  0, 'd'},
+		{ "boundeddistance"          , no_argument,  0, 'B'},
+		{ "targetacceptance"         , required_argument, 0, 'A'},
+		{ "maxbias"                  , required_argument, 0, 'M'},
+		{ "relayout"                 , no_argument,  0, 'L'},
+		{ "localblocks"              , required_argument, 0, 'S'},
+		{ "profile"                  , required_argument, 0, 'F'},
+		{ "trace"                    , required_argument, 0, 'R'},
+		{ "record"                   , required_argument, 0, 'C'},
+		{ "replay"                   , required_argument, 0, 'E'},
 		{ 0, 0, 0, 0}
 };
 
@@ -50,12 +69,27 @@ static struct option long_options[] = {
 	fprintf(f,"Usage: %s [options] <nr. of vertices> <output-file>\n", progname);
 	fprintf(f,"  options: --nrofholes <num>          state number of holes (default: 0).\n");
 	fprintf(f,"           --startsize <num>          polygon start-size, initial-size (default 10).\n");
+	fprintf(f,"           --input <string>           start from the polygon of a line, dat or bin file (default none).\n");
+	fprintf(f,"           --startshape <shape>       regular or star (default regular).\n");
+	fprintf(f,"           --initialfactor <num>      translations per vertex of the start polygon (default 100, 0 for --input).\n");
 	fprintf(f,"           --seed <num>               seed for rnd (default random).\n");
+	fprintf(f,"           --rng <engine>             mt19937 or xoshiro (default mt19937).\n");
+	fprintf(f,"           --batchedproposals         draw the random values of the proposed translations in blocks (default off).\n");
 	fprintf(f,"           --arithmetic               enable 'exact' arithmetic? (default off).\n");
 	fprintf(f,"           --kinetic                  enable execution using kinetic triangulation.\n");
+	fprintf(f,"           --hybrid                   choose kinetic or retriangulation per translation by its predicted costs.\n");
+	fprintf(f,"           --threads <num>            number of threads for translations (default 1).\n");
+	fprintf(f,"           --parallelmode <mode>      partition, independentset or speculative (default partition).\n");
+	fprintf(f,"           --bulkgrowth               grow the polygon in rounds of independent insertions (default off).\n");
+	fprintf(f,"           --directinsertion          place inserted vertices directly inside the triangles of the edge (default off).\n");
+	fprintf(f,"           --boundeddistance          truncate translation distances to the free distance of the vertex (default off).\n");
+	fprintf(f,"           --targetacceptance <rate>  adjust translation distances toward an acceptance rate (default off).\n");
+	fprintf(f,"           --maxbias <factor>         max factor the adjustment scales distances by (default 4).\n");
+	fprintf(f,"           --relayout                 reorder the triangulation in memory whenever the polygon doubled (default off).\n");
+	fprintf(f,"           --localblocks <num>        select the vertices to translate in spatial blocks of num vertices (default off).\n");
 	fprintf(f,"           --holesizes <a,b,c,...>    define hole sizes.\n");
 	fprintf(f,"           --initialholes             insert the holes into the start polygon instead of an insertion during growth.\n");
-	fprintf(f,"           --outputformat <format>    dat, line, or graphml (default graphml).\n");
+	fprintf(f,"           --outputformat <format>    dat, line, bin, or graphml (default graphml).\n");
 	fprintf(f,"           --disablelocalchecks       (default on).\n");
 	fprintf(f,"           --enableglobalchecks       (default off).\n");
 	fprintf(f,"           --verbose                  (default off).\n");
@@ -63,6 +97,10 @@ static struct option long_options[] = {
 	fprintf(f,"           --enablestats              (default off).\n");
 	fprintf(f,"           --statsfile <string>       xml-file for statistics (default none)\n");
 	fprintf(f,"           --printtriang <string>     print the triangulation into a graphml file\n");
+	fprintf(f,"           --profile <string>         json-file for the timings of the hot paths (default none)\n");
+	fprintf(f,"           --trace <string>           json-file for a trace of the generation stages (default none)\n");
+	fprintf(f,"           --record <string>          binary file logging all translations and insertions (default none)\n");
+	fprintf(f,"           --replay <string>          take the translations and insertions from a recorded log (default none)\n");
 	fprintf(f,"           --disableweightedselection \n");
 	fprintf(f,"\n");
 	fprintf(f,"  holesizes example:  --holesizes 3,6,7\n");
@@ -115,6 +153,30 @@ private:
 				}
 				break;
 			}
+			case 'U': {
+				inputFile = optarg;
+				break;
+			}
+			case 'Z': {
+				if (!strcmp(optarg, "regular")) {
+					startShape = StartShape::REGULAR;
+				} else if (!strcmp(optarg, "star")) {
+					startShape = StartShape::STAR;
+				} else {
+					std::cerr << "Invalid start shape " << optarg << "." << std::endl;
+					exit(1);
+				}
+				break;
+			}
+			case 'f': {
+				fixedInitialFactor = true;
+				initialTranslationFactor = (unsigned int)strtoul(optarg,&end_ptr,10);
+				if (*end_ptr != '\0') {
+					std::cerr << "Invalid initial translation factor " << optarg << "." << std::endl;
+					exit(1);
+				}
+				break;
+			}
 			case 's': {
 				fixedSeed = true;
 				seed = (unsigned int)strtoul(optarg,&end_ptr,10);
@@ -124,6 +186,21 @@ private:
 				}
 				break;
 			}
+			case 'G': {
+				if (!strcmp(optarg, "mt19937")) {
+					randomEngine = RandomEngine::MT19937;
+				} else if (!strcmp(optarg, "xoshiro")) {
+					randomEngine = RandomEngine::XOSHIRO;
+				} else {
+					std::cerr << "Invalid random generator " << optarg << "." << std::endl;
+					exit(1);
+				}
+				break;
+			}
+			case 'Q': {
+				batchedProposals = true;
+				break;
+			}
 			case 'a': {
 				arithmetics = Arithmetics::EXACT;
 				break;
@@ -132,6 +209,31 @@ private:
 				kinetic = true;
 				break;
 			}
+			case 'Y': {
+				hybrid = true;
+				break;
+			}
+			case 'j': {
+				threads = (unsigned int)strtoul(optarg,&end_ptr,10);
+				if (*end_ptr != '\0' || threads == 0) {
+					std::cerr << "Invalid number of threads " << optarg << "." << std::endl;
+					exit(1);
+				}
+				break;
+			}
+			case 'P': {
+				if (!strcmp(optarg, "partition")) {
+					parallelMode = ParallelMode::PARTITION;
+				} else if (!strcmp(optarg, "independentset")) {
+					parallelMode = ParallelMode::INDEPENDENTSET;
+				} else if (!strcmp(optarg, "speculative")) {
+					parallelMode = ParallelMode::SPECULATIVE;
+				} else {
+					std::cerr << "Invalid parallel mode " << optarg << "." << std::endl;
+					exit(1);
+				}
+				break;
+			}
 			case 'H': {
 				std::vector<std::string> nr;
 				boost::split(nr, optarg, boost::is_any_of(","));
@@ -150,6 +252,8 @@ private:
 					Settings::outputFormat = OutputFormat::DAT;
 				} else if (!strcmp(optarg, "line")) {
 					Settings::outputFormat = OutputFormat::LINE;
+				} else if (!strcmp(optarg, "bin")) {
+					Settings::outputFormat = OutputFormat::BIN;
 				} else {
 					Settings::outputFormat = OutputFormat::GRAPHML;
 				}
@@ -165,6 +269,22 @@ private:
 				triangulationOutputRequired = true;
 				break;
 			}
+			case 'F': {
+				profileFile = optarg;
+				break;
+			}
+			case 'R': {
+				traceFile = optarg;
+				break;
+			}
+			case 'C': {
+				recordFile = optarg;
+				break;
+			}
+			case 'E': {
+				replayFile = optarg;
+				break;
+			}
 			case 'l': {
 				localChecking = false;
 				break;
@@ -188,6 +308,46 @@ private:
 				weightedEdgeSelection = false;
 				break;
 			}
+			case 'b': {
+				bulkGrowth = true;
+				break;
+			}
+			case 'd': {
+				directInsertion = true;
+				break;
+			}
+			case 'B': {
+				boundedDistance = true;
+				break;
+			}
+			case 'A': {
+				targetAcceptance = strtod(optarg,&end_ptr);
+				if (*end_ptr != '\0' || targetAcceptance < 0 || targetAcceptance >= 1) {
+					std::cerr << "Invalid target acceptance rate " << optarg << "." << std::endl;
+					exit(1);
+				}
+				break;
+			}
+			case 'M': {
+				maxBias = strtod(optarg,&end_ptr);
+				if (*end_ptr != '\0' || maxBias < 1) {
+					std::cerr << "Invalid maximum bias " << optarg << "." << std::endl;
+					exit(1);
+				}
+				break;
+			}
+			case 'L': {
+				relayout = true;
+				break;
+			}
+			case 'S': {
+				localBlockSize = (unsigned int)strtoul(optarg,&end_ptr,10);
+				if (*end_ptr != '\0') {
+					std::cerr << "Invalid local block size " << optarg << "." << std::endl;
+					exit(1);
+				}
+				break;
+			}
 			default:{
 				std::cerr << "Invalid option " << (char)r << std::endl;
 				exit(14);
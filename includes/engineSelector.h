@@ -0,0 +1,213 @@
+/*
+ * Copyright 2021 Philipp Mayer - pmayer@cs.sbg.ac.at
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+/*
+	Include standard libraries
+*/
+#include <vector>
+
+/*
+	Include my headers
+*/
+#include "statistics.h"
+
+#ifndef __ENGINESELECTOR_H_
+#define __ENGINESELECTOR_H_
+
+/*
+	The cost of one translation executed while the records of the EngineSelector were
+	deferred.
+*/
+struct EngineRecord{
+	// The engine which has executed the translation
+	Engine engine;
+
+	// The bucket of the translation
+	unsigned int bucket;
+
+	// The cost of the execution (in microseconds)
+	double cost;
+};
+
+/*
+	An online cost model for the hybrid translation engine. It predicts the execution cost
+	of a translation by each engine from the number of triangles the simplicity check of the
+	translation has passed. The translations are grouped into buckets by the logarithm of
+	this number and for each bucket and engine the model keeps a moving average of the
+	costs of the executed translations. A translation gets executed by the engine with the
+	lower average, except of the first translations of a bucket and every
+	explorationPeriod-th translation of a bucket, which get executed by the other engine to
+	keep its average up to date, as the costs change with the density of the polygon.
+
+	Note:
+		- The model is shared by all threads. During the concurrent part of a parallel round
+			the workers choose by the model of the round start and their records get
+			deferred, afterwards they are added in the same order as the SelectionTree
+			updates, i.e. independent of the thread which has executed the translations
+		- The costs are computed from the counted work of the translations, i.e. the flips
+			of a kinetic translation and the vertices of the polygons retriangulated by a
+			translation by retriangulation, instead of measured times. Therefore the choices
+			and the generated polygons of the hybrid engine are reproducible by the seed.
+*/
+class EngineSelector{
+
+private:
+
+	/*
+		The number of buckets, the last bucket also takes all larger numbers of triangles
+	*/
+	static const unsigned int nrBuckets = 16;
+
+	/*
+		The number of executions per engine and bucket
+	*/
+	static unsigned long long samples[nrEngines][nrBuckets];
+
+	/*
+		The moving average of the execution costs per engine and bucket (in microseconds)
+	*/
+	static double costs[nrEngines][nrBuckets];
+
+	/*
+		Indicates whether the records get deferred
+	*/
+	static bool recordsDeferred;
+
+	/*
+		The records of the calling thread while they are deferred and their number per
+		engine and bucket
+	*/
+	static thread_local std::vector<EngineRecord> deferredRecords;
+	static thread_local unsigned long long deferredSamples[nrEngines][nrBuckets];
+
+
+	/*
+		P ~ R ~ I ~ V ~ A ~ T ~ E 	M ~ E ~ M ~ B ~ E ~ R 	F ~ U ~ N ~ C ~ T ~ I ~ O ~ N ~ S
+	*/
+
+	/*
+		@param 	triangles 	The number of triangles passed by the simplicity check
+		@return 			The bucket of the translation
+	*/
+	static unsigned int getBucket(const unsigned int triangles);
+
+	/*
+		The function addCost() adds the cost of an execution to the moving average of its
+		engine and bucket.
+
+		@param 	e 		The index of the engine
+		@param 	b 		The bucket of the translation
+		@param 	cost 	The cost of the execution (in microseconds)
+	*/
+	static void addCost(const unsigned int e, const unsigned int b, const double cost);
+
+
+public:
+
+	/*
+		The number of executions each engine gets in a bucket before the averages are used
+	*/
+	static const unsigned int warmUp = 8;
+
+	/*
+		The number of recent executions the moving averages approximately cover
+	*/
+	static const unsigned int window = 64;
+
+	/*
+		Every explorationPeriod-th choice of a bucket takes the engine with the higher average
+	*/
+	static const unsigned int explorationPeriod = 32;
+
+	/*
+		The costs of the work of the translations (in microseconds), i.e. the fixed cost of a
+		kinetic translation, the cost of one of its flips and the cost of each vertex of a
+		polygon retriangulated by a translation by retriangulation. They have been fitted
+		once to the execution times of both engines, only their ratios matter.
+	*/
+	static constexpr double kineticCost = 3.3;
+	static constexpr double flipCost = 4.4;
+	static constexpr double vertexCost = 2.7;
+
+
+	/*
+		LIST OF PUBLIC MEMBER FUNCTIONS
+
+		OTHERS:
+
+		static Engine 	choose(const unsigned int triangles)
+		static void 	record(const Engine e, const unsigned int triangles,
+							const unsigned long long flips, const unsigned long long vertices)
+		static void 	deferRecords(const bool defer)
+		static void 	takeDeferredRecords(std::vector<EngineRecord> &records)
+		static void 	applyRecords(std::vector<EngineRecord> const &records)
+	*/
+
+
+	/*
+		O ~ T ~ H ~ E ~ R ~ S
+	*/
+
+	/*
+		The function choose() chooses the engine for a translation.
+
+		@param 	triangles 	The number of triangles passed by the simplicity check of the
+							translation
+		@return 			The engine which should execute the translation
+	*/
+	static Engine choose(const unsigned int triangles);
+
+	/*
+		The function record() adds the execution cost of a translation to the model, while
+		the records are deferred it gets recorded for the calling thread instead.
+
+		@param 	e 			The engine which has executed the translation
+		@param 	triangles 	The number of triangles passed by the simplicity check of the
+							translation
+		@param 	flips 		The number of flips performed by the execution
+		@param 	vertices 	The number of vertices of the polygons retriangulated by the
+							execution
+	*/
+	static void record(const Engine e, const unsigned int triangles,
+		const unsigned long long flips, const unsigned long long vertices);
+
+	/*
+		The function deferRecords() starts respectively stops deferring the records. It must
+		only be called while no worker thread is running.
+
+		@param 	defer 	True if the records get deferred from now on, false otherwise
+	*/
+	static void deferRecords(const bool defer);
+
+	/*
+		The function takeDeferredRecords() hands the records the calling thread has recorded
+		while the records were deferred over to the caller.
+
+		@param 	records 	The vector the records get appended to
+	*/
+	static void takeDeferredRecords(std::vector<EngineRecord> &records);
+
+	/*
+		The function applyRecords() adds the given records to the model in the given order.
+
+		@param 	records 	The records to add
+	*/
+	static void applyRecords(std::vector<EngineRecord> const &records);
+};
+
+#endif
@@ -22,6 +22,8 @@
 #include <stdlib.h>
 #include <math.h>
 #include <stdio.h>
+#include <vector>
+#include <unordered_map>
 
 /*
 	Include my headers
@@ -31,6 +33,7 @@
 #include "tedge.h"
 #include "triangle.h"
 #include "settings.h"
+#include "sweepTriangulation.h"
 
 /*
 	The function generateRegularPolygon at first generates a new triangulation
@@ -49,6 +52,41 @@
 Triangulation *generateRegularPolygon();
 
 
+/*
+	The function generateFromInput() generates a new triangulation with the polygon and
+	the holes read from the input file (Settings::inputRings).
+
+	@return		The generated triangulation
+*/
+Triangulation *generateFromInput();
+
+
+/*
+	The function generateStarPolygon() generates a new triangulation with a random
+	star-shaped start polygon of Settings::initialSize vertices. The vertices get one
+	random angle in each of n equally sized sectors around the origin and a random distance
+	to the origin between a sixth and a third of the edge length of the box, such that the
+	polygon is simple by construction and already spans most of the box.
+
+	@return		The generated triangulation
+*/
+Triangulation *generateStarPolygon();
+
+
+/*
+	The function generateFromRings() generates a new triangulation with the polygon and the
+	holes given by their rings. It boxes the polygon by a square which gets enlarged if the
+	polygon does not fit into the default box and triangulates the inside of the polygon,
+	the holes and the area between the polygon and the square by a sweep in O(n log n)
+	time. It errors with exit code 21 if the rings do not form a valid polygon.
+
+	@param 	input 	The rings, the first one is the outer polygon in counterclockwise
+					order, the others are the holes in clockwise order
+	@return			The generated triangulation
+*/
+Triangulation *generateFromRings(std::vector<std::vector<point>> const &input);
+
+
 /*
 	The function initialTriangulationPseudoStar adds the polygon edges to the
 	vertices of a regular shaped polygon with no holes. Then it moves the
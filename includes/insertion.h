@@ -16,6 +16,11 @@
  */
 #pragma once
 
+/*
+	Include standard libraries
+*/
+#include <chrono>
+
 /*
 	Include my headers	
 */
@@ -66,6 +71,55 @@ private:
 		The inserted vertex
 	*/
 	Vertex *newV;
+
+	/*
+		The index of the inserted vertex in the triangulation
+	*/
+	int newIndex;
+
+	/*
+		The time the insertion has been generated at
+	*/
+	std::chrono::steady_clock::time_point created;
+
+
+	/*
+		P ~ R ~ I ~ V ~ A ~ T ~ E 	M ~ E ~ M ~ B ~ E ~ R 	F ~ U ~ N ~ C ~ T ~ I ~ O ~ N ~ S
+	*/
+
+	/*
+		The function getRangeAtMiddle() computes the estimate getDirectedEdgeLength() would
+		return for a vertex inserted at the middle of the edge, without inserting it. The
+		middle vertex would be incident to the four triangles formed by it, one of the
+		vertices of the edge and one of the vertices opposite to the edge.
+
+		@param 	x 		The x-coordinate of the middle of the edge
+		@param 	y 		The y-coordinate of the middle of the edge
+		@param 	alpha 	The direction of the planned translation
+		@param 	other0 	The vertex of the first triangle opposite to the edge
+		@param 	other1 	The vertex of the second triangle opposite to the edge
+		@return 		Mean length of the two edges of the middle vertex bounding the triangle
+						in direction alpha
+	*/
+	double getRangeAtMiddle(const double x, const double y, const double alpha,
+		Vertex const * const other0, Vertex const * const other1) const;
+
+	/*
+		The function isSuitableFan() checks whether the triangles formed by the new vertex and
+		each two consecutive corners of a chain have all the same orientation, i.e. whether
+		connecting the new vertex to the corners gives a valid triangulation of the area the
+		chain bounds together with the new vertex. In case we use the double arithmetics, the
+		determinants of the triangles must be at least Settings::minDetInsertion.
+
+		@param 	corners 	The corners of the chain
+		@param 	n 			The number of corners
+		@return 			True if the triangles are suitable, otherwise false
+
+		Note:
+			A closed chain, i.e. one with the same first and last corner, checks whether the
+			new vertex lies in the interior of the triangle formed by the chain
+	*/
+	bool isSuitableFan(Vertex * const * const corners, const int n) const;
 	
 
 public:
@@ -78,11 +132,18 @@ public:
 				Insertion(Triangulation * const t, const unsigned int pid, const int index)
 				Insertion(Triangulation * const t, const unsigned int pid, TEdge *edge)
 
+		GETTER:
+
+		Vertex* getNewVertex() const
+
 		OTHERS:
 
 		bool 	checkStability() const
 		void 	execute()
+		void 	executeDirect()
 		void 	translate() const
+		bool 	translate(RandomGenerator * const gen, const int region, unsigned int &count) const
+		void 	translateSpeculative() const
 	*/
 
 
@@ -113,6 +174,15 @@ public:
 	Insertion(Triangulation * const t, const unsigned int pid, TEdge *edge);
 
 
+	/*
+		G ~ E ~ T ~ T ~ E ~ R ~ S
+	*/
+
+	/*
+		@return 	The inserted vertex, NULL before the execution
+	*/
+	Vertex *getNewVertex() const;
+
 
 	/*
 		O ~ T ~ H ~ E ~ R ~ S
@@ -125,6 +195,11 @@ public:
 		adjacent triangles' determinants must be at least Settings::minDetInsertion.
 
 		@return 	True if the chosen edge fulfills the criteria, otherwise false
+
+		Note:
+			- Edges which do not fulfill the criteria have weight 0 in the SelectionTree of the
+				polygon, so the SelectionTree never returns them
+			- A failed check gets counted as rejection in the statistics
 	*/
 	bool checkStability() const;
 
@@ -136,13 +211,75 @@ public:
 	*/
 	void execute();
 
+	/*
+		The function executeDirect() inserts a vertex at a random position inside one of the
+		two triangles incident to the chosen edge, so it does not have to be translated
+		afterwards. The position is drawn as the middle of the edge plus a translation
+		generated in the same way translate() generates it. The new vertex gets connected to
+		the vertices of the triangle containing it and, if it is visible, to the vertex of the
+		other triangle opposite to the edge. Otherwise the chosen edge stays as triangulation
+		edge. If the position is not inside one of the triangles, the vertex gets inserted at
+		the middle of the edge and the drawn translation gets tried by tryTranslation(),
+		followed by translate() if it gets rejected.
+
+		Note:
+			- A translation staying inside the two triangles is always accepted by translate(),
+				so the positions and the consumed random numbers are the same as for the two
+				step insertion
+			- The resulting triangulation may differ from the one of the two step insertion
+	*/
+	void executeDirect();
+
 	/*
 		The function translate() tries to move the new vertex away from the edge.
 		Therefore it tries up to Settings::insertionTries times to find a translation
 		which leads to a simple polygon and execute it. If it has not found a suitable
 		translation till the limit is reached, the new vertex will just stay were it is.
+
+		Note:
+			In the speculative parallel mode it calls translateSpeculative() instead
 	*/
 	void translate() const;
+
+	/*
+		The function translate() tries translations of the new vertex drawn from gen until
+		one gets executed or the number of tries reaches Settings::insertionTries. If a
+		region is given, it stops as soon as a translation would leave the region.
+
+		@param 	gen 	The random generator the translations get drawn from
+		@param 	region 	The region the translations must stay in, -1 for no restriction
+		@param 	count 	The number of tries so far, gets increased by each try
+		@return 		False if it stopped because a translation would leave the region,
+						otherwise true
+
+		Note:
+			- A translation which would leave the region does not count as try, so the tries
+				can be continued without restriction later on
+			- If a log gets replayed, the translations are taken from the MoveLog instead of gen
+			- If batched proposals are enabled and gen is the global RandomGenerator, the
+				directions and distances are taken from the ProposalBuffer, the generators split
+				off for the bulk growth are still drawn from directly
+	*/
+	bool translate(RandomGenerator * const gen, const int region, unsigned int &count) const;
+
+	/*
+		The function translateSpeculative() does the same as translate(), but tries just the
+		first candidate translation directly. If it gets rejected, it checks batches of four
+		candidate translations concurrently and executes the first one which passes the
+		checks. The candidates get generated in the same order as by translate(), so the
+		same translation gets selected.
+
+		Note:
+			- Most insertions pass the first candidate, so they neither wait for the worker
+				pool nor generate more candidates than translate()
+			- The remaining candidates of a batch get dropped after an execution, as it
+				changes the surrounding of the new vertex
+			- As a batch generates more candidates than it tries, the following random
+				numbers differ from translate(). The batch size does not depend on the number
+				of threads, so for a fixed seed neither does the result.
+			- This function works just for polygons without holes!
+	*/
+	void translateSpeculative() const;
 };
 
 #endif
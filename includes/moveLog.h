@@ -0,0 +1,295 @@
+/*
+ * Copyright 2021 Philipp Mayer - pmayer@cs.sbg.ac.at
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+/*
+	Include standard libraries
+*/
+#include <stdio.h>
+
+/*
+	Include my headers
+*/
+#include "statistics.h"
+#include "translation.h"
+
+#ifndef __MOVELOG_H_
+#define __MOVELOG_H_
+
+class Triangulation;
+class TEdge;
+class Vertex;
+
+/*
+	The kinds of records in the log:
+		- MOVE: A translation of a translation phase
+		- INSERTIONMOVE: A translation of a vertex which has just been inserted
+		- INSERTION: The choice of an edge to insert a vertex in
+*/
+enum class LogRecord : unsigned char {MOVE, INSERTIONMOVE, INSERTION};
+
+/*
+	A binary log of all proposals of the generation, i.e. the translations with the vertex,
+	the translation vector, the engine and the outcome and the insertions with the edge and
+	whether it has been stable enough. A recorded log can be replayed instead of drawing the
+	proposals from the random generator, such that different translation engines or
+	versions of the program can be compared on identical proposals.
+
+	The log starts with the 8 bytes "FPGMOVE1" followed by the records, each starting with
+	its kind as one byte:
+		- MOVE, INSERTIONMOVE: index (int32), dx (double), dy (double), scale (double),
+			engine (uint8), outcome (uint8)
+		- INSERTION: pID (uint32), index (int32), stable (uint8)
+	All numbers are stored in the byte order of the machine.
+
+	Note:
+		- The translation vectors are stored as the vectors really applied, see
+			getEffectiveTranslation(), so a log can be replayed by any engine
+		- The scale of a translation is the estimate getDirectedEdgeLength() gives for the
+			moving vertex in the direction of the generated translation vector, as used for
+			drawing the translations. If the replayed polygon has diverged from the recorded
+			one, e.g. by another engine, the scale of the vertex differs and the translation
+			vector gets scaled accordingly, such that the replayed translations fit to the
+			surrounding of the vertex like drawn ones
+		- The edges are stored by the index of their first vertex in polygon order, which
+			does not depend on the engine, as the indices do not change by translations
+		- If a replay accepts a translation of an inserted vertex earlier than the recorded
+			run, the remaining recorded tries of the vertex get skipped; if it needs more
+			tries, it keeps the vertex where it is
+		- A replay follows the recorded insertions, i.e. recorded choices of unstable edges
+			get skipped and each other recorded choice counts as insertion, even if it is
+			not possible in the actual run. So the replayed phases stay aligned to the log
+			when the replayed polygon diverges from the recorded one
+		- Recording and replaying just work for sequential runs without holes, bulk
+			growth and direct insertion
+*/
+class MoveLog{
+
+private:
+
+	/*
+		The file the log gets written to or read from
+	*/
+	static FILE *file;
+
+	/*
+		True while the translations belong to a vertex which has just been inserted
+	*/
+	static bool inInsertion;
+
+	/*
+		The next record of the replayed log, valid if buffered is true, for insertions
+		nextOutcome holds whether the edge has been stable
+	*/
+	static bool buffered;
+	static LogRecord kind;
+	static unsigned int nextPID;
+	static int nextIndex;
+	static double nextDx, nextDy, nextScale;
+	static unsigned char nextOutcome;
+
+	/*
+		The outcome of the last replayed translation
+	*/
+	static unsigned char lastOutcome;
+
+	/*
+		The number of replayed translations and the number of them executed differently
+		than recorded
+	*/
+	static unsigned long long replayed;
+	static unsigned long long diverged;
+
+	/*
+		The number of replayed proposals which are not possible in the actual run
+	*/
+	static unsigned long long skipped;
+
+
+	/*
+		P ~ R ~ I ~ V ~ A ~ T ~ E 	M ~ E ~ M ~ B ~ E ~ R 	F ~ U ~ N ~ C ~ T ~ I ~ O ~ N ~ S
+	*/
+
+	/*
+		The function peek() reads the next record of the replayed log if it is not already
+		buffered.
+
+		@return 	True if there is a next record, false at the end of the log
+	*/
+	static bool peek();
+
+	/*
+		The function mismatch() errors with exit code 20 as the replayed log does not fit to
+		the actual run.
+
+		@param 	expected 	The name of the expected record
+	*/
+	[[noreturn]] static void mismatch(const char *expected);
+
+	/*
+		The function takeTranslation() returns the translation vector of the buffered record
+		for the actual run, i.e. scaled by the ratio of the actual and the recorded scale.
+
+		@param 	v 	The moving vertex
+		@param 	dx 	The generated x-component of the translation vector
+		@param 	dy 	The generated y-component of the translation vector
+	*/
+	static void takeTranslation(Vertex const * const v, double &dx, double &dy);
+
+
+public:
+
+	/*
+		The flags whether a log gets recorded or replayed
+	*/
+	static bool recording;
+	static bool replaying;
+
+
+	/*
+		LIST OF PUBLIC MEMBER FUNCTIONS
+
+		OTHERS:
+
+		static double 	getScale(Vertex const * const v, const double dx, const double dy)
+		static void 	openRecord(const char *filename)
+		static void 	openReplay(const char *filename)
+		static void 	addTranslation(const int index, const double dx, const double dy,
+							const double scale, const Engine e, const Executed ex)
+		static void 	addInsertion(const unsigned int pID, const int index, const bool stable)
+		static void 	endInsertion()
+		static bool 	nextMove(Triangulation const * const T, int &index, double &dx, double &dy)
+		static bool 	nextInsertionMove(Vertex const * const v, double &dx, double &dy)
+		static bool 	nextInsertion(Triangulation const * const T, const unsigned int pID,
+							TEdge *&e)
+		static void 	skipInsertion()
+		static void 	close()
+	*/
+
+
+	/*
+		O ~ T ~ H ~ E ~ R ~ S
+	*/
+
+	/*
+		@param 	v 	The moving vertex
+		@param 	dx 	The generated x-component of the translation vector
+		@param 	dy 	The generated y-component of the translation vector
+		@return 	The scale of the translation, see getDirectedEdgeLength()
+	*/
+	static double getScale(Vertex const * const v, const double dx, const double dy);
+
+	/*
+		The function openRecord() creates the log file and enables the recording. It errors
+		with exit code 20 if the file can not be opened.
+
+		@param 	filename 	The name of the file
+	*/
+	static void openRecord(const char *filename);
+
+	/*
+		The function openReplay() opens the log file and enables the replay. It errors with
+		exit code 20 if the file can not be opened or is no log.
+
+		@param 	filename 	The name of the file
+	*/
+	static void openReplay(const char *filename);
+
+	/*
+		The function addTranslation() adds a tried translation to the recorded log and, for a
+		replay, compares whether it has been executed to the recorded outcome.
+
+		@param 	index 	The index of the moving vertex in the triangulation
+		@param 	dx 		The generated x-component of the translation vector
+		@param 	dy 		The generated y-component of the translation vector
+		@param 	scale 	The scale of the translation before its execution
+		@param 	e 		The engine which has been used for the translation
+		@param 	ex 		The outcome of the translation
+	*/
+	static void addTranslation(const int index, const double dx, const double dy,
+		const double scale, const Engine e, const Executed ex);
+
+	/*
+		The function addInsertion() adds the choice of an edge to insert in to the recorded
+		log. The following translations belong to the new vertex until endInsertion() gets
+		called.
+
+		@param 	pID 	The ID of the polygon
+		@param 	index 	The index of the first vertex of the edge in the triangulation
+		@param 	stable 	True if the edge has passed the stability check
+	*/
+	static void addInsertion(const unsigned int pID, const int index, const bool stable);
+
+	/*
+		The function endInsertion() marks the end of the translations of an inserted vertex.
+	*/
+	static void endInsertion();
+
+	/*
+		The function nextMove() returns the next translation of a translation phase from the
+		replayed log. It errors with exit code 20 if the log has no such translation.
+
+		@param 	T 		The triangulation the polygon lives in
+		@param 	index 	The index of the moving vertex in the triangulation
+		@param 	dx 		The generated x-component of the translation vector
+		@param 	dy 		The generated y-component of the translation vector
+		@return 		False if the moving vertex does not exist in the actual run, then the
+						translation gets skipped, otherwise true
+	*/
+	static bool nextMove(Triangulation const * const T, int &index, double &dx, double &dy);
+
+	/*
+		The function nextInsertionMove() returns the next translation of the inserted vertex
+		from the replayed log.
+
+		@param 	v 	The inserted vertex
+		@param 	dx 	The generated x-component of the translation vector
+		@param 	dy 	The generated y-component of the translation vector
+		@return 	False if the recorded run has not tried any more translations of the
+					inserted vertex, otherwise true
+	*/
+	static bool nextInsertionMove(Vertex const * const v, double &dx, double &dy);
+
+	/*
+		The function nextInsertion() returns the next choice of an edge to insert in from
+		the replayed log. It errors with exit code 20 if the log has no such choice for the
+		polygon.
+
+		@param 	T 		The triangulation the polygon lives in
+		@param 	pID 	The ID of the polygon
+		@param 	e 		The edge to insert in, NULL if it does not exist in the actual run,
+						then the insertion gets skipped
+		@return 		False if the edge has not passed the stability check in the recorded
+						run, otherwise true
+	*/
+	static bool nextInsertion(Triangulation const * const T, const unsigned int pID, TEdge *&e);
+
+	/*
+		The function skipInsertion() counts a replayed insertion which is not possible in the
+		actual run.
+	*/
+	static void skipInsertion();
+
+	/*
+		The function close() closes the log file and reports for a replay the number of
+		translations executed differently than recorded and the numbers of skipped and unused
+		proposals.
+	*/
+	static void close();
+};
+
+#endif
@@ -0,0 +1,325 @@
+/*
+ * Copyright 2021 Philipp Mayer - pmayer@cs.sbg.ac.at
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+/*
+	Include standard libraries
+*/
+#include <stdio.h>
+#include <vector>
+#include <algorithm>
+#include <math.h>
+
+/*
+	Include my headers
+*/
+#include "triangulation.h"
+#include "tedge.h"
+#include "vertex.h"
+#include "triangle.h"
+#include "translation.h"
+#include "translationCheck.h"
+#include "settings.h"
+#include "statistics.h"
+#include "workerPool.h"
+#include "engineSelector.h"
+
+
+#ifndef __PARALLELTRANSFORMER_H_
+#define __PARALLELTRANSFORMER_H_
+
+/*
+	A translation proposed for the parallel translation phase. The random values are drawn
+	sequentially from the global RandomGenerator, the distance is computed from z not until
+	the translation gets executed, as it depends on the triangulation at that time.
+*/
+struct Proposal{
+	// The position of the proposal in the order of generation
+	int seq;
+
+	// The index of the moving vertex in the triangulation
+	int index;
+
+	// The direction of the translation
+	double alpha;
+
+	// A standard normally distributed value for computing the distance
+	double z;
+};
+
+/*
+	The result of the speculative check of a proposal. It stays valid as long as none of
+	the vertices the check has read changes its version.
+*/
+struct SpeculativeCheck{
+	// The generated translation vector at the time of the check
+	double dx;
+	double dy;
+
+	// True if the translation passed the orientation and the simplicity check
+	bool accepted;
+
+	// The reason of the rejection and the time the check took (in seconds), just valid if
+	// the translation has been rejected
+	Rejection rejection;
+	double time;
+
+	// The number of triangles passed by the simplicity check
+	unsigned int triangles;
+
+	// The vertices the check has read and their versions at the time of the check
+	std::vector<Vertex*> readSet;
+	std::vector<unsigned long long> versions;
+};
+
+
+/*
+	The function parallelTranslationsApplicable() decides whether the translations of a
+	polygon can be executed by transformPolygonByMovesParallel().
+
+	@param 	T 	The triangulation the polygon lives in
+	@return 	True if multiple threads are enabled, the polygon has no holes and it is large
+				enough to be split into cells, otherwise false
+
+	Note:
+		- The same size limit is used for the partition and the independent set mode
+		- The speculative mode does not split the polygon, so it has no size limit
+*/
+bool parallelTranslationsApplicable(Triangulation const * const T);
+
+/*
+	The function transformPolygonByMovesParallel() does the same as transformPolygonByMoves()
+	but executes the translations in parallel. Therefore it works in rounds. At the start of
+	each round the polygon gets partitioned into the cells of a randomly shifted grid and the
+	proposals of the round get distributed to the cells of their moving vertices. Each cell
+	is processed by one thread, which executes the proposals whose affected region is part of
+	the cell. All other proposals are deferred and executed sequentially at the end of the
+	round.
+
+	@param 	T 			The triangulation the polygon lives in
+	@param 	iterations	The number of moves which should be tried
+	@return 			The number of moves which were executed at least partially
+
+	Note:
+		- The vertices are selected uniformly at random from the whole polygon exactly as in
+			the sequential version and all proposals get tried, so deferring proposals just
+			changes the order in which independent translations get executed
+		- For a fixed seed the result does not depend on the number of threads
+		- This function works just for polygons without holes!
+*/
+int transformPolygonByMovesParallel(Triangulation * const T, const int iterations);
+
+/*
+	The function transformPolygonByMovesIndependent() does the same as
+	transformPolygonByMoves() but executes the translations in parallel rounds of
+	independent translations. Each round it fills a pool of proposals and selects a
+	maximal subset of them whose 2-ring neighbourhoods in the triangulation are pairwise
+	disjoint. The selected translations are executed concurrently, each one restricted to
+	its reserved neighbourhood. Translations which would leave their neighbourhood are
+	rejected for the concurrent step and executed sequentially at the end of the round.
+
+	@param 	T 			The triangulation the polygon lives in
+	@param 	iterations	The number of moves which should be tried
+	@return 			The number of moves which were executed at least partially
+
+	Note:
+		- For a fixed seed the result does not depend on the number of threads
+		- This function works just for polygons without holes!
+*/
+int transformPolygonByMovesIndependent(Triangulation * const T, const int iterations);
+
+/*
+	The function transformPolygonByMovesSpeculative() does the same as
+	transformPolygonByMoves() but checks the proposals speculatively in parallel. It works in
+	batches. First the worker pool checks all proposals of a batch against the unchanged
+	triangulation, afterwards the main thread commits them in generation order. Proposals
+	whose check is still up to date are executed without checking them again respectively
+	skipped if they failed the check, all others get checked and executed as usual.
+
+	@param 	T 			The triangulation the polygon lives in
+	@param 	iterations	The number of moves which should be tried
+	@return 			The number of moves which were executed at least partially
+
+	Note:
+		- As all translations get committed in generation order, the result is the same as
+			executing the proposals sequentially and for a fixed seed it does not depend on
+			the number of threads
+		- The gain grows with the rejection rate, as rejected proposals do not change the
+			triangulation and therefore do not outdate the other checks
+		- A batch holds 64 proposals per thread
+		- This function works just for polygons without holes!
+*/
+int transformPolygonByMovesSpeculative(Triangulation * const T, const int iterations);
+
+/*
+	The function getWorkerPool() returns the worker pool all parallel steps run on. The
+	pool gets started at the first call and uses Settings::threads threads.
+
+	@return 	The worker pool
+*/
+WorkerPool *getWorkerPool();
+
+/*
+	The function precheckTranslation() checks a translation without changing the
+	triangulation, so it can run concurrently to other checks.
+
+	@param 	T 	The triangulation the polygon lives in
+	@param 	v 	The moving vertex
+	@param 	dx 	The generated x-component of the translation vector
+	@param 	dy 	The generated y-component of the translation vector
+	@param 	c 	The check result, its read set and the versions of the read vertices
+*/
+void precheckTranslation(Triangulation * const T, Vertex * const v, const double dx,
+	const double dy, SpeculativeCheck &c);
+
+/*
+	The function isUpToDate() checks whether a speculative check is still valid, i.e. none
+	of the vertices it has read changed since the check.
+
+	@param 	c 	The speculative check
+	@return 	True if the check is still valid, otherwise false
+*/
+bool isUpToDate(SpeculativeCheck const &c);
+
+/*
+	The function assignRegions() partitions the polygon by a grid of
+	(Settings::cellsPerSide + 1)^2 cells which gets randomly shifted and assigns each
+	vertex to the region of its cell.
+
+	@param 	T 	The triangulation the polygon lives in
+	@return 	The number of regions
+*/
+int assignRegions(Triangulation * const T);
+
+/*
+	The function checkRegion() checks whether a translation just affects entities of one
+	region. That is the case if the moving vertex and its neighbors belong to the region
+	and all triangles incident to the moving vertex or intersecting the bounding box of
+	the old and the new position of the moving vertex and its neighbors have all their
+	vertices in the region.
+
+	@param 	v 		The moving vertex
+	@param 	tx 		The x-component of the effective translation vector
+	@param 	ty 		The y-component of the effective translation vector
+	@param 	region 	The region of the executing thread
+	@return 		True if the translation just affects entities of the region, otherwise false
+
+	Note:
+		- Both translation types just change triangles which are incident to the moving vertex
+			or intersect the convex hull of its old and new position and its neighbors. The
+			bounding box is a conservative replacement of this hull
+		- The triangles are visited by a flood fill starting at the moving vertex, which
+			never leaves the region, so it does not read any entity another thread changes
+*/
+bool checkRegion(Vertex * const v, const double tx, const double ty, const int region);
+
+/*
+	The function isInRegion() checks whether all vertices of a triangle belong to a region.
+
+	@param 	t 		The triangle of interest
+	@param 	region 	The region
+	@return 		True if all vertices of t belong to the region, otherwise false
+*/
+bool isInRegion(Triangle const * const t, const int region);
+
+/*
+	The function intersectsBox() checks whether an edge intersects an axis-parallel box.
+
+	@param 	e 		The edge of interest
+	@param 	minX 	The minimum x-coordinate of the box
+	@param 	maxX 	The maximum x-coordinate of the box
+	@param 	minY 	The minimum y-coordinate of the box
+	@param 	maxY 	The maximum y-coordinate of the box
+	@return 		True if the edge intersects the box, otherwise false
+*/
+bool intersectsBox(TEdge const * const e, const double minX, const double maxX,
+	const double minY, const double maxY);
+
+/*
+	The function translateCell() executes the proposals of one cell which just affect its
+	region and collects the others.
+
+	@param 	T 			The triangulation the polygon lives in
+	@param 	proposals 	The proposals of the cell
+	@param 	region 		The region of the cell
+	@param 	deferred 	The proposals which have to be executed sequentially
+	@return 			The number of moves which were executed at least partially
+*/
+int translateCell(Triangulation * const T, std::vector<Proposal> const &proposals,
+	const int region, std::vector<Proposal> &deferred);
+
+/*
+	The function reserveNeighbourhood() reserves the 2-ring neighbourhood of a vertex, i.e.
+	the vertex, its neighbors in the triangulation and their neighbors, for one region if
+	none of these vertices is already reserved.
+
+	@param 	v 			The vertex of interest
+	@param 	region 		The region the neighbourhood gets reserved for
+	@param 	reserved 	The list of all reserved vertices, the vertices of the neighbourhood
+						get appended
+	@return 			True if the neighbourhood has been reserved, otherwise false
+
+	Note:
+		The vertices of the bounding box are neither reserved nor expanded, as they are
+		adjacent to a large part of the polygon. Translations touching their triangles
+		leave the neighbourhood and get executed sequentially.
+*/
+bool reserveNeighbourhood(Vertex * const v, const int region, std::vector<Vertex*> &reserved);
+
+/*
+	The function translateReserved() executes a proposal which is restricted to the reserved
+	neighbourhood of its moving vertex.
+
+	@param 	T 		The triangulation the polygon lives in
+	@param 	p 		The proposal
+	@param 	region 	The region the neighbourhood of the moving vertex is reserved for
+	@return 		-1 if the translation would leave the neighbourhood, 1 if it has been
+					executed at least partially, otherwise 0
+*/
+int translateReserved(Triangulation * const T, Proposal const &p, const int region);
+
+/*
+	The function recordParallelRound() adds the results of one parallel round to the
+	statistics.
+
+	@param 	parallel 	The number of translations processed by the workers
+	@param 	deferred 	The number of translations which have been executed sequentially
+	@param 	cpuTime 	The CPU time all threads spent on the round (in seconds)
+	@param 	wallTime 	The wall-clock time of the round including its sequential parts
+						(in seconds)
+*/
+void recordParallelRound(const unsigned long long parallel, const unsigned long long deferred,
+	const double cpuTime, const double wallTime);
+
+/*
+	The function getProposalTranslation() computes the translation vector of a proposal in
+	the same way transformPolygonByMoves() does.
+
+	@param 	T 	The triangulation the polygon lives in
+	@param 	p 	The proposal
+	@param 	dx 	The generated x-component of the translation vector
+	@param 	dy 	The generated y-component of the translation vector
+
+	Note:
+		- The distance is bounded away from 0 in the same way RandomGenerator::getDoubleNormal()
+			does it
+		- The scale of the acceptance controller does not change during a parallel phase, so
+			the proposals can be computed concurrently
+*/
+void getProposalTranslation(Triangulation * const T, Proposal const &p, double &dx, double &dy);
+
+#endif
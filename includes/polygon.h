@@ -19,7 +19,8 @@
 /*
 	Include standard libraries
 */
-
+#include <stddef.h>
+#include <vector>
 
 /*
 	Include my headers	
@@ -52,24 +53,48 @@ enum class PolygonType {STARSHAPED, EDGEVISIBLE};
 
 
 /*
-	Element types
+	Element types, linked by their indices in the scratch memory of the polygons
+	(-1 if not linked yet)
 */
 
-struct PolygonVertex;
-struct PolygonEdge;
-
 // Vertex
 struct PolygonVertex{
 	Vertex *v;
-	PolygonEdge *prevE;
-	PolygonEdge *nextE;
+	int prevE;
+	int nextE;
 };
 
 //Edge
 struct PolygonEdge{
 	TEdge *e;
-	PolygonVertex *prevV;
-	PolygonVertex *nextV;
+	int prevV;
+	int nextV;
+};
+
+/*
+	The scratch memory of the polygons of one thread. The vertices and edges of all
+	polygons get placed in the vectors consecutively and are not freed individually.
+	Both vectors get cleared as soon as no polygon is alive anymore, i.e. at the end
+	of each translation, but keep their capacity, so building the polygons of the next
+	translation does not allocate anything.
+*/
+struct PolygonScratch{
+	// The vertices and edges of the living polygons
+	std::vector<PolygonVertex> vertices;
+	std::vector<PolygonEdge> edges;
+
+	// The number of living polygons
+	unsigned int living;
+
+	// The memory of deleted polygons for reuse
+	std::vector<void*> free;
+
+	PolygonScratch() : living(0) {}
+
+	~PolygonScratch(){
+		for(auto& p : free)
+			::operator delete(p);
+	}
 };
 
 
@@ -102,7 +127,7 @@ private:
 		In case of an edge-visible polygon, the predecessor entity of the start
 		vertex is the base edge.
 	*/
-	PolygonVertex *startVertex;
+	int startVertex;
 
 	/*
 		A flag whether the polygonal chain is already closed
@@ -113,19 +138,24 @@ private:
 		The vertex inserted last, in case a vertex has been inserted last.
 		In case an edge has been inserted last, then NULL.
 	*/
-	PolygonVertex *lastVUsed;
+	int lastVUsed;
 
 	/*
 		The edge inserted last, in case an edge has been inserted last.
 		In case a vertex has been inserted last, then NULL.
 	*/
-	PolygonEdge *lastEUsed;
+	int lastEUsed;
 
 	/*
 		One point of the kernel in case of a star-shaped polygon
 	*/
 	Vertex *kernel;
 
+	/*
+		The scratch memory of the polygons of the calling thread
+	*/
+	static thread_local PolygonScratch scratch;
+
 
 	/*
 		P ~ R ~ I ~ V ~ A ~ T ~ E 	M ~ E ~ M ~ B ~ E ~ R 	F ~ U ~ N ~ C ~ T ~ I ~ O ~ N ~ S
@@ -150,9 +180,32 @@ private:
 	*/
 	void triangulateVisible();
 
+	/*
+		@param 	i 	The index of a vertex in the scratch memory
+		@return 	The vertex
+	*/
+	static PolygonVertex &vertex(const int i){
+		return scratch.vertices[i];
+	}
+
+	/*
+		@param 	i 	The index of an edge in the scratch memory
+		@return 	The edge
+	*/
+	static PolygonEdge &edge(const int i){
+		return scratch.edges[i];
+	}
+
 
 public:
 
+	/*
+		Polygons reuse the memory of deleted polygons of the same thread
+	*/
+	static void *operator new(size_t n);
+
+	static void operator delete(void *p);
+
 	/*
 		LIST OF PUBLIC MEMBER FUNCTIONS
 
@@ -168,6 +221,10 @@ public:
 		void 	changeType(PolygonType tp)
 		void 	close(TEdge *e)
 
+		GETTER:
+
+		int 	getSize() const
+
 		OTHERS:
 
 		void 	print()
@@ -251,6 +308,16 @@ public:
 	void print();
 
 
+	/*
+		G ~ E ~ T ~ T ~ E ~ R ~ S
+	*/
+
+	/*
+		@return 	The number of vertices of the polygon
+	*/
+	int getSize() const;
+
+
 	/*
 		O ~ T ~ H ~ E ~ R ~ S
 	*/
@@ -269,7 +336,7 @@ public:
 
 	/*
 		Destructor:
-		Cleans up the polygonal chain if necessary.
+		Clears the scratch memory if no other polygon is alive anymore.
 	*/
 	~Polygon();
 };
@@ -0,0 +1,60 @@
+/*
+ * Copyright 2021 Philipp Mayer - pmayer@cs.sbg.ac.at
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+/*
+	Include standard libraries
+*/
+#include <vector>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <errno.h>
+#include <string.h>
+#include <algorithm>
+
+/*
+	Include my headers
+*/
+#include "predicates.h"
+
+#ifndef __POLYGONREADER_H_
+#define __POLYGONREADER_H_
+
+/*
+	The magic bytes at the beginning of a polygon file in binary format. The binary format
+	continues with the number of rings (uint32) and for each ring its number of vertices
+	(uint32) followed by the coordinates x and y (double) of its vertices, all numbers are
+	stored in the byte order of the machine.
+*/
+static const char polygonMagic[8] = {'F', 'P', 'G', 'P', 'O', 'L', 'Y', '1'};
+
+
+/*
+	The function readPolygonFile() reads the rings of a polygon from a file written in .line,
+	.dat or binary format, the format is detected by the content of the file. The repeated
+	first vertex at the end of each ring and consecutive duplicates get removed, afterwards
+	the first ring gets oriented counterclockwise and all other rings clockwise. It errors
+	with exit code 21 if the file can not be read or a ring has less than three vertices.
+
+	@param 	filename 	The name of the polygon file
+	@param 	rings 		The vector the rings get appended to, the first one is the outer
+						polygon and the others are the holes
+*/
+void readPolygonFile(const char *filename, std::vector<std::vector<point>> &rings);
+
+#endif
@@ -24,6 +24,7 @@
 #include <vector>
 #include <map>
 #include <math.h>
+#include <chrono>
 
 /*
 	Include my headers	
@@ -38,6 +39,38 @@
 #include "insertion.h"
 #include "settings.h"
 #include "holeInsertion.h"
+#include "parallelTransformer.h"
+#include "engineSelector.h"
+#include "moveLog.h"
+
+
+/*
+	The function tryTranslation() checks a single translation for an orientation change and
+	simplicity and executes it in case it passes both checks.
+
+	@param 	T 	The triangulation the polygon lives in
+	@param 	index 	The index of the moving vertex in the triangulation
+	@param 	dx 		The generated x-component of the translation vector
+	@param 	dy 		The generated y-component of the translation vector
+	@param 	checked True if the same translation already passed both checks in a speculative
+					check which is still up to date, then the checks get skipped
+	@param 	crossed The number of triangles passed by the speculative check, just used by
+					the hybrid engine if checked is true
+	@return 		Indicates whether the translation was rejected, aborted or fully processed
+*/
+enum Executed tryTranslation(Triangulation * const T, const int index, const double dx,
+	const double dy, const bool checked = false, const unsigned int crossed = 0);
+
+/*
+	The function getEffectiveTranslation() returns the translation vector a call of
+	tryTranslation() with the generated components dx and dy really applies.
+
+	@param 	dx 	The generated x-component of the translation vector
+	@param 	dy 	The generated y-component of the translation vector
+	@param 	tx 	The effective x-component of the translation vector
+	@param 	ty 	The effective y-component of the translation vector
+*/
+void getEffectiveTranslation(const double dx, const double dy, double &tx, double &ty);
 
 
 /*
@@ -55,9 +88,41 @@
 			which should be tried
 		- For polygons with holes the vertex also is randomly selected, i.e. it can be from
 			the outer polygon as well as of one of the inner polygons
+		- If bounded distances are enabled, the distance gets drawn from the normal
+			distribution truncated to the free distances of the vertex in the direction of
+			the translation and the opposite one
+		- If a target acceptance rate is given, the distances get scaled by the
+			AcceptanceController, which gets adjusted by the results of the moves
+		- If the relayout is enabled, the triangulation gets relayouted before the moves
+			in case the polygon has doubled since the last relayout
+		- If local blocks are enabled, the vertices of the sequential moves get selected
+			by the VertexScheduler
+		- If a log gets replayed, the vertices and the translation vectors are taken from
+			the MoveLog instead
+		- If batched proposals are enabled, the vertices, the directions and the normally
+			distributed values of the distances are taken from the ProposalBuffer, just
+			bounded distances still get drawn one by one
 */
 int transformPolygonByMoves(Triangulation * const T, const int iterations);
 
+/*
+	The function recordTranslationPhase() adds the results of a translation phase to the
+	statistics.
+
+	@param 	tries 		The number of moves which have been tried
+	@param 	performed 	The number of moves which have been executed at least partially
+	@param 	startTime 	The time the translation phase started at (in seconds)
+*/
+void recordTranslationPhase(const int tries, const int performed, const double startTime);
+
+/*
+	The function traceSize() adds the actual number of vertices and triangles of the
+	triangulation to the trace if tracing is enabled.
+
+	@param 	T 	The triangulation the polygon lives in
+*/
+void traceSize(Triangulation const * const T);
+
 
 /*
 	The function growPolygonBy() grows a polygon by n insertions.
@@ -67,10 +132,43 @@ int transformPolygonByMoves(Triangulation * const T, const int iterations);
 	@param 	n 		The number of vertices to insert
 
 	Note:
-		This function works just for polygons without holes!
+		- This function works just for polygons without holes!
+		- If bulk growth is enabled, the insertions are done by growPolygonByBulk()
+		- If direct insertion is enabled, the new vertices get placed by executeDirect() and
+			bulk growth is not used
+		- If the relayout is enabled, the triangulation gets relayouted whenever the polygon
+			has doubled since the last relayout
+		- If a log gets replayed, the edges to insert in are taken from the MoveLog
 */
 void growPolygonBy(Triangulation * const T, const unsigned int pID,  const int n);
 
+/*
+	The function growPolygonByBulk() grows a polygon by n insertions which are done in
+	rounds. Each round it selects a batch of polygon edges by the usual edge
+	selection, just taking edges which are not adjacent to an already selected one. It
+	splits all of them and afterwards translates the new vertices in parallel, each one
+	restricted to its reserved 2-ring neighbourhood. Translations of new vertices whose
+	neighbourhood could not be reserved or which would leave it are continued
+	sequentially at the end of the round.
+
+	@param 	T 		The triangulation the polygon lives in
+	@param	pID 	The ID of the polygon
+	@param 	n 		The number of vertices to insert
+
+	Note:
+		- The splits stay sequential, as they are cheap compared to the translations but
+			change the vertex list and the SelectionTree of the polygon
+		- Each new vertex draws its translations from its own random generator split from
+			the global one, but the translated polygon edges get reinserted into the
+			SelectionTree in the order the threads execute them, so with multiple threads
+			the result of a fixed seed may differ between runs
+		- A round holds 1/512 of the current polygon size, but at least one insertion
+		- If the relayout is enabled, the triangulation gets relayouted between the rounds
+			whenever the polygon has doubled since the last relayout
+		- This function works just for polygons without holes!
+*/
+void growPolygonByBulk(Triangulation * const T, const unsigned int pID, const int n);
+
 
 /*
 	This strategy starts with a small regular polygon, applies a bunch of translations
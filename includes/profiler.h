@@ -0,0 +1,283 @@
+/*
+ * Copyright 2021 Philipp Mayer - pmayer@cs.sbg.ac.at
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+/*
+	Include standard libraries
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+#include <mutex>
+#include <vector>
+
+#ifndef __PROFILER_H_
+#define __PROFILER_H_
+
+/*
+	The code sections measured by the profiler:
+	ORIENTATION: 		checkOrientation() of both translation engines
+	SIMPLICITY: 		checkSimplicityOfTranslation()
+	KINETIC: 			TranslationKinetic::execute()
+	RETRIANGULATION: 	TranslationRetriangulation::execute()
+	TRIANGULATE: 		Polygon::triangulate()
+	INSERTIONEXECUTE: 	Insertion::execute() and Insertion::executeDirect()
+	INSERTIONTRANSLATE: Insertion::translate() and Insertion::translateSpeculative()
+	GLOBALCHECK: 		Triangulation::check()
+	OUTPUT: 			Writing the polygon and the triangulation
+*/
+enum class ProfileSection : unsigned int { ORIENTATION, SIMPLICITY, KINETIC, RETRIANGULATION,
+	TRIANGULATE, INSERTIONEXECUTE, INSERTIONTRANSLATE, GLOBALCHECK, OUTPUT };
+
+/*
+	The number of code sections measured by the profiler
+*/
+const unsigned int nrProfileSections = 9;
+
+/*
+	The number of buckets per power of two of the duration histograms and the total number
+	of buckets
+*/
+const unsigned int profileSubBuckets = 8;
+const unsigned int profileBuckets = 64 * profileSubBuckets;
+
+/*
+	The measurements of one code section.
+*/
+struct ProfileSectionCounters{
+	// The number of measured executions
+	unsigned long long count;
+
+	// The sum and the maximum of the durations (in nanoseconds)
+	unsigned long long total;
+	unsigned long long max;
+
+	// The number of executions per duration bucket
+	unsigned long long buckets[profileBuckets];
+};
+
+/*
+	The measurements of one thread. The counters register themselves at the Profiler, such
+	that the report can merge the counters of all threads.
+*/
+struct ProfileCounters{
+	// The measurements per code section
+	ProfileSectionCounters sections[nrProfileSections];
+
+	// The number of running measurements per code section, to measure nested executions
+	// of the same section just once
+	unsigned int depth[nrProfileSections];
+
+	/*
+		Constructor:
+		Registers the counters of the calling thread at the Profiler.
+	*/
+	ProfileCounters();
+
+	/*
+		Destructor:
+		Hands the counters of a finishing thread over to the Profiler.
+	*/
+	~ProfileCounters();
+};
+
+/*
+	A profiler for the hot paths of the generation. The code sections get measured by
+	ScopedTimers, which add their durations to counters of their thread. The report merges
+	the counters of all threads and writes them into a JSON file.
+*/
+class Profiler{
+
+private:
+
+	/*
+		The mutex protecting the registry of the counters
+	*/
+	static std::mutex lock;
+
+	/*
+		The counters of all running threads which have measured anything
+	*/
+	static std::vector<ProfileCounters*> live;
+
+	/*
+		The merged counters of all finished threads
+	*/
+	static ProfileSectionCounters finished[nrProfileSections];
+
+
+	/*
+		P ~ R ~ I ~ V ~ A ~ T ~ E 	M ~ E ~ M ~ B ~ E ~ R 	F ~ U ~ N ~ C ~ T ~ I ~ O ~ N ~ S
+	*/
+
+	/*
+		The function merge() adds the counters of all code sections to other counters.
+
+		@param 	to 		The counters to add to
+		@param 	from 	The counters to add
+	*/
+	static void merge(ProfileSectionCounters * const to, ProfileSectionCounters const * const from);
+
+	/*
+		The function getPercentile() computes a percentile of the durations of a code
+		section by its histogram.
+
+		@param 	s 	The counters of the code section
+		@param 	p 	The percentile in [0, 1]
+		@return 	The geometric middle of the bucket containing the percentile (in
+					nanoseconds), 0 if there are no measurements
+	*/
+	static double getPercentile(ProfileSectionCounters const &s, const double p);
+
+
+public:
+
+	/*
+		The flag for enabling the measurements
+	*/
+	static bool enabled;
+
+	/*
+		The counters of the calling thread
+	*/
+	static thread_local ProfileCounters counters;
+
+
+	/*
+		LIST OF PUBLIC MEMBER FUNCTIONS
+
+		OTHERS:
+
+		static void 		registerCounters(ProfileCounters * const c)
+		static void 		unregisterCounters(ProfileCounters * const c)
+		static void 		record(const ProfileSection s, const unsigned long long ns)
+		static const char* 	getName(const ProfileSection s)
+		static void 		writeReport(const char *filename)
+	*/
+
+
+	/*
+		O ~ T ~ H ~ E ~ R ~ S
+	*/
+
+	/*
+		The function registerCounters() adds the counters of a new thread to the registry.
+
+		@param 	c 	The counters of the thread
+	*/
+	static void registerCounters(ProfileCounters * const c);
+
+	/*
+		The function unregisterCounters() removes the counters of a finishing thread from
+		the registry and merges them into the counters of the finished threads.
+
+		@param 	c 	The counters of the thread
+	*/
+	static void unregisterCounters(ProfileCounters * const c);
+
+	/*
+		The function record() adds one measurement to the counters of the calling thread.
+
+		@param 	s 	The measured code section
+		@param 	ns 	The duration (in nanoseconds)
+	*/
+	static void record(const ProfileSection s, const unsigned long long ns);
+
+	/*
+		@param 	s 	A code section
+		@return 	The name of the code section in the report
+	*/
+	static const char *getName(const ProfileSection s);
+
+	/*
+		The function writeReport() merges the counters of all threads and writes the
+		count, the total, the mean and the percentiles of the durations of each code
+		section into a JSON file.
+
+		@param 	filename 	The name of the file
+
+		Note:
+			- Must not be called while other threads measure anything
+			- Sections can be nested in other sections, e.g. the translations of the
+				insertions, so their totals can add up to more than the elapsed time
+	*/
+	static void writeReport(const char *filename);
+};
+
+/*
+	A timer which measures the lifetime of its scope if the profiler is enabled. Nested
+	timers of the same code section in one thread get measured by the outermost one only.
+*/
+class ScopedTimer{
+
+private:
+
+	/*
+		The measured code section
+	*/
+	ProfileSection section;
+
+	/*
+		The flag whether this timer measures
+	*/
+	bool active;
+
+	/*
+		The time the measurement started at
+	*/
+	std::chrono::steady_clock::time_point start;
+
+public:
+
+	/*
+		Constructor:
+		Starts the measurement if the profiler is enabled and no other timer of the same
+		code section is running in this thread.
+
+		@param 	s 	The measured code section
+	*/
+	ScopedTimer(const ProfileSection s) : section(s), active(false) {
+		unsigned int i = (unsigned int)s;
+
+		if(!Profiler::enabled)
+			return;
+
+		if(Profiler::counters.depth[i]++ == 0){
+			active = true;
+			start = std::chrono::steady_clock::now();
+		}
+	}
+
+	/*
+		Destructor:
+		Records the measurement.
+	*/
+	~ScopedTimer(){
+		unsigned int i = (unsigned int)section;
+
+		if(!Profiler::enabled)
+			return;
+
+		Profiler::counters.depth[i]--;
+
+		if(active)
+			Profiler::record(section, std::chrono::duration_cast<std::chrono::nanoseconds>(
+				std::chrono::steady_clock::now() - start).count());
+	}
+};
+
+#endif
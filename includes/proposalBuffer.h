@@ -0,0 +1,181 @@
+/*
+ * Copyright 2021 Philipp Mayer - pmayer@cs.sbg.ac.at
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+/*
+	Include standard libraries
+*/
+#include <vector>
+#include <math.h>
+
+/*
+	Include my headers
+*/
+#include "randomGenerator.h"
+
+#ifndef __PROPOSALBUFFER_H_
+#define __PROPOSALBUFFER_H_
+
+/*
+	A buffer of pre-generated random variates for proposing translations. It draws blocks of
+	vertex indices, directions and standard normally distributed values for the distances
+	from a RandomGenerator and computes the cosine and sine of all directions of a block in
+	one pass, such that the loops proposing translations just consume the values.
+
+	The order of the draws differs from drawing each proposal separately, i.e. the generated
+	polygons differ from the ones without buffer, but for a fixed seed the sequence of
+	proposals stays the same between runs.
+*/
+class ProposalBuffer{
+
+private:
+
+	/*
+		The generator the variates get drawn from
+	*/
+	RandomGenerator *gen;
+
+	/*
+		The number of possible indices of the buffered proposals, 0 if no indices get drawn
+	*/
+	int range;
+
+	/*
+		The position of the next unused proposal and the number of buffered proposals
+	*/
+	unsigned int pos;
+	unsigned int size;
+
+	/*
+		The buffered variates, one entry per proposal
+	*/
+	std::vector<int> indices;
+	std::vector<double> alphas;
+	std::vector<double> cosines;
+	std::vector<double> sines;
+	std::vector<double> zs;
+
+
+	/*
+		The function fill() draws a new block of proposals.
+	*/
+	void fill();
+
+
+public:
+
+	/*
+		The number of proposals drawn at once
+	*/
+	static const unsigned int blockSize = 1024;
+
+
+	/*
+		LIST OF PUBLIC MEMBER FUNCTIONS
+
+		CONSTRUCTORS:
+
+					ProposalBuffer(RandomGenerator * const g)
+
+		SETTER:
+
+		void 		setRange(const int n)
+
+		OTHERS:
+
+		void 		next(int &index, double &alpha, double &cosAlpha, double &sinAlpha,
+						double &z)
+		static void sinCos(double const * const alpha, double * const cosAlpha,
+						double * const sinAlpha, const unsigned int n)
+		static double getDistance(const double mean, const double stddev, const double z)
+	*/
+
+
+	/*
+		C ~ O ~ N ~ S ~ T ~ R ~ U ~ C ~ T ~ O ~ R ~ S
+	*/
+
+	/*
+		Constructor:
+		Starts with an empty buffer which draws no indices.
+
+		@param 	g 	The generator the variates get drawn from
+	*/
+	ProposalBuffer(RandomGenerator * const g);
+
+
+	/*
+		S ~ E ~ T ~ T ~ E ~ R ~ S
+	*/
+
+	/*
+		The function setRange() sets the number of possible indices of the following
+		proposals. If it differs from the actual one, the remaining buffered proposals get
+		discarded.
+
+		@param 	n 	The number of possible indices, 0 if the proposals need no index
+	*/
+	void setRange(const int n);
+
+
+	/*
+		O ~ T ~ H ~ E ~ R ~ S
+	*/
+
+	/*
+		The function next() returns the next buffered proposal and draws a new block if the
+		buffer is empty.
+
+		@param 	index 		The index of the moving vertex, 0 if the range is 0
+		@param 	alpha 		The direction of the translation in [-pi, pi)
+		@param 	cosAlpha 	The cosine of alpha
+		@param 	sinAlpha 	The sine of alpha
+		@param 	z 			A standard normally distributed value for computing the distance
+	*/
+	void next(int &index, double &alpha, double &cosAlpha, double &sinAlpha, double &z);
+
+	/*
+		The function sinCos() computes the cosine and the sine of n directions in [-pi, pi].
+		It reduces the directions to [-pi/4, pi/4] and evaluates the polynomials of fdlibm
+		without branches, such that the compiler can vectorize the loop.
+
+		@param 	alpha 		The directions
+		@param 	cosAlpha 	The array the cosines get written to
+		@param 	sinAlpha 	The array the sines get written to
+		@param 	n 			The number of directions
+
+		Note:
+			The results differ from cos() and sin() by at most a few units in the last place,
+			but do not depend on the vectorization
+	*/
+	static void sinCos(double const * const alpha, double * const cosAlpha,
+		double * const sinAlpha, const unsigned int n);
+
+	/*
+		The function getDistance() computes the translation distance from a standard normally
+		distributed value, bounded away from 0 in the same way RandomGenerator::getDoubleNormal()
+		does it.
+
+		@param 	mean 	The mean of the distance
+		@param 	stddev 	The standard deviation of the distance
+		@param 	z 		The standard normally distributed value
+		@return 		The distance
+	*/
+	static double getDistance(const double mean, const double stddev, const double z);
+};
+
+#endif
@@ -20,23 +20,314 @@
    Include standard libraries
 */
 #include <random>
+#include <limits>
+#include <math.h>
+#include <stdint.h>
 
 #ifndef __RANDOMGENERATOR_H_
 #define __RANDOMGENERATOR_H_
 
+/*
+	The engines of the RandomGenerator:
+		- MT19937: The Mersenne twister of the standard library with the distributions of the
+			standard library, which reproduces the polygons of earlier versions
+		- XOSHIRO: xoshiro256++ by Blackman and Vigna with normal variates from a ziggurat,
+			which is faster and can be split into independent streams cheaply
+*/
+enum class RandomEngine {MT19937, XOSHIRO};
+
 class RandomGenerator{
 	private:
-		
+
 		/*
-			The random device for getting a random seed
+			The engine used for drawing the random numbers
 		*/
-		std::random_device rd;
+		RandomEngine engine;
 
 		/*
-			The generator
+			The generator if the engine is MT19937
 		*/
 		std::mt19937 generator;
 
+		/*
+			The state of xoshiro256++ if the engine is XOSHIRO
+		*/
+		uint64_t state[4];
+
+		/*
+			The number of layers of the ziggurat and the parameters of Marsaglia and Tsang for
+			it, i.e. the start of the tail and the area of each layer
+		*/
+		static const unsigned int zigLayers = 128;
+		static constexpr double zigR = 3.442619855899;
+		static constexpr double zigV = 9.91256303526217e-3;
+
+		/*
+			The tables of the ziggurat as used by Doornik's ZIGNOR:
+			x 		The right borders of the layers, x[0] is the width of the base layer
+					containing the tail
+			ratio 	The ratio x[i + 1] / x[i], below it a value is inside of the layer
+		*/
+		struct Ziggurat{
+			double x[zigLayers + 1];
+			double ratio[zigLayers];
+
+			Ziggurat(){
+				unsigned int i;
+				double f = exp(- 0.5 * zigR * zigR);
+
+				x[0] = zigV / f;
+				x[1] = zigR;
+				x[zigLayers] = 0;
+
+				for(i = 2; i < zigLayers; i++){
+					x[i] = sqrt(- 2 * log(zigV / x[i - 1] + f));
+					f = exp(- 0.5 * x[i] * x[i]);
+				}
+
+				for(i = 0; i < zigLayers; i++)
+					ratio[i] = x[i + 1] / x[i];
+			}
+		};
+
+		/*
+			@return 	The tables of the ziggurat, computed at the first call
+		*/
+		static const Ziggurat &getZiggurat(){
+			static const Ziggurat zig;
+
+			return zig;
+		}
+
+		/*
+			The function splitMix() computes the next value of SplitMix64, which is used to
+			initialize the state of xoshiro256++ from a seed.
+
+			@param 	x 	The state of SplitMix64
+			@return 	The next value
+		*/
+		static uint64_t splitMix(uint64_t &x){
+			uint64_t z;
+
+			x = x + 0x9e3779b97f4a7c15ULL;
+			z = x;
+			z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+			z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+
+			return z ^ (z >> 31);
+		}
+
+		/*
+			@param 	x 	A 64-bit value
+			@param 	k 	The number of bits to rotate by (0 < k < 64)
+			@return 	x rotated left by k bits
+		*/
+		static uint64_t rotl(const uint64_t x, const int k){
+			return (x << k) | (x >> (64 - k));
+		}
+
+		/*
+			The function seedEngine() initializes the engine with a seed.
+
+			@param 	seed 	The seed
+		*/
+		void seedEngine(const unsigned int seed){
+			uint64_t x = seed;
+
+			if(engine == RandomEngine::MT19937){
+				generator.seed(seed);
+			}else{
+				state[0] = splitMix(x);
+				state[1] = splitMix(x);
+				state[2] = splitMix(x);
+				state[3] = splitMix(x);
+			}
+		}
+
+		/*
+			The function next() computes the next output of xoshiro256++.
+
+			@return 	64 random bits
+		*/
+		uint64_t next(){
+			uint64_t result = rotl(state[0] + state[3], 23) + state[0];
+			uint64_t t = state[1] << 17;
+
+			state[2] = state[2] ^ state[0];
+			state[3] = state[3] ^ state[1];
+			state[1] = state[1] ^ state[2];
+			state[0] = state[0] ^ state[3];
+
+			state[2] = state[2] ^ t;
+			state[3] = rotl(state[3], 45);
+
+			return result;
+		}
+
+		/*
+			The function jump() advances xoshiro256++ by 2^128 steps, so the outputs before and
+			after the jump do not overlap for any practical number of draws.
+		*/
+		void jump(){
+			static const uint64_t polynomial[4] = {0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL,
+				0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL};
+			uint64_t s[4] = {0, 0, 0, 0};
+			unsigned int i, b;
+
+			for(i = 0; i < 4; i++){
+				for(b = 0; b < 64; b++){
+					if(polynomial[i] & (1ULL << b)){
+						s[0] = s[0] ^ state[0];
+						s[1] = s[1] ^ state[1];
+						s[2] = s[2] ^ state[2];
+						s[3] = s[3] ^ state[3];
+					}
+					next();
+				}
+			}
+
+			state[0] = s[0];
+			state[1] = s[1];
+			state[2] = s[2];
+			state[3] = s[3];
+		}
+
+		/*
+			@param 	r 	64 random bits
+			@return 	A uniformly distributed double in [0, 1) from the upper 53 bits of r
+		*/
+		static double toUnit(const uint64_t r){
+			return (double)(r >> 11) * (1.0 / 9007199254740992.0);
+		}
+
+		/*
+			@return 	A uniformly distributed double in (0, 1) drawn by xoshiro256++
+		*/
+		double nextOpenUnit(){
+			return ((double)(next() >> 11) + 0.5) * (1.0 / 9007199254740992.0);
+		}
+
+		/*
+			The function nextNormal() draws a standard normally distributed double by the
+			ziggurat method in the version of Doornik (ZIGNOR) from xoshiro256++. Most draws
+			take one 64-bit output, the upper 53 bits for the value and the lowest 7 bits for
+			the layer.
+
+			@return 	The standard normally distributed double
+		*/
+		double nextNormal(){
+			const Ziggurat &zig = getZiggurat();
+			uint64_t r;
+			unsigned int i;
+			double u, x, y, f0, f1;
+
+			while(true){
+				r = next();
+				u = 2 * toUnit(r) - 1;
+				i = r & (zigLayers - 1);
+
+				// Inside of the layer
+				if(fabs(u) < zig.ratio[i])
+					return u * zig.x[i];
+
+				// In the tail of the base layer
+				if(i == 0){
+					do{
+						x = log(nextOpenUnit()) / zigR;
+						y = log(nextOpenUnit());
+					}while(- 2 * y < x * x);
+
+					return u < 0 ? x - zigR : zigR - x;
+				}
+
+				// At the wedge of the layer
+				x = u * zig.x[i];
+				f0 = exp(- 0.5 * (zig.x[i] * zig.x[i] - x * x));
+				f1 = exp(- 0.5 * (zig.x[i + 1] * zig.x[i + 1] - x * x));
+				if(f1 + toUnit(next()) * (f0 - f1) < 1.0)
+					return x;
+			}
+		}
+
+		/*
+			The function nextIndex() draws a uniformly distributed index from xoshiro256++ by
+			Lemire's multiply and shift, rejecting the few values which would bias the result.
+
+			@param 	range 	The number of possible indices
+			@return 		The index in [0, range)
+		*/
+		uint32_t nextIndex(const uint32_t range){
+			uint64_t m = (next() >> 32) * range;
+			uint32_t low = (uint32_t)m;
+
+			if(low < range){
+				while(low < (0u - range) % range){
+					m = (next() >> 32) * range;
+					low = (uint32_t)m;
+				}
+			}
+
+			return m >> 32;
+		}
+
+		/*
+			The function normalCDF() computes the cumulative distribution function of the
+			standard normal distribution.
+
+			@param 	x 	The value of interest
+			@return 	The probability of a standard normally distributed value being at most x
+		*/
+		static double normalCDF(const double x){
+			return 0.5 * erfc(- x / sqrt(2));
+		}
+
+		/*
+			The function normalQuantile() computes the inverse of normalCDF() by the rational
+			approximation of Peter J. Acklam followed by one step of Halley's method.
+
+			@param 	p 	The probability of interest (0 < p < 1)
+			@return 	The value x with normalCDF(x) = p
+		*/
+		static double normalQuantile(const double p){
+			const double a[6] = {-3.969683028665376e+01, 2.209460984245205e+02,
+				-2.759285104469687e+02, 1.383577518672690e+02, -3.066479806614716e+01,
+				2.506628277459239e+00};
+			const double b[5] = {-5.447609879822406e+01, 1.615858368580409e+02,
+				-1.556989798598866e+02, 6.680131188771972e+01, -1.328068155288572e+01};
+			const double c[6] = {-7.784894002430293e-03, -3.223964580411365e-01,
+				-2.400758277161838e+00, -2.549732539343734e+00, 4.374664141464968e+00,
+				2.938163982698783e+00};
+			const double d[4] = {7.784695709041462e-03, 3.224671290700398e-01,
+				2.445134137142996e+00, 3.754408661907416e+00};
+			const double pLow = 0.02425;
+			double q, r, x, e, u;
+
+			// Lower tail
+			if(p < pLow){
+				q = sqrt(-2 * log(p));
+				x = (((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5]) /
+					((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1);
+			// Upper tail
+			}else if(p > 1 - pLow){
+				q = sqrt(-2 * log(1 - p));
+				x = - (((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5]) /
+					((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1);
+			// Central region
+			}else{
+				q = p - 0.5;
+				r = q * q;
+				x = (((((a[0] * r + a[1]) * r + a[2]) * r + a[3]) * r + a[4]) * r + a[5]) * q /
+					(((((b[0] * r + b[1]) * r + b[2]) * r + b[3]) * r + b[4]) * r + 1);
+			}
+
+			// Refine the approximation to full machine precision
+			e = normalCDF(x) - p;
+			u = e * sqrt(2 * M_PI) * exp(x * x / 2);
+			x = x - u / (1 + x * u / 2);
+
+			return x;
+		}
+
 	public:
 		
 		/*
@@ -46,12 +337,15 @@ class RandomGenerator{
 		/*
 			Constructor:
 			
+			@param 	e 			The engine of the generator
 			@param 	fixedSeed 	Indicates whether the generator shall be initialized with a random
 								seed from the random device or a fixed seed
 			@param 	seed 		This number will be used as the seed of the random generator if the
 								flag fixedSeed is unset
 		*/
-		RandomGenerator(bool fixedSeed, unsigned int &seed){
+		RandomGenerator(const RandomEngine e, bool fixedSeed, unsigned int &seed) : engine(e){
+			// The random device for getting a random seed
+			std::random_device rd;
 			
 			if(!fixedSeed){
 				seed = 0;
@@ -59,7 +353,19 @@ class RandomGenerator{
 					seed = rd();
 			}
 
-			generator.seed(seed);
+			seedEngine(seed);
+		}
+
+		/*
+			Constructor:
+			Generates a generator with a fixed seed, e.g. one drawn by getRandomSeed() of
+			another generator.
+
+			@param 	e 		The engine of the generator
+			@param 	seed 	The seed of the random generator
+		*/
+		RandomGenerator(const RandomEngine e, const unsigned int seed) : engine(e){
+			seedEngine(seed);
 		}
 
 
@@ -75,7 +381,10 @@ class RandomGenerator{
 			@return 		The random index 	
 		*/
 		int getRandomIndex(int max){ 
-			return std::uniform_int_distribution<int> {0, max - 1} (generator);
+			if(engine == RandomEngine::MT19937)
+				return std::uniform_int_distribution<int> {0, max - 1} (generator);
+
+			return nextIndex(max);
 		}
 
 		/*
@@ -90,7 +399,10 @@ class RandomGenerator{
 			double trans;
 			double limit = 0.0000001;
 
-			trans = std::normal_distribution<double> {mean, stddev} (generator);	
+			if(engine == RandomEngine::MT19937)
+				trans = std::normal_distribution<double> {mean, stddev} (generator);
+			else
+				trans = mean + stddev * nextNormal();
 
 			if(trans < limit && trans > - limit){
 				if(trans > 0)
@@ -102,6 +414,77 @@ class RandomGenerator{
 			return trans;
 		}
 
+		/*
+			The function getDoubleNormalTruncated() generates a random double from a normal
+			distribution with parameters mean and stddev truncated to the interval [min, max]
+			by inverting the cumulative distribution function. So it draws exactly one random
+			number independent of the probability mass of the interval. As getDoubleNormal()
+			it avoids absolute values less than 0.0000001 if the interval allows that.
+
+			@param 	mean	The mean value of the distribution
+			@param 	stddev 	The standard deviation of the distribution
+			@param 	min 	The lower bound of the random value
+			@param 	max 	The upper bound of the random value
+			@return 		The generated random double
+
+			Note:
+				Intervals in the upper tail get mirrored to the lower tail, where the
+				cumulative distribution function is more precise
+		*/
+		double getDoubleNormalTruncated(double mean, double stddev, double min, double max){
+			double a, b, pa, pb, u, x, trans;
+			double limit = 0.0000001;
+			bool mirrored;
+
+			if(min >= max)
+				return min;
+
+			a = (min - mean) / stddev;
+			b = (max - mean) / stddev;
+
+			mirrored = a > 0;
+			if(mirrored){
+				pa = normalCDF(- b);
+				pb = normalCDF(- a);
+			}else{
+				pa = normalCDF(a);
+				pb = normalCDF(b);
+			}
+
+			// The interval is too far in the tail to be resolved
+			if(!(pa < pb)){
+				trans = mirrored ? min : max;
+			}else{
+				u = getDoubleUniform(pa, pb);
+
+				// Keep the quantile finite
+				if(u <= 0)
+					u = std::numeric_limits<double>::min();
+				if(u >= 1)
+					u = 1 - std::numeric_limits<double>::epsilon();
+
+				x = normalQuantile(u);
+				if(mirrored)
+					x = - x;
+
+				trans = mean + stddev * x;
+			}
+
+			if(trans < min)
+				trans = min;
+			if(trans > max)
+				trans = max;
+
+			if(trans < limit && trans > - limit){
+				if(trans >= 0 && limit <= max)
+					trans = limit;
+				else if(- limit >= min)
+					trans = - limit;
+			}
+
+			return trans;
+		}
+
 		/*
 			The function getDoubleUniform() generates a random double from a uniform distribution with
 			between min and max.
@@ -111,7 +494,132 @@ class RandomGenerator{
 			@return 		The generated random double
 		*/
 		double getDoubleUniform(double min, double max){
-			return std::uniform_real_distribution<double> {min, max} (generator);	
+			if(engine == RandomEngine::MT19937)
+				return std::uniform_real_distribution<double> {min, max} (generator);
+
+			return min + (max - min) * toUnit(next());
+		}
+
+		/*
+			The function fillIndices() draws size random indices in the same way as
+			getRandomIndex(), but decides on the engine once for the whole block.
+
+			@param 	out 	The array the indices get written to
+			@param 	size 	The number of indices to draw
+			@param 	max 	The number of possible indices
+		*/
+		void fillIndices(int * const out, const unsigned int size, const int max){
+			unsigned int i;
+
+			if(engine == RandomEngine::MT19937){
+				std::uniform_int_distribution<int> dist {0, max - 1};
+
+				for(i = 0; i < size; i++)
+					out[i] = dist(generator);
+			}else{
+				for(i = 0; i < size; i++)
+					out[i] = nextIndex(max);
+			}
+		}
+
+		/*
+			The function fillUniform() draws size uniformly distributed doubles between min
+			and max, deciding on the engine once for the whole block.
+
+			@param 	out 	The array the doubles get written to
+			@param 	size 	The number of doubles to draw
+			@param 	min		The lower bound of the random values
+			@param 	max 	The upper bound of the random values
+		*/
+		void fillUniform(double * const out, const unsigned int size, const double min,
+			const double max){
+			unsigned int i;
+
+			if(engine == RandomEngine::MT19937){
+				std::uniform_real_distribution<double> dist {min, max};
+
+				for(i = 0; i < size; i++)
+					out[i] = dist(generator);
+			}else{
+				for(i = 0; i < size; i++)
+					out[i] = min + (max - min) * toUnit(next());
+			}
+		}
+
+		/*
+			The function fillNormal() draws size standard normally distributed doubles,
+			deciding on the engine once for the whole block.
+
+			@param 	out 	The array the doubles get written to
+			@param 	size 	The number of doubles to draw
+
+			Note:
+				For MT19937 one distribution object serves the whole block, so it uses both
+				values of each polar draw and the sequence differs from calls of
+				getDoubleNormal()
+		*/
+		void fillNormal(double * const out, const unsigned int size){
+			unsigned int i;
+
+			if(engine == RandomEngine::MT19937){
+				std::normal_distribution<double> dist {0, 1};
+
+				for(i = 0; i < size; i++)
+					out[i] = dist(generator);
+			}else{
+				for(i = 0; i < size; i++)
+					out[i] = nextNormal();
+			}
+		}
+
+		/*
+			The function getRandomSeed() generates a seed for another random generator, so
+			random numbers can be drawn independently from the order in which multiple threads
+			use their generators.
+
+			@return 	The generated seed
+		*/
+		unsigned int getRandomSeed(){
+			unsigned int seed = 0;
+
+			if(engine == RandomEngine::MT19937)
+				return std::uniform_int_distribution<unsigned int> {1, std::numeric_limits<unsigned int>::max()} (generator);
+
+			while(seed == 0)
+				seed = next() >> 32;
+
+			return seed;
+		}
+
+		/*
+			The function split() generates a new generator with the same engine whose stream is
+			independent from the stream of this generator, e.g. for another thread. The streams
+			are reproducible for a fixed seed.
+
+			@return 	The new generator
+
+			Note:
+				- For XOSHIRO the new generator continues the stream of this generator, while
+					this generator jumps 2^128 steps ahead, so the streams never overlap
+				- For MT19937 the new generator gets seeded by getRandomSeed()
+		*/
+		RandomGenerator *split(){
+			RandomGenerator *gen;
+
+			if(engine == RandomEngine::MT19937)
+				return new RandomGenerator(engine, getRandomSeed());
+
+			gen = new RandomGenerator(*this);
+			jump();
+
+			return gen;
+		}
+
+		/*
+			@return 	The engine of the generator
+		*/
+		RandomEngine getEngine() const{
+			return engine;
 		}
 };
 
@@ -47,6 +47,7 @@ template<class T> class STEntry;
 	unordered binary tree containing all edges. The binary tree stays balanced
 	by containing the number of elements in each subtree. Removing one object of
 	the tree leads to an empty node which is filled with the next object inserted.
+	Objects with weight 0 never get selected, also if the tree is unweighted.
 */
 template<class T> class SelectionTree{
 
@@ -132,16 +133,16 @@ public:
 		uniformly at random weighted by the objects' weights if weighted is enabled.
 		Otherwise it selects uniformly at random without weights.
 
-		@return 	The randomly selected object
+		@return 	The randomly selected object, NULL if no object has a positive weight
 
 		Note:
-			- If the tree is unweighted, all weights are simply set to one. Thus,
+			- If the tree is unweighted, all positive weights are simply set to one. Thus,
 				the same function can be used to select an element randomly
 	*/
 	T getRandomObject(){
 		STEntry<T> *entry, *last;
 
-		if(root == NULL)
+		if(root == NULL || (*root).getTotalWeight() == 0)
 			return NULL;
 
 		last = NULL;
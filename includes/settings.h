@@ -23,8 +23,13 @@
 #include <iostream>
 
 #include "timer.h"
+#include "profiler.h"
+#include "tracer.h"
 #include "randomGenerator.h"
+#include "proposalBuffer.h"
 #include "predicates.h"
+#include "acceptanceController.h"
+#include "vertexScheduler.h"
 
 #ifndef __SETTINGS_H_
 #define __SETTINGS_H_
@@ -32,7 +37,11 @@
 enum class FeedbackMode {MUTE, DEFAULT, VERBOSE};
 enum class Arithmetics {EXACT, DOUBLE};
 
-enum class OutputFormat {DAT, LINE, GRAPHML};
+enum class OutputFormat {DAT, LINE, GRAPHML, BIN};
+
+enum class StartShape {REGULAR, STAR};
+
+enum class ParallelMode {PARTITION, INDEPENDENTSET, SPECULATIVE};
 
 class Settings{
 
@@ -67,6 +76,9 @@ public:
 	// Size of the initial polygon
 	static unsigned int initialSize;
 
+	// Shape of the initial polygon (if it is not read from a file)
+	static StartShape startShape;
+
 	// Radius of the initial outer polygon
 	static double radiusPolygon;
 
@@ -79,9 +91,21 @@ public:
 	// Average number of translations per vertex of the initial polygon
 	static unsigned int initialTranslationFactor;
 
+	// Indicates whether the factor has been given, otherwise a polygon read from a file
+	// gets no translations
+	static bool fixedInitialFactor;
+
 	// Number of translations to perform on the initial polygon
 	static int initialTranslationNumber;
 
+	// Filename of a polygon file the generation starts from instead of the regular polygon
+	// (NULL starts from the regular polygon)
+	static char *inputFile;
+
+	// The rings read from the input file until the initial triangulation is built, the
+	// first one is the outer polygon
+	static std::vector<std::vector<point>> inputRings;
+
 
 	/*
 		Translation parameters
@@ -90,6 +114,9 @@ public:
 	// Type of translation used
 	static bool kinetic;
 
+	// Choose the type of translation per translation by its predicted costs
+	static bool hybrid;
+
 	// Type of used arithmetics
 	static Arithmetics arithmetics;
 
@@ -109,6 +136,25 @@ public:
 	// used as standard deviation of the distribution is divided by this number
 	static int stddevDiv;
 
+	// Flag for truncating the translation distances to the free distance of the moving
+	// vertex in the direction of the translation
+	static bool boundedDistance;
+
+	// Acceptance rate the distances of the translation phases get adjusted to
+	// (0 disables the adjustment)
+	static double targetAcceptance;
+
+	// Maximum factor by which the adjustment may scale the distances up or down
+	static double maxBias;
+
+	// Flag for moving the entities of the triangulation into a cache friendly order
+	// whenever the polygon has doubled its size
+	static bool relayout;
+
+	// Number of vertices of the spatially coherent blocks the vertices of the sequential
+	// translation phases get selected in (0 selects each vertex independently)
+	static unsigned int localBlockSize;
+
 	// Enable local correctness checking after aborted translations
 	static bool localChecking;
 
@@ -118,6 +164,16 @@ public:
 	// Number of additional translations after the growth
 	static unsigned int additionalTrans;
 
+	// Number of threads used for translations (1 disables the parallel translation phase)
+	static unsigned int threads;
+
+	// Number of cells per side of the grid partitioning the polygon during the parallel
+	// translation phase
+	static unsigned int cellsPerSide;
+
+	// Scheme for selecting the translations which are executed concurrently
+	static ParallelMode parallelMode;
+
 
 	/*
 		Insertion parameters
@@ -132,6 +188,13 @@ public:
 	// Flag for weighted edge selection
 	static bool weightedEdgeSelection;
 
+	// Flag for growing the polygon in rounds of independent insertions
+	static bool bulkGrowth;
+
+	// Flag for placing inserted vertices directly at a random position instead of
+	// translating them away from the middle of the edge
+	static bool directInsertion;
+
 
 	/*
 		Utilities
@@ -140,6 +203,12 @@ public:
 	// Global Timer
 	static Timer *timer;
 
+	// Controller of the translation distances (NULL if no target acceptance rate is given)
+	static AcceptanceController *controller;
+
+	// Scheduler of the vertices to translate (NULL if no local block size is given)
+	static VertexScheduler *scheduler;
+
 
 	/*
 		Random Generator
@@ -151,9 +220,19 @@ public:
 	// The fixed seed for the RandomGenerator (if enabled)
 	static unsigned int seed;
 
+	// The engine of the RandomGenerator
+	static RandomEngine randomEngine;
+
 	// Global RandomGenerator
 	static RandomGenerator *generator;
 
+	// Flag for drawing the random values of the proposed translations in blocks
+	static bool batchedProposals;
+
+	// Buffer of the proposed translations drawn from the global RandomGenerator (NULL if
+	// batched proposals are disabled)
+	static ProposalBuffer *proposals;
+
 
 	/*
 		Feedback settings
@@ -180,6 +259,19 @@ public:
 	// Filename for statistics file
 	static char *statisticsFile;
 
+	// Filename for the JSON report of the profiler (NULL disables the profiler)
+	static char *profileFile;
+
+	// Filename for the trace of the generation stages (NULL disables the tracing)
+	static char *traceFile;
+
+	// Filename for the recorded log of all proposals (NULL disables the recording)
+	static char *recordFile;
+
+	// Filename of a log whose proposals get replayed instead of drawing them (NULL
+	// disables the replay)
+	static char *replayFile;
+
 
 	/*
 		Checking
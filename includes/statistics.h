@@ -38,6 +38,127 @@ using boost::property_tree::write_xml;
 using boost::property_tree::xml_writer_settings;
 using boost::property_tree::xml_writer_make_settings;
 
+/*
+	The reasons for rejecting a translation or an insertion:
+	ORIENTATION: 	The translation would change the orientation of a polygon
+	VERTEXHIT: 		A new polygon edge would hit a vertex
+	POLYGONHIT: 	A new polygon edge would intersect another polygon edge
+	FRAMEHIT: 		A new polygon edge would intersect an edge of the bounding box
+	NUMERICAL: 		A new polygon edge seems to intersect multiple edges of one triangle,
+					i.e. a numerical problem
+	UNSTABLE: 		The event queue of the kinetic translation is unstable from the start
+	UNDONE: 		The kinetic translation has been undone as an event could not be
+					processed
+	ABORTED: 		The translation by retriangulation has been aborted
+	STABILITY: 		The edge chosen for an insertion does not fulfill the stability criteria
+*/
+enum class Rejection : unsigned int {ORIENTATION, VERTEXHIT, POLYGONHIT, FRAMEHIT, NUMERICAL,
+	UNSTABLE, UNDONE, ABORTED, STABILITY};
+
+/*
+	The number of rejection reasons
+*/
+const unsigned int nrRejections = 9;
+
+/*
+	The translation engines, i.e. the kinetic translations and the translations by
+	retriangulation
+*/
+enum class Engine : unsigned int {KINETIC, RETRIANGULATION};
+
+/*
+	The number of translation engines
+*/
+const unsigned int nrEngines = 2;
+
+/*
+	The distributions recorded per translation engine:
+	TIME: 			The wall time of a translation from its construction to its destruction
+					(in nanoseconds)
+	TRIANGLES: 		The number of triangles passed by the calls of checkEdge() of a translation
+	FLIPS: 			The number of flips performed by a kinetic translation
+	POLYGONSIZE: 	The number of vertices of a polygon retriangulated by a translation by
+					retriangulation
+*/
+enum class Distribution : unsigned int {TIME, TRIANGLES, FLIPS, POLYGONSIZE};
+
+/*
+	The number of recorded distributions per translation engine
+*/
+const unsigned int nrDistributions = 4;
+
+/*
+	The number of buckets per power of two of the histograms and the total number of buckets,
+	larger values get counted in the last bucket
+*/
+const unsigned int histogramSubBuckets = 4;
+const unsigned int histogramBuckets = 48 * histogramSubBuckets;
+
+/*
+	A histogram with logarithmically sized buckets, i.e. the buckets of each power of two are
+	split into histogramSubBuckets buckets of the same size. So the relative error of each
+	bucket is bounded independently of the magnitude of the values.
+*/
+struct LogHistogram{
+	// The number, the sum and the maximum of the recorded values
+	unsigned long long count;
+	unsigned long long sum;
+	unsigned long long max;
+
+	// The number of values per bucket
+	unsigned long long buckets[histogramBuckets];
+
+	/*
+		The function add() records a value.
+
+		@param 	value 	The value
+	*/
+	void add(const unsigned long long value);
+
+	/*
+		The function merge() adds the values of another histogram.
+
+		@param 	h 	The other histogram
+	*/
+	void merge(const LogHistogram &h);
+
+	/*
+		@param 	i 	The index of a bucket
+		@return 	The smallest value of the bucket
+	*/
+	static unsigned long long getBucketLow(const unsigned int i);
+
+	/*
+		@param 	p 	The percentile in [0, 1]
+		@return 	The smallest value of the bucket containing the percentile, 0 if there are
+					no values
+	*/
+	unsigned long long getPercentile(const double p) const;
+};
+
+/*
+	The translation counters of one thread. Worker threads of the parallel translation phase
+	collect their counters in this struct such that the main thread can merge them.
+*/
+struct StatisticsCounters{
+	unsigned long long translationTries;
+	unsigned long long translationsPerf;
+	unsigned long long splits;
+	unsigned int undone;
+	unsigned long long nrChecks;
+	unsigned long long nrSPTriangles;
+	unsigned int maxSPTriangles;
+	unsigned long long nrTriangles;
+	unsigned int maxTriangles;
+	unsigned long long rejections[nrRejections];
+	double rejectionTime[nrRejections];
+	unsigned long long flips;
+	unsigned long long retriangulated;
+	LogHistogram histograms[nrEngines][nrDistributions];
+	unsigned long long engineMoves[nrEngines];
+	double engineTime[nrEngines];
+};
+
 class Statistics{
 
 private:
@@ -49,55 +170,207 @@ private:
 	static double maxTwist;
 	static unsigned int twistNumber;
 	static unsigned int directionChanges;
+
+	// The shape of the start polygon and the time it was ready at
+	static double startMaxTwist;
+	static unsigned int startDirectionChanges;
+	static double startTime;
 	
 
 public:
 
+	/*
+		Note:
+			The translation counters are thread local, as they are incremented by the workers
+			of the parallel translation phase. The counters of the workers get merged into
+			the counters of the main thread by addCounters().
+	*/
+
 	/*
 		Total number of translation which have been checked
 	*/
-	static unsigned long long translationTries;
+	static thread_local unsigned long long translationTries;
 
 	/*
 		Number of translations which have been performed at least partially
 	*/
-	static unsigned long long translationsPerf;
+	static thread_local unsigned long long translationsPerf;
 
 	/*
 		Number of split translations
 	*/
-	static unsigned long long splits;
+	static thread_local unsigned long long splits;
 
 	/*
 		Number of translation which had to be undone due to errors in the
 		triangulation found by the local checking
 	*/
-	static unsigned int undone;
+	static thread_local unsigned int undone;
 
 	/*
 		Counts how often checkEdge() gets called	
 	*/
-	static unsigned long long nrChecks;
+	static thread_local unsigned long long nrChecks;
 
 	/*
 		Counts the number of triangles of the SP in all calls of checkEdge()
 	*/
-	static unsigned long long nrSPTriangles;
+	static thread_local unsigned long long nrSPTriangles;
 
 	/*
 		The maximum number of triangles of an SP in checkEdge()
 	*/
-	static unsigned int maxSPTriangles;
+	static thread_local unsigned int maxSPTriangles;
 
 	/*
 		Number of passed triangles in all calls of checkEdge()
 	*/
-	static unsigned long long nrTriangles;
+	static thread_local unsigned long long nrTriangles;
 
 	/*
 		Maximum number of passed triangles in any call of checkEdge()
 	*/
-	static unsigned int maxTriangles;
+	static thread_local unsigned int maxTriangles;
+
+	/*
+		Number of rejected translations and insertions per reason of the rejection and the
+		time spent on them from their construction to their rejection (in seconds)
+	*/
+	static thread_local unsigned long long rejections[nrRejections];
+	static thread_local double rejectionTime[nrRejections];
+
+	/*
+		Number of flips performed by kinetic translations
+	*/
+	static thread_local unsigned long long flips;
+
+	/*
+		Number of vertices of the polygons retriangulated by translations by retriangulation
+	*/
+	static thread_local unsigned long long retriangulated;
+
+	/*
+		The distributions of the costs of the translations per translation engine
+	*/
+	static thread_local LogHistogram histograms[nrEngines][nrDistributions];
+
+	/*
+		Number of translations executed per translation engine and the time spent on their
+		execution (in seconds)
+	*/
+	static thread_local unsigned long long engineMoves[nrEngines];
+	static thread_local double engineTime[nrEngines];
+
+	/*
+		Number of rounds of the parallel translation phase
+	*/
+	static unsigned long long parallelRounds;
+
+	/*
+		Number of translations which have been processed by the workers of the parallel
+		translation phase
+	*/
+	static unsigned long long parallelTranslations;
+
+	/*
+		Number of translations which have been deferred to the sequential pass of the
+		parallel translation phase as their region was not contained in one cell
+	*/
+	static unsigned long long deferredTranslations;
+
+	/*
+		Maximum number of translations processed by the workers in one parallel round
+	*/
+	static unsigned long long maxParallelTranslations;
+
+	/*
+		CPU time of all threads and wall-clock time of the parallel rounds including their
+		sequential parts (in seconds). The speedup follows by comparing the wall-clock time
+		with a run using one thread.
+	*/
+	static double parallelCpuTime;
+	static double parallelWallTime;
+
+	/*
+		Number of moves tried and performed by the translation phases, i.e. by
+		transformPolygonByMoves(), and the time spent in them (in seconds)
+	*/
+	static unsigned long long phaseTries;
+	static unsigned long long phaseTranslations;
+	static double phaseTime;
+
+	/*
+		Number of relayouts of the triangulation and the time spent in them (in seconds)
+	*/
+	static unsigned int relayouts;
+	static double relayoutTime;
+
+
+	/*
+		The function collectCounters() returns the translation counters of the calling thread.
+
+		@return 	The translation counters of the calling thread
+	*/
+	static StatisticsCounters collectCounters();
+
+	/*
+		The function addCounters() merges translation counters of another thread into the
+		counters of the calling thread.
+
+		@param 	c 	The translation counters of the other thread
+	*/
+	static void addCounters(const StatisticsCounters &c);
+
+	/*
+		The function resetCounters() sets the translation counters of the calling thread
+		to zero.
+	*/
+	static void resetCounters();
+
+	/*
+		The function addRejection() counts a rejection of the calling thread.
+
+		@param 	r 		The reason of the rejection
+		@param 	time 	The time spent on the rejected translation or insertion (in seconds)
+	*/
+	static void addRejection(const Rejection r, const double time);
+
+	/*
+		@param 	r 	A reason of a rejection
+		@return 	The name of the reason in the statistics
+	*/
+	static const char *getRejectionName(const Rejection r);
+
+	/*
+		The function addToHistogram() records a value of a distribution of a translation
+		engine.
+
+		@param 	e 		The translation engine
+		@param 	d 		The distribution
+		@param 	value 	The value
+	*/
+	static void addToHistogram(const Engine e, const Distribution d, const unsigned long long value);
+
+	/*
+		The function addEngineMove() counts a translation of the calling thread which has
+		been executed by the translation engine e.
+
+		@param 	e 		The translation engine
+		@param 	time 	The time spent on the execution (in seconds)
+	*/
+	static void addEngineMove(const Engine e, const double time);
+
+	/*
+		@param 	e 	A translation engine
+		@return 	The name of the engine in the statistics
+	*/
+	static const char *getEngineName(const Engine e);
+
+	/*
+		@param 	d 	A distribution
+		@return 	The name of the distribution in the statistics
+	*/
+	static const char *getDistributionName(const Distribution d);
 
 
 	/*
@@ -130,6 +403,15 @@ public:
 
 	static void calculateTwistNumber(Triangulation const * const T);
 
+	/*
+		Calculates the max twist and the number of direction changes of the start polygon
+		and keeps them together with the elapsed time, such that the quality of the start
+		polygon can be compared to the one of the final polygon.
+
+		@param 	T 	The triangulation the start polygon lives in
+	*/
+	static void calculateStartShape(Triangulation const * const T);
+
 	/*
 		Prints the calculated statistics to stderr. 
 
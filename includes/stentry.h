@@ -94,7 +94,8 @@ public:
 	/*
 		Constructor:
 		Sets the parent entry in the SelectionTree and the weight of its
-		object. In case the tree is unweighted, all weights get the value 1.
+		object. In case the tree is unweighted, all objects with a positive weight
+		get the weight 1.
 
 		@param 	e 	The object this STEntry represents
 		@param 	prt	The parent entry in the SelectionTree
@@ -107,7 +108,7 @@ public:
 		if((*tree).isWeighted())
 			elementWeight = (*element).getWeight();
 		else
-			elementWeight = 1;
+			elementWeight = (*element).getWeight() > 0 ? 1 : 0;
 		
 		totalWeight = elementWeight;
 
@@ -124,7 +125,7 @@ public:
 		The function addChild() adds a new child entry to this STEntry. The new
 		child gets added left if there is no child already, otherwise it gets
 		added right. Afterwards the number of elements and the total weights is
-		updated for all ancestors.
+		refreshed for all ancestors.
 
 		@param 	child 	The new child entry
 
@@ -148,7 +149,7 @@ public:
 		totalWeight = elementWeight + leftWeight + rightWeight;
 
 		if(parent != NULL)
-			(*parent).update();
+			(*parent).refresh();
 	}
 
 	/*
@@ -167,6 +168,15 @@ public:
 		update();
 	}
 
+	/*
+		Replace the object of the entry by an object with the same weight, e.g. by a copy
+		of the object at another memory location. The weights do not get updated.
+	*/
+	void replaceObject(T e){
+		element = e;
+		(*e).setSTEntry(this);
+	}
+
 
 	/*
 		R ~ E ~ M ~ O ~ V ~ E ~ R
@@ -182,23 +192,23 @@ public:
 		totalWeight = leftWeight + rightWeight;
 
 		if(parent != NULL)
-			(*parent).update();
+			(*parent).refresh();
 
 		(*tree).emptyNodes.push(this);
 	}
 
 	/*
-		Removes a child entry from an entry and calls update().
+		Removes a child entry from an entry and calls refresh().
 
 		@param 	child 	The child entry to remove
 	*/
-	void removeChild(STEntry<T> child){
+	void removeChild(STEntry<T> *child){
 		if(leftChild == child)
 			leftChild = NULL;
 		if(rightChild == child)
 			rightChild = NULL;
 
-		update();
+		refresh();
 	}
 
 
@@ -265,18 +275,54 @@ public:
 	*/
 
 	/*
-		The function update() updates the weights and the numbers of elements of
-		this entry and calls update() for the parent entry. In case the tree is
-		unweighted, the element gets the weight 1.
+		The function update() recomputes the weight of the element of this entry and
+		calls refresh() to update the totals of this entry and all its ancestors. In
+		case the tree is unweighted, the element gets the weight 1 if its weight is
+		positive.
 	*/
 	void update(){
+		elementWeight = computeElementWeight();
+
+		refresh();
+	}
+
+	/*
+		The function computeElementWeight() computes the weight of the element of this
+		entry as update() stores it.
+
+		@return 	The weight of the element, 0 for an empty entry
+	*/
+	double computeElementWeight(){
 
 		if(element == NULL)
-			elementWeight = 0;
+			return 0;
 		else if((*tree).isWeighted())
-			elementWeight = (*element).getWeight();
+			return (*element).getWeight();
 		else
-			elementWeight = 1;
+			return (*element).getWeight() > 0 ? 1 : 0;
+	}
+
+	/*
+		The function isUpToDate() checks whether the stored weight of the element still
+		equals its actual weight, i.e. whether update() has been called since the last
+		change of the element.
+
+		@return 	True if the stored weight is up to date, otherwise false
+	*/
+	bool isUpToDate(){
+		return elementWeight == computeElementWeight();
+	}
+
+	/*
+		The function refresh() updates the total weight and the numbers of elements of
+		this entry from the cached totals of its children and calls refresh() for the
+		parent entry.
+
+		Note:
+			The weight of the element itself is not recomputed, so the objects of the
+			ancestors do not get accessed. It only changes by update().
+	*/
+	void refresh(){
 
 		if(leftChild != NULL){
 			leftWeight = (*leftChild).getTotalWeight();
@@ -292,7 +338,7 @@ public:
 		nrElementsTotal = nrElementsLeft + nrElementsRight + 1;
 
 		if(parent != NULL)
-			(*parent).update();
+			(*parent).refresh();
 	}
 
 	/*
@@ -0,0 +1,59 @@
+/*
+ * Copyright 2021 Philipp Mayer - pmayer@cs.sbg.ac.at
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+/*
+	Include standard libraries
+*/
+#include <vector>
+#include <set>
+#include <algorithm>
+#include <math.h>
+
+/*
+	Include my headers
+*/
+#include "predicates.h"
+#include "settings.h"
+
+#ifndef __SWEEPTRIANGULATION_H_
+#define __SWEEPTRIANGULATION_H_
+
+/*
+	The function triangulateDomain() triangulates a polygonal domain, i.e. a polygon with
+	holes, in O(n log n) time. It splits the domain into y-monotone polygons by a plane
+	sweep and triangulates each of them in linear time (see de Berg et al., Computational
+	Geometry, chapter 3).
+
+	@param 	points 		The coordinates of all vertices
+	@param 	rings 		The rings of the domain as lists of indices into points, the first
+						one is the boundary in counterclockwise order, the others are the
+						holes in clockwise order, i.e. the domain is always to the left
+	@param 	triangles 	The indices of the vertices of the triangles get appended to it,
+						three per triangle in counterclockwise order
+	@return 			False if the sweep found the rings to be no valid domain, e.g. as
+						they intersect, otherwise true
+
+	Note:
+		- The rings must be simple, disjoint and the holes must lie inside the boundary,
+			violations are just detected if they break the sweep
+		- The orientations are computed with the arithmetic given by Settings::arithmetics
+*/
+bool triangulateDomain(std::vector<point> const &points, std::vector<std::vector<int>> const &rings,
+	std::vector<int> &triangles);
+
+#endif
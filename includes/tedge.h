@@ -21,6 +21,8 @@
 */
 #include <stdio.h>
 #include <string>
+#include <atomic>
+#include <vector>
 #ifndef _USE_MATH_DEFINES
 #define _USE_MATH_DEFINES
 #include <math.h>
@@ -31,6 +33,7 @@
 	Include my headers	
 */
 #include "settings.h"
+#include "arena.h"
 
 
 /*
@@ -85,8 +88,8 @@ private:
 	/*
 		The two vertices defining the edge
 	*/
-	Vertex * const v0;
-	Vertex * const v1;
+	Vertex *v0;
+	Vertex *v1;
 
 	/*
 		The two triangles which contain the edge
@@ -114,10 +117,46 @@ private:
 	*/
 	const unsigned long long id;
 
+	/*
+		The copy of the edge generated by the running relayout of the triangulation
+	*/
+	TEdge *relocated;
+
 	/*
 		The number of already generated edges
 	*/
-	static unsigned long long n;
+	static std::atomic<unsigned long long> n;
+
+	/*
+		A flag whether the updates of the SelectionTree entries get deferred, it is only
+		changed while no worker thread is running
+	*/
+	static bool stUpdatesDeferred;
+
+	/*
+		The SelectionTree entries the calling thread has updated while the updates are
+		deferred
+	*/
+	static thread_local std::vector<STEntry<TEdge*>*> deferredSTUpdates;
+
+	/*
+		Constructor:
+		Generates a copy of the edge e for the relayout of the triangulation. The copy
+		connects the copies of the vertices of e and takes over the ID, the type, the
+		triangulation and the SelectionTree entry of e, whereas e gets unregistered from the
+		triangulation and the SelectionTree.
+
+		@param 	e 	The edge to be copied
+	*/
+	TEdge(TEdge * const e);
+
+	/*
+		The function replaceTriangle() replaces a triangle of the edge by another one.
+
+		@param 	oldT 	The triangle to be replaced
+		@param 	newT 	The new triangle
+	*/
+	void replaceTriangle(Triangle * const oldT, Triangle * const newT);
 
 public:
 
@@ -137,6 +176,18 @@ public:
 			return false;
 	}
 
+	/*
+		Edges reuse the slots of deleted entities of the same size in the arena of the
+		last relayout, slots in the arena must not be freed individually
+	*/
+	static void *operator new(size_t n){
+		return Arena::acquire(n);
+	}
+
+	static void operator delete(void *p, size_t n){
+		Arena::release(p, n);
+	}
+
 	/*
 		LIST OF PUBLIC MEMBER FUNCTIONS
 
@@ -168,6 +219,7 @@ public:
 		STentry<TEdge*> 	getSTEntry() const
 		double 				getWeight() const
 		bool 				isIntersected() const
+		TEdge* 				getRelocated() const
 
 		REMOVER:
 
@@ -186,6 +238,13 @@ public:
 		double 				getAngle(Vertex const * const v) const
 		bool 				isBetween(Vertex const * const v) const
 		void 				updateSTEntry() const
+		bool 				isSuitableForInsertion() const
+		void 				flip(Triangle * const t)
+		TEdge* 				relocate(Arena * const a)
+		void 				relocateReferences()
+		static void 		deferSTUpdates(const bool defer)
+		static void 		takeDeferredSTUpdates(std::vector<STEntry<TEdge*>*> &updates)
+		static void 		applySTUpdates(std::vector<STEntry<TEdge*>*> const &updates)
 	*/
 
 
@@ -245,7 +304,8 @@ public:
 		edge. The new triangle is set at t0 if t0 is NULL, otherwise it is set at t1 if
 		t1 is NULL, otherwise the function errors with exit code 4 if the edge has already
 		registered two triangles. The function errors with exit code 5 if the edge has already
-		registered the same triangle.
+		registered the same triangle. As the weight of a polygon edge depends on its
+		triangles, its STEntry gets updated as soon as both triangles are registered.
 
 		@param 	t 	The new triangle
 	*/
@@ -339,9 +399,14 @@ public:
 	STEntry<TEdge*> *getSTEntry() const;
 
 	/*
-		Computes the weight for the SelectionTree which is the length of the edge.
+		Computes the weight for the SelectionTree which is the length of the edge. Edges which
+		are not suitable for insertions get the weight 0, so they never get selected.
 
-		@return 	The length of the edge
+		@return 	The length of the edge if it is suitable for insertions, otherwise 0
+
+		Note:
+			The weight depends on the triangles of the edge, so it just gets computed by the
+			thread changing them respectively by the main thread after a parallel round
 	*/
 	double getWeight() const;
 
@@ -350,6 +415,12 @@ public:
 	*/
 	bool isIntersected() const;
 
+	/*
+		@return 	The copy of the edge generated by the running relayout, NULL if the edge
+					has not been relocated
+	*/
+	TEdge *getRelocated() const;
+
 
 	/*
 		R ~ E ~ M ~ O ~ V ~ E ~ R
@@ -431,10 +502,88 @@ public:
 
 	/*
 		Updates the length in the STEntry of the edge which also updates the entries of
-		all ancestors in the SelectionTree
+		all ancestors in the SelectionTree. While the updates are deferred, the entry just
+		gets recorded for the calling thread.
 	*/
 	void updateSTEntry() const;
 
+	/*
+		The function isSuitableForInsertion() checks whether a vertex can be inserted into the
+		edge without risking numerical problems. Therefore the edge must have two triangles and
+		at least the length Settings::minLength and, in case we use the double arithmetics,
+		both triangles' determinants must be at least Settings::minDetInsertion.
+
+		@return 	True if the edge fulfills the criteria, otherwise false
+	*/
+	bool isSuitableForInsertion() const;
+
+	/*
+		The function relocate() places a copy of the edge in an arena during a relayout of
+		the triangulation. The copy connects the copies of the vertices of the edge and takes
+		over its ID, type, triangulation and SelectionTree entry.
+
+		@param 	a 	The arena of the relayout
+		@return 	The copy of the edge
+
+		Note:
+			- Both vertices of the edge must already be relocated
+			- The copy does not register itself at its vertices, this is done by
+				Vertex::relocateReferences()
+	*/
+	TEdge *relocate(Arena * const a);
+
+	/*
+		The function flip() replaces the edge by the other diagonal of the quadrilateral formed
+		by its two triangles. The edge and both triangles are reused and just get rewired at
+		their vertices and edges, so they keep their IDs and SelectionTree entries. Afterwards
+		t is the triangle containing the former vertex v0 of the edge and the other triangle
+		is the one containing the former vertex v1.
+
+		@param 	t 	One of the triangles of the edge
+
+		Note:
+			- The edge must be a triangulation edge with two triangles forming a convex
+				quadrilateral
+			- Flipping the edge again restores the state before the flip
+			- The SelectionTree entries of the triangles and of the polygon edges of the
+				quadrilateral get updated, as their weights depend on the triangles
+	*/
+	void flip(Triangle * const t);
+
+	/*
+		The function relocateReferences() sets the triangles of the copy of the edge to the
+		copies of its own triangles.
+	*/
+	void relocateReferences();
+
+	/*
+		The function deferSTUpdates() starts respectively stops deferring the updates of the
+		SelectionTree entries of all edges. It must only be called while no worker thread is
+		running.
+
+		@param 	defer 	True if the updates get deferred from now on, false otherwise
+	*/
+	static void deferSTUpdates(const bool defer);
+
+	/*
+		The function takeDeferredSTUpdates() hands the entries the calling thread has
+		recorded while the updates were deferred over to the caller.
+
+		@param 	updates 	The vector the recorded entries get appended to
+	*/
+	static void takeDeferredSTUpdates(std::vector<STEntry<TEdge*>*> &updates);
+
+	/*
+		The function applySTUpdates() updates the given SelectionTree entries in the given
+		order.
+
+		@param 	updates 	The entries to update
+
+		Note:
+			Each entry recomputes the weight of its edge, so its edge must still exist
+	*/
+	static void applySTUpdates(std::vector<STEntry<TEdge*>*> const &updates);
+
 
 	/*
 		D ~ E ~ S ~ T ~ R ~ U ~ C ~ T ~ O ~ R
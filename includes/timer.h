@@ -20,6 +20,7 @@
    Include standard libraries
 */
 #include <sys/time.h>
+#include <time.h>
 #include <stdio.h>
 
 #ifndef __TIMER_H_
@@ -79,4 +80,36 @@ class Timer{
 
 };
 
+/*
+   A class for measuring the CPU time all threads of the process spent
+*/
+class CpuTimer{
+	private:
+
+      /*
+         The CPU time of the process at the start of the measurement
+      */
+      struct timespec startTime;
+
+   public:
+
+      /*
+         Starts a measurement by setting the startTime to the recent CPU time
+      */
+      void start(){
+         clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &startTime);
+      }
+
+      /*
+         @return  The CPU time the process spent since calling start() in seconds
+      */
+      double elapsedTime(){
+         struct timespec now;
+
+         clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &now);
+
+         return (double)(now.tv_sec - startTime.tv_sec) + (double)(now.tv_nsec - startTime.tv_nsec) / 1e9;
+      }
+};
+
 #endif
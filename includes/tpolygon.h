@@ -22,6 +22,8 @@
 #include <vector>
 #include <ostream>
 #include <cassert>
+#include <stdio.h>
+#include <stdint.h>
 
 
 /*
@@ -59,7 +61,8 @@ private:
 	std::vector<Vertex*> vertices;
 
 	/*
-		A binary tree containing all edges of the polygon for weighted random selection
+		A binary tree containing all edges of the polygon for random selection, it is just
+		weighted if weighted edge selection is enabled
 	*/
 	SelectionTree<TEdge*> *tree;
 
@@ -70,11 +73,6 @@ private:
 	*/
 	const unsigned int id;
 
-	/*
-		The number of already generated polygons
-	*/
-	static unsigned int N;
-
 public:
 
 	/*
@@ -82,7 +80,7 @@ public:
 
 		CONSTRUCTORS:
 
-						TPolygon(Triangulation const * const t, const in n)
+						TPolygon(Triangulation const * const t, const unsigned int i, const int n)
 
 		SETTERS:
 
@@ -103,7 +101,9 @@ public:
 		OTHERS
 
 		void 			writeToLine(std:ostream& os) const
+		void 			writeToBinary(FILE *f) const
 		void 			checkST() const
+		void 			relocateVertices()
 
 	*/
 
@@ -117,9 +117,10 @@ public:
 		Already allocates memory for all vertices which will be inserted in the future.
 
 		@param 	t 	The triangulation the new polygon lives in
+		@param 	i 	The ID of the new polygon in its triangulation
 		@param 	n 	The target number of vertices of the new polygon
 	*/
-	TPolygon(Triangulation const * const t, const int n);
+	TPolygon(Triangulation const * const t, const unsigned int i, const int n);
 
 
 	/*
@@ -166,7 +167,9 @@ public:
 	int getActualPolygonSize() const;
 
 	/*
-		@return 	Any edge of the polygon selected uniformly at random by its length
+		@return 	Any edge of the polygon suitable for insertions selected uniformly at random,
+					weighted by its length if weighted edge selection is enabled, NULL if there
+					is no such edge
 	*/
 	TEdge *getRandomEdgeWeighted() const;
 
@@ -193,10 +196,25 @@ public:
 	*/
 	void writeToLine(std::ostream& os) const;
 
+	/*
+		Write this polygon to f in binary format, i.e. its number of vertices followed by
+		their coordinates.
+
+		@param  f       Output file
+	*/
+	void writeToBinary(FILE *f) const;
+
 	/*
 		Checks the correctness of the SelectionTree
 	*/
 	void checkST() const;
+
+	/*
+		The function relocateVertices() replaces all vertices of the polygon by their copies
+		generated by a relayout of the triangulation. The order of the vertices stays the
+		same.
+	*/
+	void relocateVertices();
 };
 
 #endif
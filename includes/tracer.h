@@ -0,0 +1,241 @@
+/*
+ * Copyright 2021 Philipp Mayer - pmayer@cs.sbg.ac.at
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+/*
+	Include standard libraries
+*/
+#include <stdio.h>
+#include <chrono>
+#include <mutex>
+#include <atomic>
+#include <vector>
+#include <utility>
+
+#ifndef __TRACER_H_
+#define __TRACER_H_
+
+/*
+	One event of the trace.
+*/
+struct TraceEvent{
+	// The phase of the event in the trace event format, 'X' for spans and 'C' for counters
+	char phase;
+
+	// The name and the category of the event
+	const char *name;
+	const char *category;
+
+	// The start time and the duration of the event (in microseconds)
+	double ts;
+	double dur;
+
+	// The thread which recorded the event
+	unsigned int tid;
+
+	// The arguments of a span or the values of a counter
+	std::vector<std::pair<const char*, double>> args;
+};
+
+/*
+	A recorder for the stages of the generation. The spans and counters get collected in
+	memory and written in the Chrome trace event format at the end of the run, such that
+	the run can be inspected in a trace viewer like chrome://tracing or Perfetto.
+*/
+class Tracer{
+
+private:
+
+	/*
+		The mutex protecting the events
+	*/
+	static std::mutex lock;
+
+	/*
+		All recorded events
+	*/
+	static std::vector<TraceEvent> events;
+
+	/*
+		The time the trace starts at
+	*/
+	static std::chrono::steady_clock::time_point start;
+
+	/*
+		The number of threads which have recorded events so far
+	*/
+	static std::atomic<unsigned int> nrThreads;
+
+	/*
+		The ID of the calling thread in the trace (0 if not assigned yet)
+	*/
+	static thread_local unsigned int tid;
+
+	/*
+		The number of translations of the calling thread, for sampling them
+	*/
+	static thread_local unsigned long long translations;
+
+
+public:
+
+	/*
+		The flag for enabling the recording
+	*/
+	static bool enabled;
+
+	/*
+		Every translationSampling-th translation of a thread gets its own span
+	*/
+	static const unsigned int translationSampling = 1000;
+
+
+	/*
+		LIST OF PUBLIC MEMBER FUNCTIONS
+
+		OTHERS:
+
+		static void 		begin()
+		static double 		now()
+		static unsigned int getThreadID()
+		static void 		add(TraceEvent &e)
+		static void 		counter(const char *name, std::vector<std::pair<const char*, double>> values)
+		static bool 		sampleTranslation()
+		static void 		write(const char *filename)
+	*/
+
+
+	/*
+		O ~ T ~ H ~ E ~ R ~ S
+	*/
+
+	/*
+		The function begin() enables the recording and sets the start time of the trace.
+	*/
+	static void begin();
+
+	/*
+		@return 	The time since the start of the trace (in microseconds)
+	*/
+	static double now();
+
+	/*
+		@return 	The ID of the calling thread in the trace
+	*/
+	static unsigned int getThreadID();
+
+	/*
+		The function add() adds an event to the trace.
+
+		@param 	e 	The event
+	*/
+	static void add(TraceEvent &e);
+
+	/*
+		The function counter() adds counter values at the actual time to the trace.
+
+		@param 	name 	The name of the counter track
+		@param 	values 	The names and values of the counters
+	*/
+	static void counter(const char *name, std::vector<std::pair<const char*, double>> values);
+
+	/*
+		The function sampleTranslation() counts a translation of the calling thread and
+		decides whether it gets its own span.
+
+		@return 	True if the translation should be traced, otherwise false
+	*/
+	static bool sampleTranslation();
+
+	/*
+		The function write() writes all recorded events in the Chrome trace event format
+		into a JSON file.
+
+		@param 	filename 	The name of the file
+
+		Note:
+			Must not be called while other threads record anything
+	*/
+	static void write(const char *filename);
+};
+
+/*
+	A span which covers the lifetime of its scope if the tracer is enabled.
+*/
+class ScopedSpan{
+
+private:
+
+	/*
+		The event of the span
+	*/
+	TraceEvent event;
+
+	/*
+		The flag whether this span gets recorded
+	*/
+	bool active;
+
+public:
+
+	/*
+		Constructor:
+		Starts the span if the tracer is enabled.
+
+		@param 	name 		The name of the span
+		@param 	category 	The category of the span
+		@param 	sampled 	False if the span should not be recorded, e.g. as it was not
+							selected by the sampling
+	*/
+	ScopedSpan(const char *name, const char *category, const bool sampled = true){
+		active = Tracer::enabled && sampled;
+		if(!active)
+			return;
+
+		event.phase = 'X';
+		event.name = name;
+		event.category = category;
+		event.ts = Tracer::now();
+	}
+
+	/*
+		The function setArg() sets an argument of the span shown by the trace viewer.
+
+		@param 	name 	The name of the argument
+		@param 	value 	The value of the argument
+	*/
+	void setArg(const char *name, const double value){
+		if(!active)
+			return;
+
+		event.args.push_back(std::make_pair(name, value));
+	}
+
+	/*
+		Destructor:
+		Ends the span and adds it to the trace.
+	*/
+	~ScopedSpan(){
+		if(!active)
+			return;
+
+		event.dur = Tracer::now() - event.ts;
+		Tracer::add(event);
+	}
+};
+
+#endif
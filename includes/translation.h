@@ -21,7 +21,10 @@
 */
 #include <cmath>
 #include <limits>
+#include <atomic>
+#include <chrono>
 #include <string>
+#include <vector>
 
 /*
 	Include my headers	
@@ -101,7 +104,92 @@ protected:
 	/*
 		The number of already performed translations
 	*/
-	static unsigned long long n;
+	static std::atomic<unsigned long long> n;
+
+	/*
+		If it is not NULL, all vertices the checks of the translation depend on get appended
+		to this list
+	*/
+	std::vector<Vertex*> *readSet;
+
+	/*
+		The time the translation has been generated at
+	*/
+	std::chrono::steady_clock::time_point created;
+
+	/*
+		The reason of the last failed call of checkEdge()
+	*/
+	mutable Rejection edgeFailure;
+
+	/*
+		The flag whether the translation has been rejected and the reason of the rejection
+	*/
+	mutable bool rejected;
+	mutable Rejection rejection;
+
+	/*
+		The flag whether the translation gets counted in the statistics, i.e. it is not just
+		used for checking
+	*/
+	bool counted;
+
+	/*
+		The number of triangles passed by checkEdge() and of flips of the thread at the
+		generation of the translation
+	*/
+	unsigned long long startTriangles;
+	unsigned long long startFlips;
+
+	/*
+		The number of triangles passed by the calls of checkEdge() of this translation
+	*/
+	mutable unsigned int crossedTriangles;
+
+
+	/*
+		Constructor:
+		Generates a translation which is just used for checking. It initializes everything
+		except of the new polygon edges, which have to be generated by the derived class. The
+		translation does not get counted in the statistics.
+
+		@param 	Tr 		The triangulation the moving vertex lives in
+		@param 	v 		The vertex to move
+		@param 	dX 		The x-component of the translation vector
+		@param 	dY 		The y-component of the translation vector
+		@param 	rs 		The list the read vertices get appended to, can be NULL
+	*/
+	Translation(Triangulation *Tr, Vertex *v, double dX, double dY, std::vector<Vertex*> *rs);
+
+	/*
+		The function addToReadSet() appends a vertex to the read set of the translation if it
+		has one.
+
+		@param 	v 	The vertex which has been read
+	*/
+	void addToReadSet(Vertex * const v) const;
+
+	/*
+		The function setRejection() marks the translation as rejected. The rejection gets
+		counted in the statistics when the translation is destroyed.
+
+		@param 	r 	The reason of the rejection
+	*/
+	void setRejection(const Rejection r) const;
+
+	/*
+		The function recordCosts() records the wall time, the number of passed triangles and
+		the number of flips of the translation in the histograms of its engine.
+
+		@param 	e 	The engine of the translation
+
+		Note:
+			- Must be called by the destructors of the derived classes, such that the time
+				includes their clean up
+			- Translations executed by the translation itself, e.g. the parts of a split
+				translation, are included
+	*/
+	void recordCosts(const Engine e) const;
 
 
 	/*
@@ -134,10 +222,12 @@ protected:
 		the intersected edge until newE either intersects a polygon edge or ends in any
 		triangle.
 
-		@param 	fromV 	The vertex where the new edge starts
-		@param 	newE 	The new edge
-		@return 		True if the new edge does not intersect any polygon edge,
-						otherwise false
+		@param 	fromV 		The vertex where the new edge starts
+		@param 	newE 		The new edge
+		@param 	exempt0 	A polygon edge which is treated as triangulation edge, can be NULL
+		@param 	exempt1 	A polygon edge which is treated as triangulation edge, can be NULL
+		@return 			True if the new edge does not intersect any polygon edge,
+							otherwise false, the reason gets stored in edgeFailure
 
 		Note:
 			- If the edge goes right through another vertex we also count it as intersecting
@@ -150,8 +240,14 @@ protected:
 				in checkIntersection() should lead to getting all these cases as intersections of
 				type VERTEX.
 			- Edges of the bounding box are treated as polygon edges
+			- All edges of the surrounding polygon get checked, not just the ones in direction
+				of the new edge, as the epsilon of checkIntersection() also reports vertices of
+				other edges close to the new edge
+			- The function does not change anything, so the checks of multiple translations
+				can run concurrently
 	*/
-	bool checkEdge(Vertex * const fromV, TEdge * const newE) const;
+	bool checkEdge(Vertex * const fromV, TEdge * const newE, TEdge * const exempt0 = NULL,
+		TEdge * const exempt1 = NULL) const;
 
 
 public:
@@ -164,11 +260,19 @@ public:
 						Translation(Triangulation *Tr, int i, double dX, double dY)
 						Translation(Triangulation *Tr, Vertex *v, double dX, double dY)
 
+		GETTER:
+
+		bool 			isRejected() const
+		Rejection 		getRejection() const
+		double 			getAge() const
+		unsigned int 	getCrossedTriangles() const
+
 		OTHERS:
 
 		bool 			checkOrientation()
 		enum Executed 	execute()
 		bool 			checkSimplicityOfTranslation()
+		void 			discard()
 	*/
 	
 
@@ -201,6 +305,31 @@ public:
 	Translation(Triangulation *Tr, Vertex *v, double dX, double dY);
 
 
+	/*
+		G ~ E ~ T ~ T ~ E ~ R ~ S
+	*/
+
+	/*
+		@return 	True if the translation has been rejected, otherwise false
+	*/
+	bool isRejected() const;
+
+	/*
+		@return 	The reason of the rejection, just valid if the translation has been rejected
+	*/
+	Rejection getRejection() const;
+
+	/*
+		@return 	The time since the translation has been generated (in seconds)
+	*/
+	double getAge() const;
+
+	/*
+		@return 	The number of triangles passed by the simplicity check of the translation
+	*/
+	unsigned int getCrossedTriangles() const;
+
+
 	/*
 		O ~ T ~ H ~ E ~ R ~ S
 	*/
@@ -230,6 +359,10 @@ public:
 		from the new vertex position to one of its neighbors intersects a polygon edge.
 
 		@return 	True if the resulting polygon is still simple, otherwise false
+
+		Note:
+			The old polygon edges of the moving vertex are treated as triangulation edges
+			without changing their type
 	*/
 	bool checkSimplicityOfTranslation() const;
 
@@ -240,6 +373,13 @@ public:
 	*/
 	virtual enum Executed execute() = 0;
 
+	/*
+		The function discard() excludes a translation which has been checked but does not get
+		executed from the statistics, e.g. as the same translation gets executed by another
+		translation engine.
+	*/
+	void discard();
+
 
 	/*
 		D ~ E ~ S ~ T ~ R ~ U ~ C ~ T ~ O ~ R
@@ -247,10 +387,10 @@ public:
 
 	/*
 		Destructor:
-		Checks the surrounding polygon of the moved vertex and deletes all the remaining construction
-		vertices and edges. It errors with exit code 6 if the surrounding polygon check fails.
+		Counts the rejection of the translation in the statistics if it has been rejected and
+		is not just used for checking.
 	*/
-	virtual ~Translation() {};
+	virtual ~Translation();
 };
 
 #endif
@@ -20,7 +20,7 @@
 	Include standard libraries
 */
 #include <list>
-#include <stack>
+#include <vector>
 
 /*
 	Include my headers	
@@ -41,24 +41,6 @@
 */
 enum class TranslationType {DEFAULT, SPLIT_PART_1, SPLIT_PART_2};
 
-/*
-	Remember the state change of a flip
-
-	oldDV0 	One vertex of the edge which was flipped
-	oldDV1 	The other vertex of the edge which was flipped
-	newDV0 	One vertex of the inserted edge
-	newDV1 	The other vertex of the inserted edge
-*/
-struct Flip{
-	Vertex * const oldDV0;
-	Vertex * const oldDV1;
-	Vertex * const newDV0;
-	Vertex * const newDV1;
-
-	Flip(Vertex * const old0, Vertex * const old1, Vertex * const new0, Vertex * const new1) :
-		oldDV0(old0), oldDV1(old1), newDV0(new0), newDV1(new1) {}
-};
-
 class TranslationKinetic : public Translation{
 
 private:
@@ -85,9 +67,17 @@ private:
 	EventQueue *Q;
 
 	/*
-		A stack containing information of all processed flips
+		The edges flipped by the translations of the calling thread in the order of their
+		flips, flipping them again in reversed order undoes the flips. The log keeps its
+		memory over all translations, so recording a flip does not allocate anything
+	*/
+	static thread_local std::vector<TEdge*> flipLog;
+
+	/*
+		The size of the flip log at the generation of the translation, the flips of this
+		translation are the entries behind it
 	*/
-	std::stack<Flip*> FlipStack;
+	size_t flipBase;
 
 	/*
 		The event time of the last processed event
@@ -193,9 +183,9 @@ private:
 	enum Executed executeSplitChangeSide();
 
 	/*
-		The function flip() executes one event by removing the longest edge of the collapsing
-		triangle and inserting the other diagonal of the resulting quadrilateral. It errors
-		with exit code 3 if the longest edge is a polygon edge. If the flip is no singleFlip
+		The function flip() executes one event by replacing the longest edge of the collapsing
+		triangle in place by the other diagonal of the quadrilateral formed by its triangles.
+		It errors with exit code 3 if the longest edge is a polygon edge. If the flip is no singleFlip
 		it also computes whether the the two resulting triangles will also collapse during the
 		further translation and in case insert them into the event queue and check its stability.
 		This computation is outsourced to the functions insertAfterOppositeFlip() and
@@ -376,7 +366,7 @@ public:
 		Destructor:
 		Checks the surrounding polygon of the moved vertex and deletes all the remaining construction
 		vertices and edges. It errors with exit code 6 if the surrounding polygon check fails. It also
-		deletes the flip stack.
+		drops the flips of the translation from the flip log.
 	*/	
 	~TranslationKinetic() override;
 };
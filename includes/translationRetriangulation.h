@@ -316,6 +316,10 @@ public:
 		Checks the surrounding polygon of the moved vertex and deletes all the remaining construction
 		vertices and edges. It errors with exit code 6 if the surrounding polygon check fails. It also
 		deletes the additional entities used during the translation.
+
+		Note:
+			The check and the update of the edge weights get skipped for discarded translations,
+			as they did not change anything
 	*/	
 	~TranslationRetriangulation() override;
 };
@@ -23,6 +23,7 @@
 #include <stdio.h>
 #include <vector>
 #include <string>
+#include <atomic>
 
 #ifndef _USE_MATH_DEFINES
 #define _USE_MATH_DEFINES
@@ -34,6 +35,7 @@
 */
 #include "predicates.h"
 #include "stentry.h"
+#include "arena.h"
 
 #ifndef __TRIANGLE_H_
 #define __TRIANGLE_H_
@@ -54,16 +56,16 @@ private:
 	/*
 		The edges building the triangle
 	*/
-	TEdge * const e0;
-	TEdge * const e1;
-	TEdge * const e2;
+	TEdge *e0;
+	TEdge *e1;
+	TEdge *e2;
 
 	/*
 		The corresponding vertices
 	*/
-	Vertex * const v0;
-	Vertex * const v1;
-	Vertex * const v2;
+	Vertex *v0;
+	Vertex *v1;
+	Vertex *v2;
 
 	/*
 		Indicates whether the triangle is internal to the polygon or not.
@@ -89,12 +91,17 @@ private:
 	/*
 		The number of already generated triangles
 	*/
-	static unsigned long long n;
+	static std::atomic<unsigned long long> n;
+
+	/*
+		The copy of the triangle generated by the running relayout of the triangulation
+	*/
+	Triangle *relocated;
 
 	/*
 		Number of triangles existing at the moment
 	*/
-	static unsigned long long existing; 
+	static std::atomic<unsigned long long> existing; 
 
 
 	/*
@@ -108,12 +115,15 @@ private:
 		trustworthy, whereas the exact value might still have numerical errors. Also 0 is
 		trustworthy.
 
+		@param 	V0 	The first vertex of the triangle
+		@param 	V1 	The second vertex of the triangle
+		@param 	V2 	The third vertex of the triangle
 		@return 	The estimate for the signed area
 
 		Note:
 			In fact this functions computes 2 times the signed area of the triangle.
 	*/
-	double signedAreaExact() const;
+	static double signedAreaExact(Vertex * const V0, Vertex * const V1, Vertex * const V2);
 
 	/*
 		The function signedAreaDouble() computes an estimate of the signed area of the triangle
@@ -122,12 +132,15 @@ private:
 		always have the same order independent of the ordering of the vertices in the triangle
 		class. The correct sign therefore is ensured by the case distinctions here.
 
+		@param 	V0 	The first vertex of the triangle
+		@param 	V1 	The second vertex of the triangle
+		@param 	V2 	The third vertex of the triangle
 		@return 	The estimate for the signed area
 
 		Note:
 			In fact this functions computes 2 times the signed area of the triangle.
 	*/
-	double signedAreaDouble() const;
+	static double signedAreaDouble(Vertex * const V0, Vertex * const V1, Vertex * const V2);
 
 	/*
 		The function det() computes the determinant of three 2D vertices. It asserts that the
@@ -143,7 +156,17 @@ private:
 		Note:
 			This is just default floating-point arithmetic!
 	*/
-	double det(Vertex * const V0, Vertex * const V1, Vertex * const V2) const;
+	static double det(Vertex * const V0, Vertex * const V1, Vertex * const V2);
+
+	/*
+		Constructor:
+		Generates a copy of the triangle t for the relayout of the triangulation. The copy is
+		built by the copies of the vertices and edges of t and takes over the ID, the flags
+		and the SelectionTree entry of t, whereas t gets removed from the SelectionTree.
+
+		@param 	t 	The triangle to be copied
+	*/
+	Triangle(Triangle * const t);
 
 public:
 
@@ -162,6 +185,18 @@ public:
 		else
 			return false;
 	}
+
+	/*
+		Triangles reuse the slots of deleted entities of the same size in the arena of the
+		last relayout, slots in the arena must not be freed individually
+	*/
+	static void *operator new(size_t n){
+		return Arena::acquire(n);
+	}
+
+	static void operator delete(void *p, size_t n){
+		Arena::release(p, n);
+	}
 	
 	/*
 		LIST OF PUBLIC MEMBER FUNCTIONS
@@ -190,6 +225,7 @@ public:
 		double 						getRange(Vertex const * const v, const double alpha) const
 		TEdge* 						getNotIntersectedEdge() const
 		double 						getWeight() const
+		Triangle* 					getRelocated() const
 
 		SETTER:
 
@@ -212,11 +248,16 @@ public:
 		double 						signedArea() const
 		bool 						inside(Vertex *v) const
 		void 						updateSTEntry() const
+		void 						reassign(TEdge *E0, TEdge *E1, TEdge *E2, Vertex *V0,
+									Vertex *V1, Vertex *V2)
+		Triangle* 					relocate(Arena * const a)
 
 
 		LIST OF STATIC FUNCTIONS
 
 		static bool  				insideTriangle(Vertex *v0, Vertex *v1, Vertex *v2, Vertex *v)
+		static double 				signedArea(Vertex * const V0, Vertex * const V1,
+									Vertex * const V2)
 		static unsigned long long 	getNumberOfExistingTriangles() const
 	*/
 
@@ -260,8 +301,10 @@ public:
 		@param 	V2 	The third vertex of the triangle
 
 		Note:
-			The order of the vertices is important to check the orientation. It is always the
-			ordering v0 -> v1 -> v2 considered.
+			- The order of the vertices is important to check the orientation. It is always the
+				ordering v0 -> v1 -> v2 considered.
+			- Test triangles are not registered at their vertices, so orientation tests do not
+				modify the triangulation at all
 	*/
 	Triangle(Vertex *V0, Vertex *V1, Vertex *V2);
 
@@ -410,6 +453,12 @@ public:
 	*/
 	double getWeight() const;
 
+	/*
+		@return 	The copy of the triangle generated by the running relayout, NULL if the
+					triangle has not been relocated
+	*/
+	Triangle *getRelocated() const;
+
 
 	/*
 		S ~ E ~ T ~ T ~ E ~ R ~ S
@@ -516,6 +565,39 @@ public:
 		Updates the selection tree entry of the triangle.
 	*/
 	void updateSTEntry() const;
+
+	/*
+		The function reassign() replaces the edges and vertices of the triangle during an
+		in-place flip of one of its edges. The triangle keeps its ID, its SelectionTree entry
+		and its internal flag, and gets dequeued as a newly generated triangle.
+
+		@param 	E0 		The first edge of the triangle
+		@param 	E1 		The second edge of the triangle
+		@param 	E2 		The third edge of the triangle
+		@param 	V0 		The first vertex of the triangle
+		@param 	V1 		The second vertex of the triangle
+		@param 	V2 		The third vertex of the triangle
+
+		Note:
+			The triangle does not register itself at its new vertices and edges, this is
+			done by TEdge::flip()
+	*/
+	void reassign(TEdge *E0, TEdge *E1, TEdge *E2, Vertex *V0, Vertex *V1, Vertex *V2);
+
+	/*
+		The function relocate() places a copy of the triangle in an arena during a relayout
+		of the triangulation. The copy is built by the copies of the vertices and edges of the
+		triangle and takes over its ID, flags and SelectionTree entry.
+
+		@param 	a 	The arena of the relayout
+		@return 	The copy of the triangle
+
+		Note:
+			- All vertices and edges of the triangle must already be relocated
+			- The copy does not register itself at its vertices and edges, this is done by
+				Vertex::relocateReferences() and TEdge::relocateReferences()
+	*/
+	Triangle *relocate(Arena * const a);
 	
 	
 	/*
@@ -550,6 +632,21 @@ public:
 		@return 			True if v lies inside the triangle, otherwise false
 	*/
 	static bool insideTriangle(Vertex  *v0, Vertex *v1, Vertex *v2, Vertex *v);
+
+	/*
+		The function signedArea() computes an estimate of the signed area of the triangle
+		formed by the vertices V0, V1 and V2 like the member function signedArea(), but
+		without building a test triangle.
+
+		@param 	V0 	The first vertex of the triangle
+		@param 	V1 	The second vertex of the triangle
+		@param 	V2 	The third vertex of the triangle
+		@return 	The estimate for the signed area
+
+		Note:
+			In fact, it computes two times the signed area of the triangle.
+	*/
+	static double signedArea(Vertex * const V0, Vertex * const V1, Vertex * const V2);
 };
 	
 #endif
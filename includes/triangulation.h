@@ -22,12 +22,16 @@
 #include <vector>
 #include <stdio.h>
 #include <map>
+#include <mutex>
 #include <fstream>
+#include <algorithm>
 
 /*
 	Include my headers	
 */
 #include "settings.h"
+#include "arena.h"
+#include "polygonReader.h"
 
 /*
 	Define the class Triangulation
@@ -74,6 +78,12 @@ private:
 	*/
 	std::map<int, TEdge*> edges;
 
+	/*
+		Guards the edges map, as edges get added and removed concurrently during the parallel
+		translation phase
+	*/
+	std::mutex edgesMutex;
+
 	/*
 		A selection tree for selecting a triangle interior to the polygon		
 	*/
@@ -92,6 +102,17 @@ private:
 	*/
 	int N;
 
+	/*
+		The arena holding the entities placed by the last relayout (NULL if there was no
+		relayout yet)
+	*/
+	Arena *arena;
+
+	/*
+		The number of polygon vertices at the last relayout
+	*/
+	int relayoutSize;
+
 
 public:
 	
@@ -135,6 +156,7 @@ public:
 		void 			writePolygon(const char *filename) const
 		void 			writePolygonToDat(const char *filename) const
 		void 			writePolygonToLine(const char *filename) const
+		void 			writePolygonToBinary(const char *filename) const
 
 		OTHERS:
 
@@ -142,6 +164,8 @@ public:
 		void 			checkST() const
 		void 			stretch(const double factor)
 		void			checkSimplicity() const
+		void 			relayout()
+		void 			relayoutIfGrown()
 	*/
 
 
@@ -267,7 +291,9 @@ public:
 
 	/*
 		@param 	pID 	The ID of the polygon of interest
-		@return 		Any edge of the polygon selected uniformly at random by its length
+		@return 		Any edge of the polygon suitable for insertions selected uniformly at
+						random, weighted by its length if weighted edge selection is enabled,
+						NULL if there is no such edge
 	*/
 	TEdge *getRandomEdgeWeighted(const unsigned int pID) const;
 
@@ -343,6 +369,14 @@ public:
 	*/
 	void writePolygonToLine(const char *filename) const;
 
+	/*
+		The function writePolygonToBinary() writes all polygons to a binary file which can
+		be read again by --input without loss of precision (see polygonReader.h)
+
+		@param 	filename 	The name of the binary file
+	*/
+	void writePolygonToBinary(const char *filename) const;
+
 
 	/*
 		O ~ T ~ H ~ E ~ R ~ S
@@ -390,6 +424,37 @@ public:
 		- Should not be called for larger polygons, because it is highly inefficient.
 */
 	void checkSimplicity() const;
+
+	/*
+		The function relayout() moves all vertices, edges and triangles of the triangulation
+		into a new arena, such that entities close to each other in the plane are close to
+		each other in memory. The vertices get placed in the order of their positions along
+		a Hilbert curve through the bounding box, each one followed by its edges and triangles
+		whose other vertices have already been placed. All pointers to the entities, i.e. the
+		ones of the entities themselves, of the vertex vectors and of the SelectionTrees, get
+		updated and the previous arena gets freed.
+
+		Note:
+			- The IDs of the entities and the indices of the vertices do not change, so the
+				relayout does not change the generated polygon
+			- Must not be called while any translation or insertion is in progress
+	*/
+	void relayout();
+
+	/*
+		The function relayoutIfGrown() calls relayout() if the relayout is enabled and the
+		number of polygon vertices has at least doubled since the last relayout.
+
+		Note:
+			Triangulations with less than minRelayoutSize vertices do not get relayouted, as
+			they fit into the caches anyway
+	*/
+	void relayoutIfGrown();
+
+	/*
+		The minimum number of polygon vertices for a relayout
+	*/
+	static const int minRelayoutSize = 4096;
 };
 
 #endif
@@ -24,6 +24,7 @@
 #include <stdio.h>
 #include <map>
 #include <queue>
+#include <atomic>
 
 #ifndef _USE_MATH_DEFINES
 #define _USE_MATH_DEFINES
@@ -34,6 +35,7 @@
 	Include my headers	
 */
 #include "settings.h"
+#include "arena.h"
 
 #ifndef __VERTEX_H_
 #define __VERTEX_H_
@@ -51,6 +53,11 @@ class TPolygon;
 #include "triangle.h"
 #include "tpolygon.h"
 
+/*
+	The states of the angularly sorted star of a vertex
+*/
+enum class StarState {STALE, BUILDING, SORTED};
+
 class Vertex{
 
 private:
@@ -100,15 +107,54 @@ private:
 	*/
 	const unsigned long long id;
 
+	/*
+		The region of the triangulation the vertex is assigned to during a parallel
+		translation phase (-1 if it is not assigned to any region)
+	*/
+	int region;
+
+	/*
+		The index of the vertex in the vertices vector of the triangulation (-1 if it is not
+		part of it)
+	*/
+	int index;
+
+	/*
+		A counter which gets increased whenever the vertex gets moved or its star in the
+		triangulation or its polygon edges change. It is used to detect whether the result of
+		a speculative check is outdated
+	*/
+	unsigned long long version;
+
+	/*
+		The triangles of the star of the vertex in counter-clockwise order and for each of
+		them the vertex of its first edge in counter-clockwise order. They get rebuilt from
+		the triangles list at the first lookup after the star changed, the cyclic order
+		itself does not change while the vertices just move
+	*/
+	mutable std::vector<Triangle*> star;
+	mutable std::vector<Vertex*> starRays;
+
+	/*
+		The state of the sorted star. Concurrent lookups finding the star while another
+		thread is building it scan the triangles list instead
+	*/
+	mutable std::atomic<StarState> starState;
+
+	/*
+		The copy of the vertex generated by the running relayout of the triangulation
+	*/
+	Vertex *relocated;
+
 	/*
 		The number of already generated vertices
 	*/
-	static unsigned long long n;
+	static std::atomic<unsigned long long> n;
 
 	/*
 		The number of deleted vertices
 	*/
-	static unsigned long long deleted;
+	static std::atomic<unsigned long long> deleted;
 
 
 	/*
@@ -127,6 +173,55 @@ private:
 	*/
 	void getEnvironment(std::map<const unsigned long long, const TEdge*> &es,
 		std::map<const unsigned long long, const Vertex*> &vs, const int depth) const;
+
+	/*
+		The function getRays() returns the two other vertices of a triangle incident to the
+		vertex in counter-clockwise order as seen from the vertex.
+
+		@param 	t 	The triangle of interest
+		@param 	a 	The other vertex of the first edge of t incident to the vertex
+		@param 	b 	The other vertex of the second edge of t incident to the vertex
+	*/
+	void getRays(Triangle const * const t, Vertex *&a, Vertex *&b) const;
+
+	/*
+		The function isInWedge() checks whether a direction lies between the two edges of a
+		triangle incident to the vertex.
+
+		@param 	t 	The triangle of interest
+		@param 	dx 	The x-component of the direction
+		@param 	dy 	The y-component of the direction
+		@return 	True if the direction lies inside the triangle or on one of its edges,
+					otherwise false
+	*/
+	bool isInWedge(Triangle const * const t, const double dx, const double dy) const;
+
+	/*
+		The function sortStar() rebuilds the star of the vertex from its triangles list by
+		sorting the triangles by the pseudo-angles of their first edges.
+	*/
+	void sortStar() const;
+
+	/*
+		The function getPseudoAngle() computes a pseudo-angle of a direction, i.e. a value
+		which is monotone in the angle of the direction to the positive x-axis, but needs no
+		trigonometric function.
+
+		@param 	dx 	The x-component of the direction
+		@param 	dy 	The y-component of the direction
+		@return 	The pseudo-angle in the range [0, 4)
+	*/
+	static double getPseudoAngle(const double dx, const double dy);
+
+	/*
+		Constructor:
+		Generates a copy of the vertex v for the relayout of the triangulation. The copy
+		takes over the ID, the position and the assignments to the triangulation and the
+		polygon of v, whereas v gets unregistered from the triangulation.
+
+		@param 	v 	The vertex to be copied
+	*/
+	Vertex(Vertex * const v);
 	
 
 public:
@@ -160,6 +255,18 @@ public:
 			return false;
 	}
 
+	/*
+		Vertices reuse the slots of deleted entities of the same size in the arena of the
+		last relayout, slots in the arena must not be freed individually
+	*/
+	static void *operator new(size_t n){
+		return Arena::acquire(n);
+	}
+
+	static void operator delete(void *p, size_t n){
+		Arena::release(p, n);
+	}
+
 	/*
 		LIST OF PUBLIC MEMBER FUNCTIONS
 
@@ -178,6 +285,8 @@ public:
 		void 					addTriangle(Triangle * const t)
 		void 					setToPrev(TEdge * const e)
 		void 					setToNext(TEdge * const e)
+		void 					setRegion(const int r)
+		void 					setIndex(const int i)
 
 		GETTER:
 
@@ -190,8 +299,14 @@ public:
 		std::list<TEdge*> 		getPolygonEdges() const
 		std::list<TEdge*> 		getEdges() const
 		bool 					isRectangleVertex() const
+		int 					getRegion() const
+		int 					getIndex() const
+		unsigned long long 		getVersion() const
 		double 					getMediumEdgeLength() const
 		double 					getDirectedEdgeLength(const double alpha) const
+		double 					getFreeDistance(const double alpha) const
+		Triangle* 				getTriangleInDirection(const double dx, const double dy) const
+		unsigned int 			getNumberOfTriangles() const
 		TEdge* 					getToPrev() const
 		TEdge* 					getToNext() const
 		Vertex* 				getPrev() const
@@ -202,6 +317,9 @@ public:
 		int 					getActualPolygonSize() const
 		double					getInsideAngle() const;
 		double 					getNormalDirectionOutside() const;
+		unsigned long long 		getHilbertIndex(const double minX, const double minY,
+								const double size) const
+		Vertex* 				getRelocated() const
 
 		REMOVER:
 
@@ -223,6 +341,9 @@ public:
 		void 					stretch(const double factor)
 		bool 					checkSurroundingPolygon()
 		double 					getDistanceToOrigin() const
+		Vertex* 				relocate(Arena * const a, std::vector<TEdge*> &es,
+								std::vector<Triangle*> &ts)
+		void 					relocateReferences()
 	*/
 
 
@@ -330,6 +451,16 @@ public:
 	*/
 	void setToNext(TEdge * const e);
 
+	/*
+		@param 	r 	The region of the triangulation the vertex is assigned to
+	*/
+	void setRegion(const int r);
+
+	/*
+		@param 	i 	The index of the vertex in the vertices vector of the triangulation
+	*/
+	void setIndex(const int i);
+
 	
 	/*
 		G ~ E ~ T ~ T ~ E ~ R ~ S
@@ -390,6 +521,24 @@ public:
 	*/
 	bool isRectangleVertex() const;
 
+	/*
+		@return 	The region of the triangulation the vertex is assigned to (-1 if it is
+					not assigned to any region)
+	*/
+	int getRegion() const;
+
+	/*
+		@return 	The index of the vertex in the vertices vector of the triangulation (-1 if
+					it is not part of it)
+	*/
+	int getIndex() const;
+
+	/*
+		@return 	The version of the vertex, which changes whenever the vertex gets moved or
+					its star in the triangulation or its polygon edges change
+	*/
+	unsigned long long getVersion() const;
+
 	/*
 		The function getMediumEdgeLength() computes the mean of the lengths of all
 		incident edges to the vertex. This can be used as estimate for appropriate 
@@ -417,6 +566,45 @@ public:
 	*/
 	double getDirectedEdgeLength(const double alpha) const;
 
+	/*
+		The function getFreeDistance() casts a ray from the vertex in direction alpha through the
+		triangulation and returns the distance to the first polygon or frame edge it hits. It
+		walks the triangles along the ray in the same way checkEdge() of the translations does.
+		A vertex lying exactly on the ray stops the walk, too.
+
+		@param 	alpha 	Direction of the ray (alpha = 0 corresponds to the positive x-direction)
+		@return 		The distance the vertex can move in direction alpha without crossing a
+						polygon edge, 0 if the walk could not be started
+
+		Note:
+			This bounds just the path of the vertex itself, its new polygon edges still can
+			sweep over other vertices
+	*/
+	double getFreeDistance(const double alpha) const;
+
+	/*
+		The function getTriangleInDirection() finds the triangle incident to the vertex
+		which contains the direction (dx, dy). It does a binary search in the angularly
+		sorted star of the vertex and scans the triangles list if the star is being built by
+		another thread or the result of the search can not be verified.
+
+		@param 	dx 	The x-component of the direction
+		@param 	dy 	The y-component of the direction
+		@return 	The triangle in direction (dx, dy), NULL if there is none
+
+		Note:
+			- The search uses pseudo-angles and orientation tests, so it needs no
+				trigonometric function
+			- The vertices of the bounding box always scan their triangles, as their star
+				does not surround them
+	*/
+	Triangle *getTriangleInDirection(const double dx, const double dy) const;
+
+	/*
+		@return 	The number of triangles incident to the vertex
+	*/
+	unsigned int getNumberOfTriangles() const;
+
 	/*
 		@return 	The edge to the predecessor of the vertex in the polygon
 	*/
@@ -482,6 +670,28 @@ public:
 	*/
 	double getNormalDirectionOutside() const;
 
+	/*
+		The function getHilbertIndex() computes the position of the vertex along a Hilbert
+		curve of order 16 filling a square. Vertices close to each other along the curve are
+		close to each other in the plane.
+
+		@param 	minX 	The x-coordinate of the lower left corner of the square
+		@param 	minY 	The y-coordinate of the lower left corner of the square
+		@param 	size 	The side length of the square
+		@return 		The index of the cell of the vertex along the curve
+
+		Note:
+			Vertices outside of the square are treated as lying on its boundary
+	*/
+	unsigned long long getHilbertIndex(const double minX, const double minY,
+		const double size) const;
+
+	/*
+		@return 	The copy of the vertex generated by the running relayout, NULL if the
+					vertex has not been relocated
+	*/
+	Vertex *getRelocated() const;
+
 
 	/*
 		R ~ E ~ M ~ O ~ V ~ E ~ R
@@ -608,6 +818,33 @@ public:
 		@return 	The Euclidean distance to the origin
 	*/
 	double getDistanceToOrigin() const;
+
+	/*
+		The function relocate() places a copy of the vertex in an arena during a relayout of
+		the triangulation. Edges of the vertex whose other vertex already has been relocated
+		and triangles of the vertex whose other vertices already have been relocated get
+		relocated right after it.
+
+		@param 	a 	The arena of the relayout
+		@param 	es 	The vector the relocated edges get added to
+		@param 	ts 	The vector the relocated triangles get added to
+		@return 	The copy of the vertex
+
+		Note:
+			- The copy takes over the ID, the position and the assignments to the
+				triangulation and the polygon, the vertex itself gets unregistered from the
+				triangulation
+			- The lists of the copy get set by relocateReferences() as soon as all vertices
+				are relocated
+	*/
+	Vertex *relocate(Arena * const a, std::vector<TEdge*> &es, std::vector<Triangle*> &ts);
+
+	/*
+		The function relocateReferences() sets the edges, the triangles and the polygon edges
+		of the copy of the vertex to the copies of its own ones. Afterwards the vertex itself
+		is not linked to any edge or triangle anymore, so it can be deleted.
+	*/
+	void relocateReferences();
 	
 	
 	/*
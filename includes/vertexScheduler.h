@@ -0,0 +1,194 @@
+/*
+ * Copyright 2021 Philipp Mayer - pmayer@cs.sbg.ac.at
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+/*
+	Include standard libraries
+*/
+#include <vector>
+
+#ifndef __VERTEXSCHEDULER_H_
+#define __VERTEXSCHEDULER_H_
+
+/*
+	Declare classes used by the VertexScheduler
+*/
+class Triangulation;
+
+/*
+	A scheduler for the vertices of the sequential translation phase which chooses the
+	vertices in spatially coherent blocks. The vertices get sorted along a Hilbert curve and
+	cut into buckets of blockSize consecutive vertices. For each block, a bucket is chosen
+	by a vertex selected uniformly at random, i.e. with a probability proportional to its
+	size, and then blockSize vertices get selected uniformly at random from this bucket.
+	Hence each single selection is still uniformly distributed over all vertices, just
+	consecutive selections are correlated.
+*/
+class VertexScheduler{
+
+private:
+
+	/*
+		The number of vertices of a bucket and the number of selections of a block
+	*/
+	unsigned int blockSize;
+
+	/*
+		The indices of the vertices sorted along the Hilbert curve and the position of each
+		index in this order
+	*/
+	std::vector<int> order;
+	std::vector<int> rank;
+
+	/*
+		The first position and the number of vertices of the bucket of the actual block
+	*/
+	int bucketStart;
+	int bucketSize;
+
+	/*
+		The number of selections left in the actual block
+	*/
+	unsigned int remaining;
+
+	/*
+		The number of blocks started so far
+	*/
+	unsigned long long blocks;
+
+	/*
+		The number of selections of each vertex index in the actual translation phase
+	*/
+	std::vector<unsigned long long> selections;
+	unsigned long long phaseSelections;
+
+	/*
+		The sum of the indices of dispersion of the previous translation phases weighted by
+		their number of selections, and the sum of the weights
+	*/
+	double dispersionSum;
+	unsigned long long dispersionWeight;
+
+
+	/*
+		P ~ R ~ I ~ V ~ A ~ T ~ E 	M ~ E ~ M ~ B ~ E ~ R 	F ~ U ~ N ~ C ~ T ~ I ~ O ~ N ~ S
+	*/
+
+	/*
+		The function getPhaseDispersion() computes the index of dispersion, i.e. the variance
+		divided by the mean, of the number of selections of the vertex indices in the actual
+		translation phase.
+
+		@return 	The index of dispersion of the selections, 0 if there were none
+	*/
+	double getPhaseDispersion() const;
+
+
+public:
+
+	/*
+		LIST OF PUBLIC MEMBER FUNCTIONS
+
+		CONSTRUCTORS:
+
+								VertexScheduler(const unsigned int b)
+
+		GETTER:
+
+		unsigned int 			getBlockSize() const
+		unsigned long long 		getNumberOfBlocks() const
+		double 					getSelectionDispersion() const
+
+		OTHERS:
+
+		void 					prepare(Triangulation const * const T)
+		int 					getIndex()
+	*/
+
+
+	/*
+		C ~ O ~ N ~ S ~ T ~ R ~ U ~ C ~ T ~ O ~ R ~ S
+	*/
+
+	/*
+		Constructor:
+
+		@param 	b 	The number of vertices of a bucket and of selections of a block
+	*/
+	VertexScheduler(const unsigned int b);
+
+
+	/*
+		G ~ E ~ T ~ T ~ E ~ R ~ S
+	*/
+
+	/*
+		@return 	The number of vertices of a bucket and of selections of a block
+	*/
+	unsigned int getBlockSize() const;
+
+	/*
+		@return 	The number of blocks started so far
+	*/
+	unsigned long long getNumberOfBlocks() const;
+
+	/*
+		The function getSelectionDispersion() computes the index of dispersion, i.e. the
+		variance divided by the mean, of the number of selections of the vertex indices in
+		each translation phase and averages it over all phases weighted by their number of
+		selections.
+
+		@return 	The average index of dispersion of the selections, 0 if there were none
+
+		Note:
+			Independent uniform selections result in an index of dispersion of about 1,
+			selections in blocks increase it, as the vertices of a bucket get selected in
+			bursts
+	*/
+	double getSelectionDispersion() const;
+
+
+	/*
+		O ~ T ~ H ~ E ~ R ~ S
+	*/
+
+	/*
+		The function prepare() sorts the vertices of the triangulation along a Hilbert curve
+		over their bounding box. It must be called at the start of each translation phase,
+		as the order deteriorates with the translations.
+
+		@param 	T 	The triangulation the polygon lives in
+
+		Note:
+			- Vertices in the same cell of the Hilbert curve keep the order of their indices
+			- Empty indices of the vertices vector are kept at the end of the order, such
+				that they are selected as often as without the scheduler
+			- The actual block gets dropped and the counting of the selections of a new
+				translation phase starts
+	*/
+	void prepare(Triangulation const * const T);
+
+	/*
+		The function getIndex() selects the next vertex.
+
+		@return 	The index of the selected vertex in the vertices vector of the
+					triangulation
+	*/
+	int getIndex();
+};
+
+#endif
@@ -0,0 +1,176 @@
+/*
+ * Copyright 2021 Philipp Mayer - pmayer@cs.sbg.ac.at
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+/*
+	Include standard libraries
+*/
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+
+/*
+	Include my headers
+*/
+#include "statistics.h"
+#include "timer.h"
+
+#ifndef __WORKERPOOL_H_
+#define __WORKERPOOL_H_
+
+/*
+	A pool of threads which stay alive between multiple parallel steps, so short steps like
+	checking a few candidates for one translation do not have to pay for starting threads.
+*/
+class WorkerPool{
+
+private:
+
+	/*
+		The worker threads, the thread calling run() is the additional worker 0
+	*/
+	std::vector<std::thread> threads;
+
+	/*
+		Mutex and condition variables for starting a step and waiting for its end
+	*/
+	std::mutex m;
+	std::condition_variable startCV;
+	std::condition_variable finishedCV;
+
+	/*
+		The task of the actual step, it gets called once for each index
+	*/
+	std::function<void(const int)> task;
+
+	/*
+		The number of indices of the actual step and the next index to be processed
+	*/
+	int nrTasks;
+	std::atomic<int> next;
+
+	/*
+		The number of the actual step, used by the workers to recognize a new step
+	*/
+	unsigned long long step;
+
+	/*
+		The number of workers which have not finished the actual step yet
+	*/
+	unsigned int running;
+
+	/*
+		Gets set to stop the workers
+	*/
+	bool stop;
+
+	/*
+		The translation counters of the workers
+	*/
+	std::vector<StatisticsCounters> counters;
+
+
+	/*
+		The function work() is the main loop of a worker thread.
+
+		@param 	w 	The index of the worker
+	*/
+	void work(const unsigned int w);
+
+	/*
+		The function process() calls the task for indices until all indices of the actual
+		step are assigned.
+	*/
+	void process();
+
+
+public:
+
+	/*
+		LIST OF PUBLIC MEMBER FUNCTIONS
+
+		CONSTRUCTORS:
+
+							WorkerPool(const unsigned int nrThreads)
+
+		GETTER:
+
+		unsigned int 		getNrThreads() const
+
+		OTHERS:
+
+		void 				run(const int n, std::function<void(const int)> f)
+	*/
+
+
+	/*
+		C ~ O ~ N ~ S ~ T ~ R ~ U ~ C ~ T ~ O ~ R ~ S
+	*/
+
+	/*
+		Constructor:
+		Starts nrThreads - 1 worker threads, as the thread calling run() works as well.
+
+		@param 	nrThreads 	The total number of threads working on a step
+	*/
+	WorkerPool(const unsigned int nrThreads);
+
+
+	/*
+		G ~ E ~ T ~ T ~ E ~ R ~ S
+	*/
+
+	/*
+		@return 	The total number of threads working on a step
+	*/
+	unsigned int getNrThreads() const;
+
+
+	/*
+		O ~ T ~ H ~ E ~ R ~ S
+	*/
+
+	/*
+		The function run() calls f for all indices from 0 to n - 1 distributed over all
+		threads of the pool and returns after all calls are finished. Afterwards it merges
+		the translation counters of the workers into the ones of the calling thread.
+
+		@param 	n 	The number of indices
+		@param 	f 	The task to be called for each index
+
+		Note:
+			The calls of f run concurrently, so f must not change anything another call
+			reads
+	*/
+	void run(const int n, std::function<void(const int)> f);
+
+
+	/*
+		D ~ E ~ S ~ T ~ R ~ U ~ C ~ T ~ O ~ R
+	*/
+
+	/*
+		Destructor:
+		Stops and joins all worker threads.
+	*/
+	~WorkerPool();
+};
+
+#endif
@@ -0,0 +1,126 @@
+/*
+ * Copyright 2021 Philipp Mayer - pmayer@cs.sbg.ac.at
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "acceptanceController.h"
+
+/*
+	P ~ R ~ I ~ V ~ A ~ T ~ E 	M ~ E ~ M ~ B ~ E ~ R 	F ~ U ~ N ~ C ~ T ~ I ~ O ~ N ~ S
+*/
+
+/*
+	The function adjust() updates the scale by the acceptance rate of the actual window
+	and starts a new window.
+*/
+void AcceptanceController::adjust(){
+	double rate, limit;
+	ControllerStep step;
+
+	rate = (double)windowPerformed / (double)windowTries;
+
+	// Too many accepted moves allow longer distances and vice versa
+	logScale = logScale + gain * (rate - target);
+
+	// Cap the bias
+	limit = log(maxBias);
+	if(logScale > limit)
+		logScale = limit;
+	else if(logScale < -limit)
+		logScale = -limit;
+
+	step.tries = totalTries;
+	step.rate = rate;
+	step.scale = exp(logScale);
+	trajectory.push_back(step);
+
+	windowTries = 0;
+	windowPerformed = 0;
+}
+
+
+/*
+	C ~ O ~ N ~ S ~ T ~ R ~ U ~ C ~ T ~ O ~ R ~ S
+*/
+
+/*
+	Constructor:
+	Starts with the scale 1, i.e. with the unbiased distance distribution.
+
+	@param 	t 	The target acceptance rate
+	@param 	b 	The maximum bias of the scale
+*/
+AcceptanceController::AcceptanceController(const double t, const double b) :
+	target(t), maxBias(b), logScale(0), windowTries(0), windowPerformed(0), totalTries(0) {}
+
+
+/*
+	G ~ E ~ T ~ T ~ E ~ R ~ S
+*/
+
+/*
+	@return 	The factor the translation distances get multiplied with
+*/
+double AcceptanceController::getScale() const{
+	return exp(logScale);
+}
+
+/*
+	@return 	The target acceptance rate
+*/
+double AcceptanceController::getTarget() const{
+	return target;
+}
+
+/*
+	@return 	The maximum bias of the scale
+*/
+double AcceptanceController::getMaxBias() const{
+	return maxBias;
+}
+
+/*
+	@return 	All adjustments done so far
+*/
+std::vector<ControllerStep> const &AcceptanceController::getTrajectory() const{
+	return trajectory;
+}
+
+
+/*
+	O ~ T ~ H ~ E ~ R ~ S
+*/
+
+/*
+	The function record() adds the results of moves to the actual window and adjusts the
+	scale if the window is full.
+
+	@param 	tries 		The number of tried moves
+	@param 	performed 	The number of moves which have been executed at least partially
+
+	Note:
+		- The sequential translation phase records each move, so the scale changes at
+			most every windowSize moves
+		- The parallel translation phases record whole phases, as the distances of a
+			phase must not depend on the execution order of its proposals
+		- Moves of a window which is not full yet are kept for the next phase
+*/
+void AcceptanceController::record(const unsigned long long tries, const unsigned long long performed){
+	windowTries = windowTries + tries;
+	windowPerformed = windowPerformed + performed;
+	totalTries = totalTries + tries;
+
+	if(windowTries >= windowSize)
+		adjust();
+}
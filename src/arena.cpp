@@ -0,0 +1,214 @@
+/*
+ * Copyright 2021 Philipp Mayer - pmayer@cs.sbg.ac.at
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "arena.h"
+
+/*
+	S ~ T ~ A ~ T ~ I ~ C 	V ~ A ~ R ~ I ~ A ~ B ~ L ~ E ~ S
+*/
+
+/*
+	The range of the active arena
+*/
+char *Arena::activeBegin = NULL;
+char *Arena::activeEnd = NULL;
+
+/*
+	The generation of the active arena
+*/
+std::atomic<unsigned int> Arena::generation(0);
+
+/*
+	The free slots of the active arena known by each thread
+*/
+thread_local ArenaSlots Arena::slots = {0, {}};
+
+
+/*
+	P ~ R ~ I ~ V ~ A ~ T ~ E 	M ~ E ~ M ~ B ~ E ~ R 	F ~ U ~ N ~ C ~ T ~ I ~ O ~ N ~ S
+*/
+
+/*
+	The function getSlots() returns the free slots of the calling thread of the given size.
+	Slots of previously active arenas get dropped.
+
+	@param 	n 	The size of the slots in bytes
+	@return 	The free slots, NULL if there are no slots of that size
+*/
+std::vector<void*> *Arena::getSlots(const size_t n){
+	size_t index = getAlignedSize(n) / alignof(std::max_align_t);
+
+	if(index >= 32)
+		return NULL;
+
+	if(slots.generation != generation){
+		for(auto& i : slots.free)
+			i.clear();
+		slots.generation = generation;
+	}
+
+	return &slots.free[index];
+}
+
+
+/*
+	C ~ O ~ N ~ S ~ T ~ R ~ U ~ C ~ T ~ O ~ R ~ S
+*/
+
+/*
+	Constructor:
+	Allocates a block of n bytes. Errors with exit code 19 if the block can not be
+	allocated.
+
+	@param 	n 	The size of the block in bytes
+*/
+Arena::Arena(const size_t n) : size(n), used(0) {
+	block = (char*)malloc(size);
+
+	if(block == NULL){
+		fprintf(stderr, "Arena error: could not allocate %lu bytes\n", size);
+		exit(19);
+	}
+}
+
+
+/*
+	O ~ T ~ H ~ E ~ R ~ S
+*/
+
+/*
+	The function allocate() hands out the next n bytes of the block. Errors with exit
+	code 19 if the block is exhausted.
+
+	@param 	n 	The number of bytes
+	@return 	A pointer to the memory, aligned for any entity
+*/
+void *Arena::allocate(const size_t n){
+	void *p;
+
+	if(used + n > size){
+		fprintf(stderr, "Arena error: the arena of %lu bytes is exhausted\n", size);
+		exit(19);
+	}
+
+	p = block + used;
+	used = used + getAlignedSize(n);
+
+	return p;
+}
+
+/*
+	The function activate() makes the arena the active one, i.e. deleted entities placed
+	in it do not get freed anymore.
+
+	Note:
+		- There is just one active arena, the previously active arena must not contain
+			any living entity anymore
+		- Must not be called while other threads acquire or release memory
+*/
+void Arena::activate(){
+	activeBegin = block;
+	activeEnd = block + size;
+
+	generation++;
+}
+
+/*
+	The function contains() checks whether a pointer points into the active arena.
+
+	@param 	p 	The pointer of interest
+	@return 	True if p points into the active arena, otherwise false
+*/
+bool Arena::contains(void const * const p){
+	return (char const*)p >= activeBegin && (char const*)p < activeEnd;
+}
+
+/*
+	The function acquire() returns memory for a new entity. It reuses a slot of the active
+	arena the calling thread has released before if there is one of the right size. It is
+	used by the operator new of the entities.
+
+	@param 	n 	The size of the entity in bytes
+	@return 	The memory for the entity
+*/
+void *Arena::acquire(const size_t n){
+	std::vector<void*> *s;
+	void *p;
+
+	if(activeBegin == NULL)
+		return ::operator new(n);
+
+	s = getSlots(n);
+	if(s == NULL || (*s).empty())
+		return ::operator new(n);
+
+	// The slot released last is most likely still cached
+	p = (*s).back();
+	(*s).pop_back();
+
+	return p;
+}
+
+/*
+	The function release() frees the memory of a deleted entity if it has not been
+	placed in the active arena, otherwise the slot gets reused by acquire(). It is used
+	by the operator delete of the entities.
+
+	@param 	p 	The memory of the deleted entity
+	@param 	n 	The size of the entity in bytes
+*/
+void Arena::release(void * const p, const size_t n){
+	std::vector<void*> *s;
+
+	if(!contains(p)){
+		::operator delete(p);
+		return;
+	}
+
+	s = getSlots(n);
+	if(s != NULL)
+		(*s).push_back(p);
+}
+
+/*
+	@param 	n 	A number of bytes
+	@return 	The number of bytes allocate() really uses for n bytes
+*/
+size_t Arena::getAlignedSize(const size_t n){
+	size_t align = alignof(std::max_align_t);
+
+	return (n + align - 1) / align * align;
+}
+
+
+/*
+	D ~ E ~ S ~ T ~ R ~ U ~ C ~ T ~ O ~ R
+*/
+
+/*
+	Destructor:
+	Frees the block and deactivates the arena if it is the active one.
+*/
+Arena::~Arena(){
+	if(activeBegin == block){
+		activeBegin = NULL;
+		activeEnd = NULL;
+
+		generation++;
+	}
+
+	free(block);
+}
@@ -0,0 +1,181 @@
+/*
+ * Copyright 2021 Philipp Mayer - pmayer@cs.sbg.ac.at
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "engineSelector.h"
+
+/*
+	S ~ T ~ A ~ T ~ I ~ C 	V ~ A ~ R ~ I ~ A ~ B ~ L ~ E ~ S
+*/
+
+/*
+	The cost model
+*/
+unsigned long long EngineSelector::samples[nrEngines][nrBuckets] = {};
+double EngineSelector::costs[nrEngines][nrBuckets] = {};
+
+/*
+	The deferred records
+*/
+bool EngineSelector::recordsDeferred = false;
+thread_local std::vector<EngineRecord> EngineSelector::deferredRecords;
+thread_local unsigned long long EngineSelector::deferredSamples[nrEngines][nrBuckets] = {};
+
+
+/*
+	P ~ R ~ I ~ V ~ A ~ T ~ E 	M ~ E ~ M ~ B ~ E ~ R 	F ~ U ~ N ~ C ~ T ~ I ~ O ~ N ~ S
+*/
+
+/*
+	@param 	triangles 	The number of triangles passed by the simplicity check
+	@return 			The bucket of the translation
+*/
+unsigned int EngineSelector::getBucket(const unsigned int triangles){
+	unsigned int bucket = 0;
+	unsigned int t = triangles;
+
+	while(t > 1 && bucket < nrBuckets - 1){
+		t = t >> 1;
+		bucket++;
+	}
+
+	return bucket;
+}
+
+/*
+	The function addCost() adds the cost of an execution to the moving average of its
+	engine and bucket.
+
+	@param 	e 		The index of the engine
+	@param 	b 		The bucket of the translation
+	@param 	cost 	The cost of the execution (in microseconds)
+*/
+void EngineSelector::addCost(const unsigned int e, const unsigned int b, const double cost){
+	unsigned long long n;
+
+	samples[e][b]++;
+
+	// Plain average for the first executions, afterwards an exponential moving average
+	n = samples[e][b] < window ? samples[e][b] : window;
+	costs[e][b] = costs[e][b] + (cost - costs[e][b]) / (double)n;
+}
+
+
+/*
+	O ~ T ~ H ~ E ~ R ~ S
+*/
+
+/*
+	The function choose() chooses the engine for a translation.
+
+	@param 	triangles 	The number of triangles passed by the simplicity check of the
+						translation
+	@return 			The engine which should execute the translation
+*/
+Engine EngineSelector::choose(const unsigned int triangles){
+	unsigned int b = getBucket(triangles);
+	unsigned int k = (unsigned int)Engine::KINETIC;
+	unsigned int r = (unsigned int)Engine::RETRIANGULATION;
+	unsigned long long nk, nr;
+	Engine best, other;
+
+	// Each choice gets recorded, so the executions include the deferred ones
+	nk = samples[k][b] + deferredSamples[k][b];
+	nr = samples[r][b] + deferredSamples[r][b];
+
+	// Warm up both engines in a new bucket
+	if(nk < warmUp || nr < warmUp)
+		return nk < nr ? Engine::KINETIC : Engine::RETRIANGULATION;
+
+	if(costs[k][b] < costs[r][b]){
+		best = Engine::KINETIC;
+		other = Engine::RETRIANGULATION;
+	}else{
+		best = Engine::RETRIANGULATION;
+		other = Engine::KINETIC;
+	}
+
+	// Keep the average of the other engine up to date
+	if((nk + nr + 1) % explorationPeriod == 0)
+		return other;
+
+	return best;
+}
+
+/*
+	The function record() adds the execution cost of a translation to the model, while
+	the records are deferred it gets recorded for the calling thread instead.
+
+	@param 	e 			The engine which has executed the translation
+	@param 	triangles 	The number of triangles passed by the simplicity check of the
+						translation
+	@param 	flips 		The number of flips performed by the execution
+	@param 	vertices 	The number of vertices of the polygons retriangulated by the
+						execution
+*/
+void EngineSelector::record(const Engine e, const unsigned int triangles,
+	const unsigned long long flips, const unsigned long long vertices){
+	unsigned int b = getBucket(triangles);
+	double cost;
+
+	if(e == Engine::KINETIC)
+		cost = kineticCost + flipCost * (double)flips;
+	else
+		cost = vertexCost * (double)vertices;
+
+	if(recordsDeferred){
+		deferredRecords.push_back({e, b, cost});
+		deferredSamples[(unsigned int)e][b]++;
+	}else
+		addCost((unsigned int)e, b, cost);
+}
+
+/*
+	The function deferRecords() starts respectively stops deferring the records. It must
+	only be called while no worker thread is running.
+
+	@param 	defer 	True if the records get deferred from now on, false otherwise
+*/
+void EngineSelector::deferRecords(const bool defer){
+	recordsDeferred = defer;
+}
+
+/*
+	The function takeDeferredRecords() hands the records the calling thread has recorded
+	while the records were deferred over to the caller.
+
+	@param 	records 	The vector the records get appended to
+*/
+void EngineSelector::takeDeferredRecords(std::vector<EngineRecord> &records){
+	unsigned int i, j;
+
+	records.insert(records.end(), deferredRecords.begin(), deferredRecords.end());
+	deferredRecords.clear();
+
+	for(i = 0; i < nrEngines; i++){
+		for(j = 0; j < nrBuckets; j++)
+			deferredSamples[i][j] = 0;
+	}
+}
+
+/*
+	The function applyRecords() adds the given records to the model in the given order.
+
+	@param 	records 	The records to add
+*/
+void EngineSelector::applyRecords(std::vector<EngineRecord> const &records){
+	for(auto& r : records)
+		addCost((unsigned int)r.engine, r.bucket, r.cost);
+}
@@ -52,7 +52,7 @@ void insertHole(Triangulation *T){
 
 	// Generate the new polygon in the triangulation
 	index = (*T).getActualNrInnerPolygons() + 1;
-	(*T).addInnerPolygon(new TPolygon(T, Settings::innerSizes[index]));
+	(*T).addInnerPolygon(new TPolygon(T, index, Settings::innerSizes[index]));
 
 	// Compute the mean value of the triangles' vertices
 	mx = ((*v0).getX() + (*v1).getX() + (*v2).getX()) / 3;
@@ -61,6 +61,224 @@ Triangulation *generateRegularPolygon(){
 }
 
 
+/*
+	@param 	a 	The index of the first vertex of an edge
+	@param 	b 	The index of the second vertex of an edge
+	@return 	The key of the edge in the map of the edges of the polygon
+*/
+static uint64_t ringEdgeKey(const int a, const int b){
+	return ((uint64_t)std::min(a, b) << 32) | (uint64_t)std::max(a, b);
+}
+
+/*
+	The function getRingEdge() returns the edge between two vertices of the polygon and
+	generates it if it does not exist yet.
+
+	@param 	T 			The triangulation the edge lives in
+	@param 	vertices 	The vertices indexed like the points passed to triangulateDomain()
+	@param 	edges 		The already generated edges by the indices of their vertices
+	@param 	a 			The index of the first vertex
+	@param 	b 			The index of the second vertex
+	@return 			The edge between a and b
+*/
+static TEdge *getRingEdge(Triangulation * const T, std::vector<Vertex*> const &vertices,
+	std::unordered_map<uint64_t, TEdge*> &edges, const int a, const int b){
+
+	uint64_t key = ringEdgeKey(a, b);
+	TEdge *e;
+
+	auto it = edges.find(key);
+	if(it != edges.end())
+		return (*it).second;
+
+	e = new TEdge(vertices[a], vertices[b]);
+	(*T).addEdge(e, 0);
+	edges[key] = e;
+
+	return e;
+}
+
+/*
+	The function triangulateRingDomain() triangulates one domain of the polygon and
+	generates its triangles. It errors with exit code 21 if the sweep fails.
+
+	@param 	T 			The triangulation the triangles live in
+	@param 	points 		The coordinates of all vertices
+	@param 	vertices 	The vertices indexed like points
+	@param 	edges 		The already generated edges by the indices of their vertices
+	@param 	domain 		The rings of the domain as required by triangulateDomain()
+	@param 	internal 	Whether the domain is the inside of the polygon
+*/
+static void triangulateRingDomain(Triangulation * const T, std::vector<point> const &points,
+	std::vector<Vertex*> const &vertices, std::unordered_map<uint64_t, TEdge*> &edges,
+	std::vector<std::vector<int>> const &domain, const bool internal){
+
+	std::vector<int> triangles;
+	unsigned int i;
+	int a, b, c;
+
+	if(!triangulateDomain(points, domain, triangles)){
+		if(Settings::inputFile != NULL)
+			fprintf(stderr, "Triangulating the polygon of %s failed: the polygons are not simple, intersect each other or a hole lies outside of the polygon\n",
+				Settings::inputFile);
+		else
+			fprintf(stderr, "Triangulating the start polygon failed: the polygon is not simple\n");
+		exit(21);
+	}
+
+	for(i = 0; i < triangles.size(); i = i + 3){
+		a = triangles[i];
+		b = triangles[i + 1];
+		c = triangles[i + 2];
+
+		new Triangle(getRingEdge(T, vertices, edges, a, b), getRingEdge(T, vertices, edges, b, c),
+			getRingEdge(T, vertices, edges, c, a), vertices[a], vertices[b], vertices[c],
+			internal);
+	}
+}
+
+/*
+	The function generateFromInput() generates a new triangulation with the polygon and
+	the holes read from the input file (Settings::inputRings).
+
+	@return		The generated triangulation
+*/
+Triangulation *generateFromInput(){
+	Triangulation *T = generateFromRings(Settings::inputRings);
+
+	Settings::inputRings.clear();
+	Settings::inputRings.shrink_to_fit();
+
+	return T;
+}
+
+
+/*
+	The function generateStarPolygon() generates a new triangulation with a random
+	star-shaped start polygon of Settings::initialSize vertices. The vertices get one
+	random angle in each of n equally sized sectors around the origin and a random distance
+	to the origin between a sixth and a third of the edge length of the box, such that the
+	polygon is simple by construction and already spans most of the box.
+
+	@return		The generated triangulation
+*/
+Triangulation *generateStarPolygon(){
+	double alpha;
+	double radius = Settings::boxSize / 3;
+	unsigned int i;
+	unsigned int n = Settings::initialSize;
+	std::vector<double> offsets(n);
+	std::vector<double> radii(n);
+	std::vector<std::vector<point>> rings(1);
+
+	// Keep a gap between neighbouring sectors, such that no two vertices get too close
+	(*Settings::generator).fillUniform(offsets.data(), n, 0.1, 0.9);
+	(*Settings::generator).fillUniform(radii.data(), n, radius / 2, radius);
+
+	rings[0].reserve(n);
+	for(i = 0; i < n; i++){
+		alpha = 2 * M_PI * (i + offsets[i]) / n;
+		rings[0].push_back({radii[i] * cos(alpha), radii[i] * sin(alpha)});
+	}
+
+	return generateFromRings(rings);
+}
+
+
+/*
+	The function generateFromRings() generates a new triangulation with the polygon and the
+	holes given by their rings. It boxes the polygon by a square which gets enlarged if the
+	polygon does not fit into the default box and triangulates the inside of the polygon,
+	the holes and the area between the polygon and the square by a sweep in O(n log n)
+	time. It errors with exit code 21 if the rings do not form a valid polygon.
+
+	@param 	input 	The rings, the first one is the outer polygon in counterclockwise
+					order, the others are the holes in clockwise order
+	@return			The generated triangulation
+*/
+Triangulation *generateFromRings(std::vector<std::vector<point>> const &input){
+	double maxCoord = 0;
+	double b;
+	unsigned int i, j, n;
+	Vertex *v;
+	TEdge *e;
+	std::vector<point> points;
+	std::vector<Vertex*> vertices;
+	std::vector<std::vector<int>> rings;
+	std::vector<std::vector<int>> domain;
+	std::unordered_map<uint64_t, TEdge*> edges;
+	Triangulation* T = new Triangulation();
+
+	// Enlarge the box if the polygon does not fit into it
+	for(auto const& ring : input)
+		for(auto const& p : ring)
+			maxCoord = std::max(maxCoord, std::max(fabs(p.x), fabs(p.y)));
+
+	if(2 * maxCoord >= Settings::boxSize)
+		Settings::boxSize = 3 * maxCoord;
+
+	/* 
+		Generate the rectangle in the same orientation as boxPolygon():
+
+		1 - 0
+		|   |
+		2 - 3
+	*/
+	b = Settings::boxSize / 2;
+	points = {{b, b}, {- b, b}, {- b, - b}, {b, - b}};
+	for(auto const& p : points)
+		vertices.push_back(new Vertex(p.x, p.y, true));
+	(*T).setRectangle(vertices[0], vertices[1], vertices[2], vertices[3]);
+
+	for(i = 0; i < 4; i++){
+		e = new TEdge(vertices[i], vertices[(i + 1) % 4], EdgeType::FRAME);
+		(*T).addEdge(e, 0);
+		edges[ringEdgeKey(i, (i + 1) % 4)] = e;
+	}
+
+	// Add the vertices and the edges of the polygon and the holes, which are already
+	// oriented like the ones of the regular polygon
+	for(i = 0; i < input.size(); i++){
+		if(i > 0)
+			(*T).addInnerPolygon(new TPolygon(T, i, Settings::innerSizes[i - 1]));
+
+		rings.emplace_back();
+		for(auto const& p : input[i]){
+			v = new Vertex(p.x, p.y);
+			(*T).addVertex(v, i);
+
+			rings.back().push_back(points.size());
+			points.push_back(p);
+			vertices.push_back(v);
+		}
+
+		n = rings.back().size();
+		for(j = 0; j < n; j++){
+			e = new TEdge(vertices[rings[i][j]], vertices[rings[i][(j + 1) % n]], EdgeType::POLYGON);
+			(*T).addEdge(e, i);
+			edges[ringEdgeKey(rings[i][j], rings[i][(j + 1) % n])] = e;
+		}
+	}
+
+	// The area between the square and the polygon
+	domain.push_back({0, 1, 2, 3});
+	domain.push_back(std::vector<int>(rings[0].rbegin(), rings[0].rend()));
+	triangulateRingDomain(T, points, vertices, edges, domain, false);
+
+	// The inside of the polygon
+	triangulateRingDomain(T, points, vertices, edges, rings, true);
+
+	// The insides of the holes
+	for(i = 1; i < rings.size(); i++){
+		domain.clear();
+		domain.push_back(std::vector<int>(rings[i].rbegin(), rings[i].rend()));
+		triangulateRingDomain(T, points, vertices, edges, domain, false);
+	}
+
+	return T;
+}
+
+
 /*
 	The function initialTriangulationPseudoStar adds the polygon edges to the
 	vertices of a regular shaped polygon with no holes. Then it moves the
@@ -204,7 +422,8 @@ void generateInitialHoleTriangle(Triangulation * const T){
 	TEdge *start, *triangleE0, *triangleE1, *triangleE2;
 
 	// Add an inner polygon to the triangulation
-	(*T).addInnerPolygon(new TPolygon(T, Settings::innerSizes[0]));
+	(*T).addInnerPolygon(new TPolygon(T, (*T).getActualNrInnerPolygons() + 1,
+		Settings::innerSizes[0]));
 
 	alpha = 2 * M_PI / 3;
 
@@ -371,7 +590,8 @@ void splitHoleTriangle(Triangulation * const T){
 	y2 = (*v2).getY();
 
 	// Add a new inner polygon
-	(*T).addInnerPolygon(new TPolygon(T, Settings::innerSizes[n]));
+	(*T).addInnerPolygon(new TPolygon(T, (*T).getActualNrInnerPolygons() + 1,
+		Settings::innerSizes[n]));
 
 
 	/*
@@ -16,6 +16,100 @@
  */
 
 #include "insertion.h"
+#include "polygonTransformer.h"
+
+/*
+	P ~ R ~ I ~ V ~ A ~ T ~ E 	M ~ E ~ M ~ B ~ E ~ R 	F ~ U ~ N ~ C ~ T ~ I ~ O ~ N ~ S
+*/
+
+/*
+	The function getRangeAtMiddle() computes the estimate getDirectedEdgeLength() would
+	return for a vertex inserted at the middle of the edge, without inserting it. The
+	middle vertex would be incident to the four triangles formed by it, one of the
+	vertices of the edge and one of the vertices opposite to the edge.
+
+	@param 	x 		The x-coordinate of the middle of the edge
+	@param 	y 		The y-coordinate of the middle of the edge
+	@param 	alpha 	The direction of the planned translation
+	@param 	other0 	The vertex of the first triangle opposite to the edge
+	@param 	other1 	The vertex of the second triangle opposite to the edge
+	@return 		Mean length of the two edges of the middle vertex bounding the triangle
+					in direction alpha
+*/
+double Insertion::getRangeAtMiddle(const double x, const double y, const double alpha,
+	Vertex const * const other0, Vertex const * const other1) const{
+
+	Vertex const *a[4] = {v0, v0, v1, v1};
+	Vertex const *b[4] = {other0, other1, other0, other1};
+	double alpha1, alpha2, l, sum = 0;
+	int i;
+
+	for(i = 0; i < 4; i++){
+		alpha1 = atan2((*a[i]).getY() - y, (*a[i]).getX() - x);
+		alpha2 = atan2((*b[i]).getY() - y, (*b[i]).getX() - x);
+
+		// Order alpha1 and alpha2
+		if(alpha1 < alpha2){
+			l = alpha1;
+			alpha1 = alpha2;
+			alpha2 = l;
+		}
+
+		l = (hypot((*a[i]).getX() - x, (*a[i]).getY() - y) +
+			hypot((*b[i]).getX() - x, (*b[i]).getY() - y)) / 2;
+		sum = sum + l;
+
+		// The same case distinction as in Triangle::getRange()
+		if(alpha1 - alpha2 <= M_PI){
+			if(alpha <= alpha1 && alpha >= alpha2)
+				return l;
+		}else{
+			if(alpha >= alpha1 || alpha <= alpha2)
+				return l;
+		}
+	}
+
+	// Just reachable by numerical problems
+	return sum / 4;
+}
+
+/*
+	The function isSuitableFan() checks whether the triangles formed by the new vertex and
+	each two consecutive corners of a chain have all the same orientation, i.e. whether
+	connecting the new vertex to the corners gives a valid triangulation of the area the
+	chain bounds together with the new vertex. In case we use the double arithmetics, the
+	determinants of the triangles must be at least Settings::minDetInsertion.
+
+	@param 	corners 	The corners of the chain
+	@param 	n 			The number of corners
+	@return 			True if the triangles are suitable, otherwise false
+
+	Note:
+		A closed chain, i.e. one with the same first and last corner, checks whether the
+		new vertex lies in the interior of the triangle formed by the chain
+*/
+bool Insertion::isSuitableFan(Vertex * const * const corners, const int n) const{
+	Triangle *t;
+	double area, first = 0;
+	int i;
+
+	for(i = 0; i < n - 1; i++){
+		t = new Triangle(corners[i], corners[i + 1], newV);
+		area = (*t).signedArea();
+		delete t;
+
+		if(area == 0 || (i > 0 && signbit(area) != signbit(first)))
+			return false;
+
+		if(Settings::arithmetics == Arithmetics::DOUBLE && fabs(area) < Settings::minDetInsertion)
+			return false;
+
+		first = area;
+	}
+
+	return true;
+}
+
 
 /*
 	C ~ O ~ N ~ S ~ T ~ R ~ U ~ C ~ T ~ O ~ R ~ S
@@ -31,11 +125,13 @@
 	@param 	index 	The index of the vertex
 */
 Insertion::Insertion(Triangulation * const t, const unsigned int pid, const int index) :
-	T(t), pID(pid) {
+	T(t), pID(pid), newV(NULL), newIndex(-1) {
 
 	v0 = (*T).getVertex(index, pID);
 	v1 = (*v0).getNext();
 	e = (*v0).getToNext();
+
+	created = std::chrono::steady_clock::now();
 }
 
 /*
@@ -48,10 +144,24 @@ Insertion::Insertion(Triangulation * const t, const unsigned int pid, const int
 	@param 	e 	 	The edge to insert in
 */
 Insertion::Insertion(Triangulation * const t, const unsigned int pid, TEdge *edge) :
-	T(t), pID(pid), e(edge){
+	T(t), pID(pid), e(edge), newV(NULL), newIndex(-1) {
 
 	v0 = (*e).getV0();
 	v1 = (*e).getV1();
+
+	created = std::chrono::steady_clock::now();
+}
+
+
+/*
+	G ~ E ~ T ~ T ~ E ~ R ~ S
+*/
+
+/*
+	@return 	The inserted vertex, NULL before the execution
+*/
+Vertex *Insertion::getNewVertex() const{
+	return newV;
 }
 
 
@@ -66,27 +176,20 @@ Insertion::Insertion(Triangulation * const t, const unsigned int pid, TEdge *edg
 	adjacent triangles' determinants must be at least Settings::minDetInsertion.
 
 	@return 	True if the chosen edge fulfills the criteria, otherwise false
+
+	Note:
+		- Edges which do not fulfill the criteria have weight 0 in the SelectionTree of the
+			polygon, so the SelectionTree never returns them
+		- A failed check gets counted as rejection in the statistics
 */
 bool Insertion::checkStability() const{
-	double l = (*e).length();
-	Triangle *t;
-
-	// Check the length of the edge
-	if(l < Settings::minLength)
-		return false;
+	if((*e).isSuitableForInsertion())
+		return true;
 
-	// Check the triangle areas
-	if(Settings::arithmetics == Arithmetics::DOUBLE){
-		t = (*e).getT0();
-		if(fabs((*t).signedArea()) < Settings::minDetInsertion)
-			return false;
-
-		t = (*e).getT1();
-		if(fabs((*t).signedArea()) < Settings::minDetInsertion)
-			return false;
-	}
+	Statistics::addRejection(Rejection::STABILITY,
+		std::chrono::duration<double>(std::chrono::steady_clock::now() - created).count());
 
-	return true;
+	return false;
 }
 
 /*
@@ -96,6 +199,7 @@ bool Insertion::checkStability() const{
 	and generate the new triangles for this quadrilateral.
 */
 void Insertion::execute(){
+	ScopedTimer timer(ProfileSection::INSERTIONEXECUTE);
 	Triangle *t0, *t1;
 	double x, y;
 	Vertex *other0, *other1;
@@ -112,6 +216,9 @@ void Insertion::execute(){
 	newV = new Vertex(x, y);
 	(*T).addVertex(newV, pID);
 
+	// The new vertex is the last one in the vertices vector of the triangulation
+	newIndex = (*T).getActualNumberOfVertices() - 1;
+
 	t0 = (*e).getT0();
 	t1 = (*e).getT1();
 
@@ -150,77 +257,339 @@ void Insertion::execute(){
 	new Triangle(fromV1ToNew, fromV1ToOther1, fromNewToOther1, v1, newV, other1, internal1);
 }
 
+/*
+	The function executeDirect() inserts a vertex at a random position inside one of the
+	two triangles incident to the chosen edge, so it does not have to be translated
+	afterwards. The position is drawn as the middle of the edge plus a translation
+	generated in the same way translate() generates it. The new vertex gets connected to
+	the vertices of the triangle containing it and, if it is visible, to the vertex of the
+	other triangle opposite to the edge. Otherwise the chosen edge stays as triangulation
+	edge. If the position is not inside one of the triangles, the vertex gets inserted at
+	the middle of the edge and the drawn translation gets tried by tryTranslation(),
+	followed by translate() if it gets rejected.
+
+	Note:
+		- A translation staying inside the two triangles is always accepted by translate(),
+			so the positions and the consumed random numbers are the same as for the two
+			step insertion
+		- The resulting triangulation may differ from the one of the two step insertion
+*/
+void Insertion::executeDirect(){
+	ScopedTimer timer(ProfileSection::INSERTIONEXECUTE);
+	Triangle *t0, *t1, *t = NULL;
+	double x, y, alpha, stddev, r, dx, dy, tx, ty, cosAlpha, sinAlpha, z;
+	int index;
+	Vertex *other0, *other1, *other, *opposite;
+	TEdge *fromV0ToOther, *fromV1ToOther, *fromV0ToOpposite, *fromV1ToOpposite;
+	TEdge *fromV0ToNew, *fromV1ToNew, *fromNewToOther, *fromNewToOpposite, *fromV0ToV1;
+	bool internal, internalOpposite, visible;
+	unsigned int count = 0;
+	Executed ex;
+
+	// Calculate the coordinates of the middle of the edge
+	x = (*v0).getX() + ((*v1).getX() - (*v0).getX()) / 2;
+	y = (*v0).getY() + ((*v1).getY() - (*v0).getY()) / 2;
+
+	t0 = (*e).getT0();
+	t1 = (*e).getT1();
+
+	other0 = (*t0).getOtherVertex(e);
+	other1 = (*t1).getOtherVertex(e);
+
+	Vertex * const inT0[4] = {v0, v1, other0, v0};
+	Vertex * const inT1[4] = {v0, v1, other1, v0};
+
+	if(Settings::insertionTries == 0){
+		execute();
+		return;
+	}
+
+	// Generate the translation as translate() would do it
+	if(Settings::proposals != NULL){
+		(*Settings::proposals).setRange(0);
+		(*Settings::proposals).next(index, alpha, cosAlpha, sinAlpha, z);
+		stddev = getRangeAtMiddle(x, y, alpha, other0, other1);
+		r = ProposalBuffer::getDistance(stddev / 2, stddev / 6, z);
+	}else{
+		alpha = (*Settings::generator).getDoubleUniform(- M_PI, M_PI);
+		stddev = getRangeAtMiddle(x, y, alpha, other0, other1);
+		r = (*Settings::generator).getDoubleNormal(stddev / 2, stddev / 6);
+		cosAlpha = cos(alpha);
+		sinAlpha = sin(alpha);
+	}
+
+	dx = r * cosAlpha;
+	dy = r * sinAlpha;
+	getEffectiveTranslation(dx, dy, tx, ty);
+
+	// Generate the new vertex, it gets not added to the triangulation before its position
+	// is checked
+	newV = new Vertex(x + tx, y + ty);
+
+	if(isSuitableFan(inT0, 4))
+		t = t0;
+	else if(isSuitableFan(inT1, 4))
+		t = t1;
+
+	// Continue as two step insertion if the position is not inside one of the triangles
+	if(t == NULL){
+		delete newV;
+		execute();
+
+		ex = tryTranslation(T, newIndex, dx, dy);
+		count++;
+
+		if(!(ex == Executed::FULL || ex == Executed::PARTIAL))
+			translate(Settings::generator, -1, count);
+
+		if(Settings::feedback == FeedbackMode::VERBOSE && count == Settings::insertionTries)
+			fprintf(stderr, "Warning: Was not able to find a suitable translation after the insertion!\n");
+
+		return;
+	}
+
+	(*T).addVertex(newV, pID);
+
+	// The new vertex is the last one in the vertices vector of the triangulation
+	newIndex = (*T).getActualNumberOfVertices() - 1;
+
+	// Get the vertex of the triangle containing the new vertex and the vertex of the other
+	// triangle opposite to the edge
+	if(t == t0){
+		other = other0;
+		opposite = other1;
+	}else{
+		other = other1;
+		opposite = other0;
+	}
+	internal = (*t).isInternal();
+	internalOpposite = (*(t == t0 ? t1 : t0)).isInternal();
+
+	// Check whether the new vertex can be connected to the opposite vertex
+	Vertex * const acrossEdge[3] = {v0, opposite, v1};
+	visible = isSuitableFan(acrossEdge, 3);
+
+	// Delete the edge and the old triangles with it
+	delete e;
+
+	// Get the four edges of the surrounding quadrilateral
+	fromV0ToOther = (*v0).getEdgeTo(other);
+	fromV1ToOther = (*v1).getEdgeTo(other);
+	fromV0ToOpposite = (*v0).getEdgeTo(opposite);
+	fromV1ToOpposite = (*v1).getEdgeTo(opposite);
+
+	// Generate the edges of the new vertex
+	fromV0ToNew = new TEdge(v0, newV, EdgeType::POLYGON);
+	fromV1ToNew = new TEdge(newV, v1, EdgeType::POLYGON);
+	(*T).addEdge(fromV0ToNew, pID);
+	(*T).addEdge(fromV1ToNew, pID);
+
+	fromNewToOther = new TEdge(newV, other);
+	(*T).addEdge(fromNewToOther, 0);
+
+	// Generate the triangles on the side of the triangle containing the new vertex
+	new Triangle(fromV0ToNew, fromV0ToOther, fromNewToOther, v0, newV, other, internal);
+	new Triangle(fromV1ToNew, fromV1ToOther, fromNewToOther, v1, newV, other, internal);
+
+	// Generate the triangles on the other side, either by connecting the new vertex to the
+	// opposite vertex or by keeping the chosen edge as triangulation edge
+	if(visible){
+		fromNewToOpposite = new TEdge(newV, opposite);
+		(*T).addEdge(fromNewToOpposite, 0);
+
+		new Triangle(fromV0ToNew, fromV0ToOpposite, fromNewToOpposite, v0, newV, opposite,
+			internalOpposite);
+		new Triangle(fromV1ToNew, fromV1ToOpposite, fromNewToOpposite, v1, newV, opposite,
+			internalOpposite);
+	}else{
+		fromV0ToV1 = new TEdge(v0, v1);
+		(*T).addEdge(fromV0ToV1, 0);
+
+		new Triangle(fromV0ToNew, fromV1ToNew, fromV0ToV1, v0, newV, v1, internalOpposite);
+		new Triangle(fromV0ToV1, fromV0ToOpposite, fromV1ToOpposite, v0, v1, opposite,
+			internalOpposite);
+	}
+}
+
 /*
 	The function translate() tries to move the new vertex away from the edge.
 	Therefore it tries up to Settings::insertionTries times to find a translation
 	which leads to a simple polygon and execute it. If it has not found a suitable
 	translation till the limit is reached, the new vertex will just stay were it is.
+
+	Note:
+		In the speculative parallel mode it calls translateSpeculative() instead
 */
 void Insertion::translate() const{
-	int index;
-	bool orientationChange, simple = false;
-	double alpha, stddev, r, dx, dy;
-	Translation *trans;
 	unsigned int count = 0;
+
+	if(Settings::parallelMode == ParallelMode::SPECULATIVE && parallelTranslationsApplicable(T)){
+		translateSpeculative();
+		return;
+	}
+
+	translate(Settings::generator, -1, count);
+
+	if(Settings::feedback == FeedbackMode::VERBOSE && count == Settings::insertionTries)
+		fprintf(stderr, "Warning: Was not able to find a suitable translation after the insertion!\n");
+}
+
+/*
+	The function translate() tries translations of the new vertex drawn from gen until
+	one gets executed or the number of tries reaches Settings::insertionTries. If a
+	region is given, it stops as soon as a translation would leave the region.
+
+	@param 	gen 	The random generator the translations get drawn from
+	@param 	region 	The region the translations must stay in, -1 for no restriction
+	@param 	count 	The number of tries so far, gets increased by each try
+	@return 		False if it stopped because a translation would leave the region,
+					otherwise true
+
+	Note:
+		- A translation which would leave the region does not count as try, so the tries
+			can be continued without restriction later on
+		- If a log gets replayed, the translations are taken from the MoveLog instead of gen
+		- If batched proposals are enabled and gen is the global RandomGenerator, the
+			directions and distances are taken from the ProposalBuffer, the generators split
+			off for the bulk growth are still drawn from directly
+*/
+bool Insertion::translate(RandomGenerator * const gen, const int region, unsigned int &count) const{
+	ScopedTimer timer(ProfileSection::INSERTIONTRANSLATE);
+	double alpha, stddev, r, dx, dy, tx, ty, cosAlpha, sinAlpha, z;
+	int index;
 	Executed ex = Executed::REJECTED;
+	ProposalBuffer *buffer = gen == Settings::generator ? Settings::proposals : NULL;
 
-	// The new vertex is the last one in the vertices vector of the triangulation
-	index = (*T).getActualNumberOfVertices() - 1;
+	if(buffer != NULL)
+		(*buffer).setRange(0);
 
 	while(!(ex == Executed::FULL || ex == Executed::PARTIAL) && count < Settings::insertionTries){
-		// Chose a random direction for the movement
-		alpha = (*Settings::generator).getDoubleUniform(- M_PI, M_PI);
-		// Compute suitable distribution parameters
-		stddev = (*newV).getDirectedEdgeLength(alpha);
+		// Take the translation from the replayed log, which ends the tries if the recorded
+		// run has not tried any more translations
+		if(MoveLog::replaying){
+			if(!MoveLog::nextInsertionMove(newV, dx, dy))
+				break;
+		}else if(buffer != NULL){
+			// Take the direction and the distance from the buffered proposals
+			(*buffer).next(index, alpha, cosAlpha, sinAlpha, z);
+			stddev = (*newV).getDirectedEdgeLength(alpha);
+			r = ProposalBuffer::getDistance(stddev / 2, stddev / 6, z);
+
+			dx = r * cosAlpha;
+			dy = r * sinAlpha;
+		}else{
+			// Chose a random direction for the movement
+			alpha = (*gen).getDoubleUniform(- M_PI, M_PI);
+			// Compute suitable distribution parameters
+			stddev = (*newV).getDirectedEdgeLength(alpha);
+
+			// Generate the translation distance
+			r = (*gen).getDoubleNormal(stddev / 2, stddev / 6);
+
+			// Split the translation in x- and y-components
+			dx = r * cos(alpha);
+			dy = r * sin(alpha);
+		}
 
-		// Generate the translation distance
-		r = (*Settings::generator).getDoubleNormal(stddev / 2, stddev / 6);
+		if(region != -1){
+			getEffectiveTranslation(dx, dy, tx, ty);
 
-		// Split the translation in x- and y-components
-		dx = r * cos(alpha);
-		dy = r * sin(alpha);
-
-		if(Settings::kinetic)
-			trans = new TranslationKinetic(T, index, dx, dy);
-		else
-			trans = new TranslationRetriangulation(T, index, dy, dx);
-
-		// Check for a potential orientation change
-		orientationChange = (*trans).checkOrientation();
-
-		if(!orientationChange){
-			// Check the simplicity of the translation
-			simple = (*trans).checkSimplicityOfTranslation();
-
-			// Execute the translation
-			if(simple)
-				ex = (*trans).execute();
-
-			// Count executed translations
-			if(ex != Executed::REJECTED){
-			
-				switch(ex){
-					case Executed::FULL:
-						Statistics::translationsPerf++;
-						break;
-					case Executed::PARTIAL:
-						Statistics::translationsPerf++;
-						break;
-					case Executed::UNDONE:
-						Statistics::undone++;
-						break;
-					case Executed::REJECTED:
-					default:
-						break;
-				}
-			}
+			if(!checkRegion(newV, tx, ty, region))
+				return false;
+		}
+
+		ex = tryTranslation(T, newIndex, dx, dy);
+
+		count++;
+	}
+
+	return true;
+}
+
+/*
+	The function translateSpeculative() does the same as translate(), but tries just the
+	first candidate translation directly. If it gets rejected, it checks batches of four
+	candidate translations concurrently and executes the first one which passes the checks.
+	The candidates get generated in the same order as by translate(), so the same
+	translation gets selected.
+
+	Note:
+		- Most insertions pass the first candidate, so they neither wait for the worker pool
+			nor generate more candidates than translate()
+		- The remaining candidates of a batch get dropped after an execution, as it
+			changes the surrounding of the new vertex
+		- As a batch generates more candidates than it tries, the following random numbers
+			differ from translate(). The batch size does not depend on the number of
+			threads, so for a fixed seed neither does the result.
+		- This function works just for polygons without holes!
+*/
+void Insertion::translateSpeculative() const{
+	ScopedTimer timer(ProfileSection::INSERTIONTRANSLATE);
+	const unsigned int batchSize = 4;
+	int size, i;
+	unsigned int count = 0;
+	Executed ex = Executed::REJECTED;
+	WorkerPool *pool = getWorkerPool();
+	std::vector<double> dx(batchSize), dy(batchSize);
+	std::vector<SpeculativeCheck> checks(batchSize);
+
+	// Generates the next candidate in the same way as translate()
+	auto generate = [&](double &x, double &y){
+		double alpha, stddev, r, cosAlpha, sinAlpha, z;
+		int index;
+
+		if(Settings::proposals != NULL){
+			(*Settings::proposals).next(index, alpha, cosAlpha, sinAlpha, z);
+			stddev = (*newV).getDirectedEdgeLength(alpha);
+			r = ProposalBuffer::getDistance(stddev / 2, stddev / 6, z);
+		}else{
+			alpha = (*Settings::generator).getDoubleUniform(- M_PI, M_PI);
+			stddev = (*newV).getDirectedEdgeLength(alpha);
+			r = (*Settings::generator).getDoubleNormal(stddev / 2, stddev / 6);
+			cosAlpha = cos(alpha);
+			sinAlpha = sin(alpha);
 		}
 
-		delete trans;
+		x = r * cosAlpha;
+		y = r * sinAlpha;
+	};
+
+	if(Settings::proposals != NULL)
+		(*Settings::proposals).setRange(0);
 
+	// Try the first candidate directly
+	if(count < Settings::insertionTries){
+		generate(dx[0], dy[0]);
+		ex = tryTranslation(T, newIndex, dx[0], dy[0]);
 		count++;
 	}
 
+	while(!(ex == Executed::FULL || ex == Executed::PARTIAL) && count < Settings::insertionTries){
+		size = std::min(batchSize, Settings::insertionTries - count);
+
+		// Generate the candidates of the batch
+		for(i = 0; i < size; i++)
+			generate(dx[i], dy[i]);
+
+		(*pool).run(size, [&](const int k){
+			precheckTranslation(T, newV, dx[k], dy[k], checks[k]);
+		});
+
+	// Execute the first candidate which passed the checks
+		for(i = 0; i < size; i++){
+			count++;
+
+			if(!checks[i].accepted){
+				Statistics::translationTries++;
+				Statistics::addRejection(checks[i].rejection, checks[i].time);
+				continue;
+			}
+
+			ex = tryTranslation(T, newIndex, dx[i], dy[i], true, checks[i].triangles);
+			break;
+		}
+	}
+
 	if(Settings::feedback == FeedbackMode::VERBOSE && count == Settings::insertionTries)
 		fprintf(stderr, "Warning: Was not able to find a suitable translation after the insertion!\n");
 }
@@ -51,6 +51,8 @@ code 	name						meaning
 15 		Polygon build error 		Something went wrong while building a polygon to retriangulate
 16 		Missing kernel 				Start-shaped polygon can not be triangulated, because no kernel point is given
 17		Selection tree error
+21		Input error					The polygon file given by --input can not be read, a ring has less
+									than three vertices or the rings do not form a valid polygon
 */
 
 int main(int argc, char *argv[]){
@@ -62,13 +64,30 @@ int main(int argc, char *argv[]){
 	if(Settings::feedback != FeedbackMode::MUTE)
 			Settings::printSettings();
 
-	T = generateRegularPolygon();
+	if(Settings::inputFile != NULL)
+		T = generateFromInput();
+	else if(Settings::startShape == StartShape::STAR)
+		T = generateStarPolygon();
+	else
+		T = generateRegularPolygon();
 
 	(*T).check();
 
-	if(Settings::feedback != FeedbackMode::MUTE)
-		fprintf(stderr, "Initial polygon with %d vertices in regular shape computed after %f seconds\n\n",
-			Settings::initialSize, (*Settings::timer).elapsedTime());
+	if(Settings::feedback != FeedbackMode::MUTE){
+		if(Settings::inputFile != NULL)
+			fprintf(stderr, "Initial polygon with %d vertices read from %s after %f seconds\n\n",
+				Settings::initialSize, Settings::inputFile, (*Settings::timer).elapsedTime());
+		else if(Settings::startShape == StartShape::STAR)
+			fprintf(stderr, "Initial polygon with %d vertices in star shape computed after %f seconds\n\n",
+				Settings::initialSize, (*Settings::timer).elapsedTime());
+		else
+			fprintf(stderr, "Initial polygon with %d vertices in regular shape computed after %f seconds\n\n",
+				Settings::initialSize, (*Settings::timer).elapsedTime());
+	}
+
+	// Keep the shape of the start polygon for comparing it to the final one
+	if(Settings::enableStats)
+		Statistics::calculateStartShape(T);
 
 	if(Settings::nrInnerPolygons == 0)
 		strategyNoHoles0(T);
@@ -77,14 +96,19 @@ int main(int argc, char *argv[]){
 	else
 		strategyWithHoles1(T);
 
-	switch (Settings::outputFormat) {
-		case OutputFormat::DAT: (*T).writePolygonToDat(Settings::polygonFile); break;
-		case OutputFormat::LINE: (*T).writePolygonToLine(Settings::polygonFile); break;
-		case OutputFormat::GRAPHML: (*T).writePolygon(Settings::polygonFile); break;
-	};
+	{
+		ScopedTimer timer(ProfileSection::OUTPUT);
 
-	if(Settings::triangulationOutputRequired)
-		(*T).writeTriangulation(Settings::triangulationFile);
+		switch (Settings::outputFormat) {
+			case OutputFormat::DAT: (*T).writePolygonToDat(Settings::polygonFile); break;
+			case OutputFormat::LINE: (*T).writePolygonToLine(Settings::polygonFile); break;
+			case OutputFormat::GRAPHML: (*T).writePolygon(Settings::polygonFile); break;
+			case OutputFormat::BIN: (*T).writePolygonToBinary(Settings::polygonFile); break;
+		};
+
+		if(Settings::triangulationOutputRequired)
+			(*T).writeTriangulation(Settings::triangulationFile);
+	}
 
 	if(Settings::enableStats){
 		Statistics::calculateMaxTwist(T);
@@ -98,6 +122,14 @@ int main(int argc, char *argv[]){
 		if(Settings::statisticsFile != NULL)
 			Statistics::writeStatsFile(T);
 	}
+
+	if(Settings::profileFile != NULL)
+		Profiler::writeReport(Settings::profileFile);
+
+	if(Settings::traceFile != NULL)
+		Tracer::write(Settings::traceFile);
+
+	MoveLog::close();
 	
 	exit(0);
 }
@@ -0,0 +1,421 @@
+/*
+ * Copyright 2021 Philipp Mayer - pmayer@cs.sbg.ac.at
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "moveLog.h"
+#include "polygonTransformer.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+	S ~ T ~ A ~ T ~ I ~ C 	V ~ A ~ R ~ I ~ A ~ B ~ L ~ E ~ S
+*/
+
+/*
+	The flags whether a log gets recorded or replayed
+*/
+bool MoveLog::recording = false;
+bool MoveLog::replaying = false;
+
+/*
+	The file the log gets written to or read from
+*/
+FILE *MoveLog::file = NULL;
+
+/*
+	True while the translations belong to a vertex which has just been inserted
+*/
+bool MoveLog::inInsertion = false;
+
+/*
+	The next record of the replayed log, for insertions nextOutcome holds whether the edge
+	has been stable
+*/
+bool MoveLog::buffered = false;
+LogRecord MoveLog::kind = LogRecord::MOVE;
+unsigned int MoveLog::nextPID = 0;
+int MoveLog::nextIndex = 0;
+double MoveLog::nextDx = 0;
+double MoveLog::nextDy = 0;
+double MoveLog::nextScale = 0;
+unsigned char MoveLog::nextOutcome = 0;
+
+/*
+	The outcome of the last replayed translation
+*/
+unsigned char MoveLog::lastOutcome = 0;
+
+/*
+	The statistics of the replay
+*/
+unsigned long long MoveLog::replayed = 0;
+unsigned long long MoveLog::diverged = 0;
+unsigned long long MoveLog::skipped = 0;
+
+/*
+	The first bytes of each log
+*/
+static const char magic[8] = {'F', 'P', 'G', 'M', 'O', 'V', 'E', '1'};
+
+
+/*
+	P ~ R ~ I ~ V ~ A ~ T ~ E 	M ~ E ~ M ~ B ~ E ~ R 	F ~ U ~ N ~ C ~ T ~ I ~ O ~ N ~ S
+*/
+
+/*
+	The function peek() reads the next record of the replayed log if it is not already
+	buffered.
+
+	@return 	True if there is a next record, false at the end of the log
+*/
+bool MoveLog::peek(){
+	unsigned char buffer[30];
+	size_t size;
+	int c;
+
+	if(buffered)
+		return true;
+
+	c = fgetc(file);
+	if(c == EOF)
+		return false;
+
+	kind = (LogRecord)c;
+
+	switch(kind){
+		case LogRecord::MOVE:
+		case LogRecord::INSERTIONMOVE:
+			size = 4 + 8 + 8 + 8 + 1 + 1;
+			if(fread(buffer, 1, size, file) != size)
+				mismatch("complete record");
+
+			memcpy(&nextIndex, buffer, 4);
+			memcpy(&nextDx, buffer + 4, 8);
+			memcpy(&nextDy, buffer + 12, 8);
+			memcpy(&nextScale, buffer + 20, 8);
+			nextOutcome = buffer[29];
+			break;
+		case LogRecord::INSERTION:
+			size = 4 + 4 + 1;
+			if(fread(buffer, 1, size, file) != size)
+				mismatch("complete record");
+
+			memcpy(&nextPID, buffer, 4);
+			memcpy(&nextIndex, buffer + 4, 4);
+			nextOutcome = buffer[8];
+			break;
+		default:
+			mismatch("known record");
+	}
+
+	buffered = true;
+	return true;
+}
+
+/*
+	The function mismatch() errors with exit code 20 as the replayed log does not fit to
+	the actual run.
+
+	@param 	expected 	The name of the expected record
+*/
+void MoveLog::mismatch(const char *expected){
+	fprintf(stderr, "Replay error: the log does not fit to the run, expected record: %s\n", expected);
+	exit(20);
+}
+
+/*
+	The function takeTranslation() returns the translation vector of the buffered record
+	for the actual run, i.e. scaled by the ratio of the actual and the recorded scale.
+
+	@param 	v 	The moving vertex
+	@param 	dx 	The generated x-component of the translation vector
+	@param 	dy 	The generated y-component of the translation vector
+*/
+void MoveLog::takeTranslation(Vertex const * const v, double &dx, double &dy){
+	double scale;
+
+	lastOutcome = nextOutcome;
+	buffered = false;
+
+	// The effective translation vector is its own inverse
+	getEffectiveTranslation(nextDx, nextDy, dx, dy);
+
+	// Unchanged surroundings give exactly the same scale, so the translation is replayed
+	// exactly as recorded
+	scale = getScale(v, dx, dy);
+	if(nextScale > 0 && scale != nextScale){
+		dx = dx * scale / nextScale;
+		dy = dy * scale / nextScale;
+	}
+}
+
+
+/*
+	O ~ T ~ H ~ E ~ R ~ S
+*/
+
+/*
+	@param 	v 	The moving vertex
+	@param 	dx 	The generated x-component of the translation vector
+	@param 	dy 	The generated y-component of the translation vector
+	@return 	The scale of the translation, see getDirectedEdgeLength()
+*/
+double MoveLog::getScale(Vertex const * const v, const double dx, const double dy){
+	return (*v).getDirectedEdgeLength(atan2(dy, dx));
+}
+
+/*
+	The function openRecord() creates the log file and enables the recording. It errors
+	with exit code 20 if the file can not be opened.
+
+	@param 	filename 	The name of the file
+*/
+void MoveLog::openRecord(const char *filename){
+	file = fopen(filename, "wb");
+	if(file == NULL){
+		fprintf(stderr, "Record error: could not open the file %s\n", filename);
+		exit(20);
+	}
+
+	fwrite(magic, 1, sizeof(magic), file);
+
+	recording = true;
+}
+
+/*
+	The function openReplay() opens the log file and enables the replay. It errors with
+	exit code 20 if the file can not be opened or is no log.
+
+	@param 	filename 	The name of the file
+*/
+void MoveLog::openReplay(const char *filename){
+	char header[sizeof(magic)];
+
+	file = fopen(filename, "rb");
+	if(file == NULL){
+		fprintf(stderr, "Replay error: could not open the file %s\n", filename);
+		exit(20);
+	}
+
+	if(fread(header, 1, sizeof(header), file) != sizeof(header) ||
+		memcmp(header, magic, sizeof(magic)) != 0){
+		fprintf(stderr, "Replay error: the file %s is no move log\n", filename);
+		exit(20);
+	}
+
+	replaying = true;
+}
+
+/*
+	The function addTranslation() adds a tried translation to the recorded log and, for a
+	replay, compares whether it has been executed to the recorded outcome.
+
+	@param 	index 	The index of the moving vertex in the triangulation
+	@param 	dx 		The generated x-component of the translation vector
+	@param 	dy 		The generated y-component of the translation vector
+	@param 	scale 	The scale of the translation before its execution
+	@param 	e 		The engine which has been used for the translation
+	@param 	ex 		The outcome of the translation
+*/
+void MoveLog::addTranslation(const int index, const double dx, const double dy,
+	const double scale, const Engine e, const Executed ex){
+
+	unsigned char buffer[31];
+	double tx, ty;
+	bool accepted, recorded;
+
+	// Full and partial executions count as the same outcome, as they depend on the engine
+	if(replaying){
+		accepted = ex == Executed::FULL || ex == Executed::PARTIAL;
+		recorded = lastOutcome == (unsigned char)Executed::FULL ||
+			lastOutcome == (unsigned char)Executed::PARTIAL;
+
+		replayed++;
+		if(accepted != recorded)
+			diverged++;
+		return;
+	}
+
+	getEffectiveTranslation(dx, dy, tx, ty);
+
+	buffer[0] = (unsigned char)(inInsertion ? LogRecord::INSERTIONMOVE : LogRecord::MOVE);
+	memcpy(buffer + 1, &index, 4);
+	memcpy(buffer + 5, &tx, 8);
+	memcpy(buffer + 13, &ty, 8);
+	memcpy(buffer + 21, &scale, 8);
+	buffer[29] = (unsigned char)e;
+	buffer[30] = (unsigned char)ex;
+
+	fwrite(buffer, 1, sizeof(buffer), file);
+}
+
+/*
+	The function addInsertion() adds the choice of an edge to insert in to the recorded
+	log. The following translations belong to the new vertex until endInsertion() gets
+	called.
+
+	@param 	pID 	The ID of the polygon
+	@param 	index 	The index of the first vertex of the edge in the triangulation
+	@param 	stable 	True if the edge has passed the stability check
+*/
+void MoveLog::addInsertion(const unsigned int pID, const int index, const bool stable){
+	unsigned char buffer[10];
+
+	buffer[0] = (unsigned char)LogRecord::INSERTION;
+	memcpy(buffer + 1, &pID, 4);
+	memcpy(buffer + 5, &index, 4);
+	buffer[9] = stable;
+
+	fwrite(buffer, 1, sizeof(buffer), file);
+
+	inInsertion = stable;
+}
+
+/*
+	The function endInsertion() marks the end of the translations of an inserted vertex.
+*/
+void MoveLog::endInsertion(){
+	inInsertion = false;
+}
+
+/*
+	The function nextMove() returns the next translation of a translation phase from the
+	replayed log. It errors with exit code 20 if the log has no such translation.
+
+	@param 	T 		The triangulation the polygon lives in
+	@param 	index 	The index of the moving vertex in the triangulation
+	@param 	dx 		The generated x-component of the translation vector
+	@param 	dy 		The generated y-component of the translation vector
+	@return 		False if the moving vertex does not exist in the actual run, then the
+					translation gets skipped, otherwise true
+*/
+bool MoveLog::nextMove(Triangulation const * const T, int &index, double &dx, double &dy){
+
+	// Skip the remaining tries of the last inserted vertex
+	while(peek() && kind == LogRecord::INSERTIONMOVE)
+		buffered = false;
+
+	if(!buffered || kind != LogRecord::MOVE)
+		mismatch("translation");
+
+	index = nextIndex;
+
+	if(index < 0 || index >= (*T).getActualNumberOfVertices()){
+		buffered = false;
+		skipped++;
+		return false;
+	}
+
+	takeTranslation((*T).getVertex(index), dx, dy);
+
+	return true;
+}
+
+/*
+	The function nextInsertionMove() returns the next translation of the inserted vertex
+	from the replayed log.
+
+	@param 	v 	The inserted vertex
+	@param 	dx 	The generated x-component of the translation vector
+	@param 	dy 	The generated y-component of the translation vector
+	@return 	False if the recorded run has not tried any more translations of the
+				inserted vertex, otherwise true
+*/
+bool MoveLog::nextInsertionMove(Vertex const * const v, double &dx, double &dy){
+	if(!peek() || kind != LogRecord::INSERTIONMOVE)
+		return false;
+
+	takeTranslation(v, dx, dy);
+
+	return true;
+}
+
+/*
+	The function nextInsertion() returns the next choice of an edge to insert in from
+	the replayed log. It errors with exit code 20 if the log has no such choice for the
+	polygon.
+
+	@param 	T 		The triangulation the polygon lives in
+	@param 	pID 	The ID of the polygon
+	@param 	e 		The edge to insert in, NULL if it does not exist in the actual run,
+					then the insertion gets skipped
+	@return 		False if the edge has not passed the stability check in the recorded
+					run, otherwise true
+*/
+bool MoveLog::nextInsertion(Triangulation const * const T, const unsigned int pID, TEdge *&e){
+
+	// Skip the remaining tries of the last inserted vertex
+	while(peek() && kind == LogRecord::INSERTIONMOVE)
+		buffered = false;
+
+	if(!buffered || kind != LogRecord::INSERTION || nextPID != pID)
+		mismatch("insertion");
+
+	buffered = false;
+
+	if(nextIndex < 0 || nextIndex >= (*T).getActualNumberOfVertices()){
+		e = NULL;
+		if(nextOutcome)
+			skipped++;
+	}else
+		e = (*(*T).getVertex(nextIndex)).getToNext();
+
+	return nextOutcome;
+}
+
+/*
+	The function skipInsertion() counts a replayed insertion which is not possible in the
+	actual run.
+*/
+void MoveLog::skipInsertion(){
+	skipped++;
+}
+
+/*
+	The function close() closes the log file and reports for a replay the number of
+	translations executed differently than recorded and the numbers of skipped and unused
+	proposals.
+*/
+void MoveLog::close(){
+	unsigned long long unused = 0;
+
+	if(file == NULL)
+		return;
+
+	if(replaying){
+		while(peek()){
+			if(kind != LogRecord::INSERTIONMOVE)
+				unused++;
+			buffered = false;
+		}
+
+		if(Settings::feedback != FeedbackMode::MUTE){
+			fprintf(stderr, "Replay: %llu of %llu translations executed differently than recorded\n",
+				diverged, replayed);
+			if(skipped > 0)
+				fprintf(stderr, "Note: The replay has skipped %llu recorded proposals which were not possible!\n", skipped);
+			if(unused > 0)
+				fprintf(stderr, "Note: The replay has not used %llu recorded proposals!\n", unused);
+		}
+	}
+
+	fclose(file);
+	file = NULL;
+
+	recording = false;
+	replaying = false;
+}
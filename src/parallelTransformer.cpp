@@ -0,0 +1,870 @@
+/*
+ * Copyright 2021 Philipp Mayer - pmayer@cs.sbg.ac.at
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "parallelTransformer.h"
+#include "polygonTransformer.h"
+
+
+/*
+	The function parallelTranslationsApplicable() decides whether the translations of a
+	polygon can be executed by transformPolygonByMovesParallel().
+
+	@param 	T 	The triangulation the polygon lives in
+	@return 	True if multiple threads are enabled, the polygon has no holes and it is large
+				enough to be split into cells, otherwise false
+
+	Note:
+		- With less than 100 vertices per cell nearly all proposals get deferred
+		- The speculative mode does not split the polygon, so it has no size limit
+*/
+bool parallelTranslationsApplicable(Triangulation const * const T){
+	unsigned int nrCells;
+
+	if(Settings::threads <= 1)
+		return false;
+
+	if(Settings::nrInnerPolygons > 0 || (*T).getActualNrInnerPolygons() > 0)
+		return false;
+
+	if(Settings::parallelMode == ParallelMode::SPECULATIVE)
+		return true;
+
+	nrCells = (Settings::cellsPerSide + 1) * (Settings::cellsPerSide + 1);
+
+	return (unsigned int)(*T).getActualNumberOfVertices() >= 100 * nrCells;
+}
+
+/*
+	The function transformPolygonByMovesParallel() does the same as transformPolygonByMoves()
+	but executes the translations in parallel. Therefore it works in rounds. At the start of
+	each round the polygon gets partitioned into the cells of a randomly shifted grid and the
+	proposals of the round get distributed to the cells of their moving vertices. Each cell
+	is processed by one thread, which executes the proposals whose affected region is part of
+	the cell. All other proposals are deferred and executed sequentially at the end of the
+	round.
+
+	@param 	T 			The triangulation the polygon lives in
+	@param 	iterations	The number of moves which should be tried
+	@return 			The number of moves which were executed at least partially
+
+	Note:
+		- The vertices are selected uniformly at random from the whole polygon exactly as in
+			the sequential version and all proposals get tried, so deferring proposals just
+			changes the order in which independent translations get executed
+		- For a fixed seed the result does not depend on the number of threads
+		- Each round tries a quarter of the number of vertices of translations, so the grid
+			gets shifted multiple times during the additional translations
+		- This function works just for polygons without holes!
+*/
+int transformPolygonByMovesParallel(Triangulation * const T, const int iterations){
+	int n = (*T).getActualNumberOfVertices();
+	int roundSize = std::max(n / 4, 1);
+	WorkerPool *workers = getWorkerPool();
+	int size, nrRegions, i;
+	int done = 0;
+	int performedTranslations = 0;
+	unsigned long long nrDeferred;
+	Proposal p;
+	enum Executed ex;
+	std::vector< std::vector<Proposal> > cells;
+	std::vector< std::vector<Proposal> > deferred;
+	std::vector<Proposal> sequential;
+	std::vector< std::vector<STEntry<TEdge*>*> > stUpdates;
+	std::vector< std::vector<EngineRecord> > engineRecords;
+	std::vector<int> performed;
+	Timer wall;
+	CpuTimer cpu;
+
+	while(done < iterations){
+		size = std::min(roundSize, iterations - done);
+
+		wall.start();
+		cpu.start();
+
+		// Partition the polygon by a new grid
+		nrRegions = assignRegions(T);
+
+		cells.assign(nrRegions, std::vector<Proposal>());
+		deferred.assign(nrRegions, std::vector<Proposal>());
+		performed.assign(nrRegions, 0);
+		stUpdates.assign(nrRegions, std::vector<STEntry<TEdge*>*>());
+		engineRecords.assign(nrRegions, std::vector<EngineRecord>());
+
+		// Generate the proposals of the round and distribute them to the cells
+		for(i = 0; i < size; i++){
+			p.seq = done + i;
+			p.index = (*Settings::generator).getRandomIndex(n);
+			p.alpha = (*Settings::generator).getDoubleUniform(- M_PI, M_PI);
+			p.z = (*Settings::generator).getDoubleNormal(0, 1);
+
+			cells[(*(*T).getVertex(p.index)).getRegion()].push_back(p);
+		}
+
+		// Process the cells, the main thread works as one of the workers
+		TEdge::deferSTUpdates(true);
+		EngineSelector::deferRecords(true);
+
+		(*workers).run(nrRegions, [&](const int c){
+			performed[c] = translateCell(T, cells[c], c, deferred[c]);
+			TEdge::takeDeferredSTUpdates(stUpdates[c]);
+			EngineSelector::takeDeferredRecords(engineRecords[c]);
+		});
+
+		TEdge::deferSTUpdates(false);
+		EngineSelector::deferRecords(false);
+
+		// Update the SelectionTree and the EngineSelector in the order of the cells
+		for(auto& u : stUpdates)
+			TEdge::applySTUpdates(u);
+		for(auto& r : engineRecords)
+			EngineSelector::applyRecords(r);
+
+		// Execute the deferred proposals in the order they have been generated
+		sequential.clear();
+		for(i = 0; i < nrRegions; i++){
+			performedTranslations = performedTranslations + performed[i];
+			sequential.insert(sequential.end(), deferred[i].begin(), deferred[i].end());
+		}
+
+		std::sort(sequential.begin(), sequential.end(),
+			[](Proposal const &a, Proposal const &b){ return a.seq < b.seq; });
+
+		for(auto& q : sequential){
+			double dx, dy;
+
+			getProposalTranslation(T, q, dx, dy);
+			ex = tryTranslation(T, q.index, dx, dy);
+
+			if(ex == Executed::FULL || ex == Executed::PARTIAL)
+				performedTranslations++;
+		}
+
+		nrDeferred = sequential.size();
+		recordParallelRound(size - nrDeferred, nrDeferred, cpu.elapsedTime(), wall.elapsedTime());
+
+		done = done + size;
+
+		if(Settings::feedback != FeedbackMode::MUTE)
+			fprintf(stderr, "%.1f%% of %d translations performed after %f seconds (%llu of %d deferred)\n",
+				(double)done / (double)iterations * 100, iterations, (*Settings::timer).elapsedTime(),
+				nrDeferred, size);
+	}
+
+	// Release the vertices from their regions
+	for(i = 0; i < n; i++)
+		(*(*T).getVertex(i)).setRegion(-1);
+
+	return performedTranslations;
+}
+
+/*
+	The function assignRegions() partitions the polygon by a grid of
+	(Settings::cellsPerSide + 1)^2 cells which gets randomly shifted and assigns each
+	vertex to the region of its cell.
+
+	@param 	T 	The triangulation the polygon lives in
+	@return 	The number of regions
+
+	Note:
+		The cells have the size of a cell of a grid with Settings::cellsPerSide cells per side
+		over the bounding box of the polygon. As the grid gets shifted by up to one cell,
+		an additional row and column are required to cover the polygon.
+*/
+int assignRegions(Triangulation * const T){
+	int n = (*T).getActualNumberOfVertices();
+	int k = Settings::cellsPerSide;
+	int i, cx, cy;
+	double minX, maxX, minY, maxY;
+	double width, height, shiftX, shiftY;
+	Vertex *v;
+
+	// Compute the bounding box of the polygon
+	v = (*T).getVertex(0);
+	minX = maxX = (*v).getX();
+	minY = maxY = (*v).getY();
+
+	for(i = 1; i < n; i++){
+		v = (*T).getVertex(i);
+
+		minX = std::min(minX, (*v).getX());
+		maxX = std::max(maxX, (*v).getX());
+		minY = std::min(minY, (*v).getY());
+		maxY = std::max(maxY, (*v).getY());
+	}
+
+	width = (maxX - minX) / k;
+	height = (maxY - minY) / k;
+
+	if(width <= 0)
+		width = 1;
+	if(height <= 0)
+		height = 1;
+
+	// Shift the grid randomly
+	shiftX = (*Settings::generator).getDoubleUniform(0, width);
+	shiftY = (*Settings::generator).getDoubleUniform(0, height);
+
+	for(i = 0; i < n; i++){
+		v = (*T).getVertex(i);
+
+		cx = (int)(((*v).getX() - minX + shiftX) / width);
+		cy = (int)(((*v).getY() - minY + shiftY) / height);
+
+		cx = std::max(0, std::min(cx, k));
+		cy = std::max(0, std::min(cy, k));
+
+		(*v).setRegion(cx * (k + 1) + cy);
+	}
+
+	return (k + 1) * (k + 1);
+}
+
+/*
+	The function checkRegion() checks whether a translation just affects entities of one
+	region. That is the case if the moving vertex and its neighbors belong to the region
+	and all triangles incident to the moving vertex or intersecting the bounding box of
+	the old and the new position of the moving vertex and its neighbors have all their
+	vertices in the region.
+
+	@param 	v 		The moving vertex
+	@param 	tx 		The x-component of the effective translation vector
+	@param 	ty 		The y-component of the effective translation vector
+	@param 	region 	The region of the executing thread
+	@return 		True if the translation just affects entities of the region, otherwise false
+
+	Note:
+		- Both translation types just change triangles which are incident to the moving vertex
+			or intersect the convex hull of its old and new position and its neighbors. The
+			bounding box is a conservative replacement of this hull
+		- The triangles are visited by a flood fill starting at the moving vertex, which
+			never leaves the region, so it does not read any entity another thread changes
+		- The number of visited triangles is small, so a vector is faster than a set here
+		- Triangles containing a vertex of the bounding box of the triangulation never belong
+			to a region, as these vertices are not assigned to any region
+*/
+bool checkRegion(Vertex * const v, const double tx, const double ty, const int region){
+	Vertex *prevV, *nextV;
+	double minX, maxX, minY, maxY, eps;
+	std::vector<Triangle*> stack;
+	std::vector<Triangle*> visited;
+	Triangle *t, *other;
+	TEdge *e;
+	int i;
+
+	prevV = (*v).getPrev();
+	nextV = (*v).getNext();
+
+	if((*v).getRegion() != region || (*prevV).getRegion() != region ||
+		(*nextV).getRegion() != region)
+		return false;
+
+	// Bounding box of the old and the new position and the neighbors
+	minX = std::min(std::min((*v).getX(), (*v).getX() + tx), std::min((*prevV).getX(), (*nextV).getX()));
+	maxX = std::max(std::max((*v).getX(), (*v).getX() + tx), std::max((*prevV).getX(), (*nextV).getX()));
+	minY = std::min(std::min((*v).getY(), (*v).getY() + ty), std::min((*prevV).getY(), (*nextV).getY()));
+	maxY = std::max(std::max((*v).getY(), (*v).getY() + ty), std::max((*prevV).getY(), (*nextV).getY()));
+
+	// Enlarge the box a bit to be robust against rounding errors
+	eps = 0.000001 * std::max(maxX - minX, maxY - minY) + Settings::epsInt;
+	minX = minX - eps;
+	maxX = maxX + eps;
+	minY = minY - eps;
+	maxY = maxY + eps;
+
+	// Start with the triangles incident to the moving vertex
+	for(auto& j : (*v).getTriangles()){
+		if(!isInRegion(j, region))
+			return false;
+
+		stack.push_back(j);
+		visited.push_back(j);
+	}
+
+	// Flood all triangles intersecting the box
+	while(!stack.empty()){
+		t = stack.back();
+		stack.pop_back();
+
+		for(i = 0; i < 3; i++){
+			e = (*t).getEdge(i);
+
+			if(!intersectsBox(e, minX, maxX, minY, maxY))
+				continue;
+
+			other = (*e).getOtherTriangle(t);
+			if(other == NULL)
+				return false;
+
+			if(std::find(visited.begin(), visited.end(), other) == visited.end()){
+				if(!isInRegion(other, region))
+					return false;
+
+				stack.push_back(other);
+				visited.push_back(other);
+			}
+		}
+	}
+
+	return true;
+}
+
+/*
+	The function isInRegion() checks whether all vertices of a triangle belong to a region.
+
+	@param 	t 		The triangle of interest
+	@param 	region 	The region
+	@return 		True if all vertices of t belong to the region, otherwise false
+*/
+bool isInRegion(Triangle const * const t, const int region){
+	int i;
+
+	for(i = 0; i < 3; i++){
+		if((*(*t).getVertex(i)).getRegion() != region)
+			return false;
+	}
+
+	return true;
+}
+
+/*
+	The function intersectsBox() checks whether an edge intersects an axis-parallel box.
+	Therefore it first compares the bounding box of the edge with the box and then checks
+	whether all corners of the box lay on the same side of the line through the edge.
+
+	@param 	e 		The edge of interest
+	@param 	minX 	The minimum x-coordinate of the box
+	@param 	maxX 	The maximum x-coordinate of the box
+	@param 	minY 	The minimum y-coordinate of the box
+	@param 	maxY 	The maximum y-coordinate of the box
+	@return 		True if the edge intersects the box, otherwise false
+*/
+bool intersectsBox(TEdge const * const e, const double minX, const double maxX,
+	const double minY, const double maxY){
+
+	double x0, y0, x1, y1;
+	double d0, d1, d2, d3;
+
+	x0 = (*(*e).getV0()).getX();
+	y0 = (*(*e).getV0()).getY();
+	x1 = (*(*e).getV1()).getX();
+	y1 = (*(*e).getV1()).getY();
+
+	if(std::max(x0, x1) < minX || std::min(x0, x1) > maxX)
+		return false;
+	if(std::max(y0, y1) < minY || std::min(y0, y1) > maxY)
+		return false;
+
+	// Orientation of the corners of the box relative to the edge
+	d0 = (x1 - x0) * (minY - y0) - (y1 - y0) * (minX - x0);
+	d1 = (x1 - x0) * (minY - y0) - (y1 - y0) * (maxX - x0);
+	d2 = (x1 - x0) * (maxY - y0) - (y1 - y0) * (minX - x0);
+	d3 = (x1 - x0) * (maxY - y0) - (y1 - y0) * (maxX - x0);
+
+	if(d0 > 0 && d1 > 0 && d2 > 0 && d3 > 0)
+		return false;
+	if(d0 < 0 && d1 < 0 && d2 < 0 && d3 < 0)
+		return false;
+
+	return true;
+}
+
+/*
+	The function translateCell() executes the proposals of one cell which just affect its
+	region and collects the others.
+
+	@param 	T 			The triangulation the polygon lives in
+	@param 	proposals 	The proposals of the cell
+	@param 	region 		The region of the cell
+	@param 	deferred 	The proposals which have to be executed sequentially
+	@return 			The number of moves which were executed at least partially
+*/
+int translateCell(Triangulation * const T, std::vector<Proposal> const &proposals,
+	const int region, std::vector<Proposal> &deferred){
+
+	int performedTranslations = 0;
+	double dx, dy, tx, ty;
+	enum Executed ex;
+
+	for(auto& p : proposals){
+		getProposalTranslation(T, p, dx, dy);
+		getEffectiveTranslation(dx, dy, tx, ty);
+
+		if(!checkRegion((*T).getVertex(p.index), tx, ty, region)){
+			deferred.push_back(p);
+			continue;
+		}
+
+		ex = tryTranslation(T, p.index, dx, dy);
+
+		if(ex == Executed::FULL || ex == Executed::PARTIAL)
+			performedTranslations++;
+	}
+
+	return performedTranslations;
+}
+
+/*
+	The function getProposalTranslation() computes the translation vector of a proposal in
+	the same way transformPolygonByMoves() does.
+
+	@param 	T 	The triangulation the polygon lives in
+	@param 	p 	The proposal
+	@param 	dx 	The generated x-component of the translation vector
+	@param 	dy 	The generated y-component of the translation vector
+
+	Note:
+		- The distance is bounded away from 0 in the same way RandomGenerator::getDoubleNormal()
+			does it
+		- The scale of the acceptance controller does not change during a parallel phase, so
+			the proposals can be computed concurrently
+*/
+void getProposalTranslation(Triangulation * const T, Proposal const &p, double &dx, double &dy){
+	double stddev, r;
+	double limit = 0.0000001;
+
+	stddev = (*(*T).getVertex(p.index)).getDirectedEdgeLength(p.alpha);
+	if(Settings::controller != NULL)
+		stddev = (*Settings::controller).getScale() * stddev;
+
+	r = stddev / 2 + p.z * stddev / Settings::stddevDiv;
+
+	if(r < limit && r > - limit){
+		if(r > 0)
+			r = limit;
+		else
+			r = - limit;
+	}
+
+	dx = r * cos(p.alpha);
+	dy = r * sin(p.alpha);
+}
+
+/*
+	The function transformPolygonByMovesIndependent() does the same as
+	transformPolygonByMoves() but executes the translations in parallel rounds of
+	independent translations. Each round it fills a pool of proposals and selects a
+	maximal subset of them whose 2-ring neighbourhoods in the triangulation are pairwise
+	disjoint by reserving the neighbourhoods greedily in generation order (Luby-style with
+	the random generation order as priorities). The selected translations are executed
+	concurrently, each one restricted to its reserved neighbourhood. Translations which
+	would leave their neighbourhood are rejected for the concurrent step and executed
+	sequentially at the end of the round. Proposals which have not been selected stay in
+	the pool for the next round.
+
+	@param 	T 			The triangulation the polygon lives in
+	@param 	iterations	The number of moves which should be tried
+	@return 			The number of moves which were executed at least partially
+
+	Note:
+		- As in transformPolygonByMovesParallel() the vertices are selected uniformly at
+			random and all proposals get tried
+		- The pool holds a fixed number of proposals and the proposals get selected and
+			committed in generation order, so for a fixed seed the result does not depend
+			on the number of threads
+		- This function works just for polygons without holes!
+*/
+int transformPolygonByMovesIndependent(Triangulation * const T, const int iterations){
+	int n = (*T).getActualNumberOfVertices();
+	const int poolSize = 1024;
+	WorkerPool *workers = getWorkerPool();
+	int generated = 0;
+	int performedTranslations = 0;
+	int i, nrSelected, div, lastPrint = 0;
+	unsigned long long nrBounced;
+	double dx, dy;
+	Proposal p;
+	enum Executed ex;
+	std::vector<Proposal> pool, carried, selected;
+	std::vector<Vertex*> reserved;
+	std::vector<int> results;
+	std::vector< std::vector<STEntry<TEdge*>*> > stUpdates;
+	std::vector< std::vector<EngineRecord> > engineRecords;
+	Timer wall;
+	CpuTimer cpu;
+
+	div = std::max(iterations / 100, 1);
+
+	while(generated < iterations || !pool.empty()){
+
+		wall.start();
+		cpu.start();
+
+		// Fill up the pool
+		while((int)pool.size() < poolSize && generated < iterations){
+			p.seq = generated;
+			p.index = (*Settings::generator).getRandomIndex(n);
+			p.alpha = (*Settings::generator).getDoubleUniform(- M_PI, M_PI);
+			p.z = (*Settings::generator).getDoubleNormal(0, 1);
+
+			pool.push_back(p);
+			generated++;
+		}
+
+		// Select the independent proposals, each one gets its own region
+		selected.clear();
+		carried.clear();
+
+		for(auto& q : pool){
+			if(reserveNeighbourhood((*T).getVertex(q.index), selected.size(), reserved))
+				selected.push_back(q);
+			else
+				carried.push_back(q);
+		}
+
+		pool.swap(carried);
+
+		// Execute the selected proposals concurrently
+		nrSelected = selected.size();
+		results.assign(nrSelected, 0);
+		stUpdates.assign(nrSelected, std::vector<STEntry<TEdge*>*>());
+		engineRecords.assign(nrSelected, std::vector<EngineRecord>());
+
+		TEdge::deferSTUpdates(true);
+		EngineSelector::deferRecords(true);
+
+		(*workers).run(nrSelected, [&](const int k){
+			results[k] = translateReserved(T, selected[k], k);
+			TEdge::takeDeferredSTUpdates(stUpdates[k]);
+			EngineSelector::takeDeferredRecords(engineRecords[k]);
+		});
+
+		TEdge::deferSTUpdates(false);
+		EngineSelector::deferRecords(false);
+
+		// Update the SelectionTree and the EngineSelector in the order of the selected
+		// proposals
+		for(auto& u : stUpdates)
+			TEdge::applySTUpdates(u);
+		for(auto& r : engineRecords)
+			EngineSelector::applyRecords(r);
+
+		// Release the reserved neighbourhoods
+		for(auto& v : reserved)
+			(*v).setRegion(-1);
+		reserved.clear();
+
+		// Execute the rejected translations sequentially
+		nrBounced = 0;
+		for(i = 0; i < nrSelected; i++){
+			if(results[i] > 0)
+				performedTranslations++;
+
+			if(results[i] >= 0)
+				continue;
+
+			nrBounced++;
+
+			getProposalTranslation(T, selected[i], dx, dy);
+			ex = tryTranslation(T, selected[i].index, dx, dy);
+
+			if(ex == Executed::FULL || ex == Executed::PARTIAL)
+				performedTranslations++;
+		}
+
+		recordParallelRound(nrSelected - nrBounced, nrBounced, cpu.elapsedTime(), wall.elapsedTime());
+
+		if(generated - lastPrint >= div && Settings::feedback != FeedbackMode::MUTE){
+			lastPrint = generated;
+			fprintf(stderr, "%.1f%% of %d translations generated after %f seconds (%d in parallel, %llu rejected)\n",
+				(double)generated / (double)iterations * 100, iterations, (*Settings::timer).elapsedTime(),
+				nrSelected, nrBounced);
+		}
+	}
+
+	return performedTranslations;
+}
+
+/*
+	The function reserveNeighbourhood() reserves the 2-ring neighbourhood of a vertex, i.e.
+	the vertex, its neighbors in the triangulation and their neighbors, for one region if
+	none of these vertices is already reserved.
+
+	@param 	v 			The vertex of interest
+	@param 	region 		The region the neighbourhood gets reserved for
+	@param 	reserved 	The list of all reserved vertices, the vertices of the neighbourhood
+						get appended
+	@return 			True if the neighbourhood has been reserved, otherwise false
+
+	Note:
+		The vertices of the bounding box are neither reserved nor expanded, as they are
+		adjacent to a large part of the polygon. Translations touching their triangles
+		leave the neighbourhood and get executed sequentially.
+*/
+bool reserveNeighbourhood(Vertex * const v, const int region, std::vector<Vertex*> &reserved){
+	std::vector<Vertex*> ring;
+	Vertex *u;
+	unsigned int i, size;
+
+	if((*v).getRegion() != -1)
+		return false;
+
+	ring.push_back(v);
+
+	// The 1-ring
+	for(auto& e : (*v).getEdges()){
+		u = (*e).getOtherVertex(v);
+
+		if((*u).isRectangleVertex())
+			continue;
+
+		if((*u).getRegion() != -1)
+			return false;
+
+		ring.push_back(u);
+	}
+
+	// The 2-ring
+	size = ring.size();
+	for(i = 1; i < size; i++){
+		for(auto& e : (*ring[i]).getEdges()){
+			u = (*e).getOtherVertex(ring[i]);
+
+			if((*u).isRectangleVertex())
+				continue;
+
+			if((*u).getRegion() != -1)
+				return false;
+
+			ring.push_back(u);
+		}
+	}
+
+	for(auto& j : ring){
+		if((*j).getRegion() == -1){
+			(*j).setRegion(region);
+			reserved.push_back(j);
+		}
+	}
+
+	return true;
+}
+
+/*
+	The function translateReserved() executes a proposal which is restricted to the reserved
+	neighbourhood of its moving vertex.
+
+	@param 	T 		The triangulation the polygon lives in
+	@param 	p 		The proposal
+	@param 	region 	The region the neighbourhood of the moving vertex is reserved for
+	@return 		-1 if the translation would leave the neighbourhood, 1 if it has been
+					executed at least partially, otherwise 0
+*/
+int translateReserved(Triangulation * const T, Proposal const &p, const int region){
+	double dx, dy, tx, ty;
+	enum Executed ex;
+
+	getProposalTranslation(T, p, dx, dy);
+	getEffectiveTranslation(dx, dy, tx, ty);
+
+	if(!checkRegion((*T).getVertex(p.index), tx, ty, region))
+		return -1;
+
+	ex = tryTranslation(T, p.index, dx, dy);
+
+	if(ex == Executed::FULL || ex == Executed::PARTIAL)
+		return 1;
+
+	return 0;
+}
+
+/*
+	The function recordParallelRound() adds the results of one parallel round to the
+	statistics.
+
+	@param 	parallel 	The number of translations processed by the workers
+	@param 	deferred 	The number of translations which have been executed sequentially
+	@param 	cpuTime 	The CPU time all threads spent on the round (in seconds)
+	@param 	wallTime 	The wall-clock time of the round including its sequential parts
+						(in seconds)
+*/
+void recordParallelRound(const unsigned long long parallel, const unsigned long long deferred,
+	const double cpuTime, const double wallTime){
+
+	Statistics::parallelRounds++;
+	Statistics::parallelTranslations = Statistics::parallelTranslations + parallel;
+	Statistics::deferredTranslations = Statistics::deferredTranslations + deferred;
+
+	if(parallel > Statistics::maxParallelTranslations)
+		Statistics::maxParallelTranslations = parallel;
+
+	Statistics::parallelCpuTime = Statistics::parallelCpuTime + cpuTime;
+	Statistics::parallelWallTime = Statistics::parallelWallTime + wallTime;
+}
+
+/*
+	The function transformPolygonByMovesSpeculative() does the same as
+	transformPolygonByMoves() but checks the proposals speculatively in parallel. It works in
+	batches. First the worker pool checks all proposals of a batch against the unchanged
+	triangulation, afterwards the main thread commits them in generation order. Proposals
+	whose check is still up to date are executed without checking them again respectively
+	skipped if they failed the check, all others get checked and executed as usual.
+
+	@param 	T 			The triangulation the polygon lives in
+	@param 	iterations	The number of moves which should be tried
+	@return 			The number of moves which were executed at least partially
+
+	Note:
+		- As all translations get committed in generation order, the result is the same as
+			executing the proposals sequentially and for a fixed seed it does not depend on
+			the number of threads
+		- The gain grows with the rejection rate, as rejected proposals do not change the
+			triangulation and therefore do not outdate the other checks
+		- A batch holds 64 proposals per thread
+		- This function works just for polygons without holes!
+*/
+int transformPolygonByMovesSpeculative(Triangulation * const T, const int iterations){
+	int n = (*T).getActualNumberOfVertices();
+	WorkerPool *pool = getWorkerPool();
+	int batchSize = 64 * (*pool).getNrThreads();
+	int size, i, div, lastPrint = 0;
+	int done = 0;
+	int performedTranslations = 0;
+	unsigned long long nrRevalidated;
+	double dx, dy;
+	enum Executed ex;
+	std::vector<Proposal> proposals;
+	std::vector<SpeculativeCheck> checks(batchSize);
+	Timer wall;
+	CpuTimer cpu;
+
+	div = std::max(iterations / 100, 1);
+
+	while(done < iterations){
+		size = std::min(batchSize, iterations - done);
+
+		wall.start();
+		cpu.start();
+
+		// Generate the proposals of the batch
+		proposals.resize(size);
+		for(i = 0; i < size; i++){
+			proposals[i].seq = done + i;
+			proposals[i].index = (*Settings::generator).getRandomIndex(n);
+			proposals[i].alpha = (*Settings::generator).getDoubleUniform(- M_PI, M_PI);
+			proposals[i].z = (*Settings::generator).getDoubleNormal(0, 1);
+		}
+
+		// Check all proposals concurrently
+		(*pool).run(size, [&](const int k){
+			double gx, gy;
+
+			getProposalTranslation(T, proposals[k], gx, gy);
+			precheckTranslation(T, (*T).getVertex(proposals[k].index), gx, gy, checks[k]);
+		});
+
+		// Commit the proposals in generation order
+		nrRevalidated = 0;
+		for(i = 0; i < size; i++){
+			if(isUpToDate(checks[i])){
+				// A translation which has been rejected does not change anything
+				if(!checks[i].accepted){
+					Statistics::translationTries++;
+					Statistics::addRejection(checks[i].rejection, checks[i].time);
+					continue;
+				}
+
+				ex = tryTranslation(T, proposals[i].index, checks[i].dx, checks[i].dy, true,
+					checks[i].triangles);
+			}else{
+				nrRevalidated++;
+
+				getProposalTranslation(T, proposals[i], dx, dy);
+				ex = tryTranslation(T, proposals[i].index, dx, dy);
+			}
+
+			if(ex == Executed::FULL || ex == Executed::PARTIAL)
+				performedTranslations++;
+		}
+
+		recordParallelRound(size - nrRevalidated, nrRevalidated, cpu.elapsedTime(), wall.elapsedTime());
+
+		done = done + size;
+
+		if(done - lastPrint >= div && Settings::feedback != FeedbackMode::MUTE){
+			lastPrint = done;
+			fprintf(stderr, "%.1f%% of %d translations done after %f seconds (%llu of %d checked again)\n",
+				(double)done / (double)iterations * 100, iterations, (*Settings::timer).elapsedTime(),
+				nrRevalidated, size);
+		}
+	}
+
+	return performedTranslations;
+}
+
+/*
+	The function getWorkerPool() returns the worker pool all parallel steps run on. The
+	pool gets started at the first call and uses Settings::threads threads.
+
+	@return 	The worker pool
+*/
+WorkerPool *getWorkerPool(){
+	static WorkerPool pool(Settings::threads);
+
+	return &pool;
+}
+
+/*
+	The function precheckTranslation() checks a translation without changing the
+	triangulation, so it can run concurrently to other checks.
+
+	@param 	T 	The triangulation the polygon lives in
+	@param 	v 	The moving vertex
+	@param 	dx 	The generated x-component of the translation vector
+	@param 	dy 	The generated y-component of the translation vector
+	@param 	c 	The check result, its read set and the versions of the read vertices
+*/
+void precheckTranslation(Triangulation * const T, Vertex * const v, const double dx,
+	const double dy, SpeculativeCheck &c){
+
+	double tx, ty;
+	TranslationCheck *trans;
+
+	c.dx = dx;
+	c.dy = dy;
+	c.readSet.clear();
+	c.versions.clear();
+
+	getEffectiveTranslation(dx, dy, tx, ty);
+
+	trans = new TranslationCheck(T, v, tx, ty, &c.readSet);
+	c.accepted = (*trans).check();
+	c.rejection = (*trans).getRejection();
+	c.time = (*trans).getAge();
+	c.triangles = (*trans).getCrossedTriangles();
+	delete trans;
+
+	for(auto& i : c.readSet)
+		c.versions.push_back((*i).getVersion());
+}
+
+/*
+	The function isUpToDate() checks whether a speculative check is still valid, i.e. none
+	of the vertices it has read changed since the check.
+
+	@param 	c 	The speculative check
+	@return 	True if the check is still valid, otherwise false
+*/
+bool isUpToDate(SpeculativeCheck const &c){
+	unsigned int i;
+
+	for(i = 0; i < c.readSet.size(); i++){
+		if((*c.readSet[i]).getVersion() != c.versions[i])
+			return false;
+	}
+
+	return true;
+}
@@ -17,6 +17,16 @@
 
 #include "polygon.h"
 
+/*
+	S ~ T ~ A ~ T ~ I ~ C 	V ~ A ~ R ~ I ~ A ~ B ~ L ~ E ~ S
+*/
+
+/*
+	The scratch memory of the polygons of each thread
+*/
+thread_local PolygonScratch Polygon::scratch;
+
+
 /*
 	P ~ R ~ I ~ V ~ A ~ T ~ E 	M ~ E ~ M ~ B ~ E ~ R 	F ~ U ~ N ~ C ~ T ~ I ~ O ~ N ~ S
 */
@@ -30,92 +40,80 @@
 */
 void Polygon::triangulateStar(){
 	double referenceDet, area;
-	PolygonVertex *v0, *v1, *v2;
-	PolygonEdge *e0, *e1, *e2;
-	Triangle *t;
+	int v0, v1, v2;
+	int e0, e1, e2;
 	TEdge * newEdge;
 	bool inside;
 
 	// Get the first three vertices and their edges
 	v0 = startVertex;
-	e0 = v0 -> nextE;
-	v1 = e0 -> nextV;
-	e1 = v1 -> nextE;
-	v2 = e1 -> nextV;
+	e0 = vertex(v0).nextE;
+	v1 = edge(e0).nextV;
+	e1 = vertex(v1).nextE;
+	v2 = edge(e1).nextV;
 
 	// At first we have to find out whether positive or negative determinant values
 	// mark convex vertices
 	// For that we can exploit the fact that the kernel can be seen from each vertex
 	// Thus, it must hold that three consecutive vertices v0, v1 and v2 form an ear,
 	// if v2 is at the same side of (v0, v1) as the kernel point
-	t = new Triangle(v0 -> v, v1 -> v, kernel);
-	referenceDet = (*t).signedArea();
-	delete t;
+	referenceDet = Triangle::signedArea(vertex(v0).v, vertex(v1).v, kernel);
 
 	while(n > 3){
 
 		// Check whether the recent three vertices are in convex position
 		// Area == 0 is a special case which means that all three vertices lie on
 		// one line. We want to avoid cutting of such triangles!
-		t = new Triangle(v0 -> v, v1 -> v, v2 -> v);
-		area = (*t).signedArea();
-		delete t;
+		area = Triangle::signedArea(vertex(v0).v, vertex(v1).v, vertex(v2).v);
 
 		// Additionally, we have to check whether the triangle contains the kernel
 		// If it does, we can not cut off this triangle as the polygon could afterwards
 		// be not star-shaped anymore
-		inside = Triangle::insideTriangle(v0 -> v, v1 -> v, v2 -> v, kernel);
+		inside = Triangle::insideTriangle(vertex(v0).v, vertex(v1).v, vertex(v2).v, kernel);
 
 		if(!inside && area != 0 && signbit(area) == signbit(referenceDet)){
-			newEdge = new TEdge(v0 -> v, v2 -> v);
+			newEdge = new TEdge(vertex(v0).v, vertex(v2).v);
 			(*T).addEdge(newEdge, 0);
 
-			new Triangle(e0 -> e, e1 -> e, newEdge, v0 -> v, v1 -> v, v2 -> v, internal);
+			new Triangle(edge(e0).e, edge(e1).e, newEdge, vertex(v0).v, vertex(v1).v,
+				vertex(v2).v, internal);
 
-			// Remove the entries of the cut off entities
-			free(e0);
-			free(e1);
-			free(v1);
+			// The entries of the cut off entities just remain unused in the scratch memory
 
 			// Make a backtracking step
 			v1 = v0;
-			e0 = v1 -> prevE;
-			v0 = e0 -> prevV;
+			e0 = vertex(v1).prevE;
+			v0 = edge(e0).prevV;
 
 			// Create an entry for the new edge
-			e1 = (PolygonEdge*)malloc(sizeof(PolygonEdge));
-			e1 -> e = newEdge;
+			e1 = scratch.edges.size();
+			scratch.edges.push_back(PolygonEdge());
+			edge(e1).e = newEdge;
 
 			// Link the new entry with the adjacent entities
-			e1 -> prevV = v1;
-			e1 -> nextV = v2;
-			v1 -> nextE = e1;
-			v2 -> prevE = e1;
+			edge(e1).prevV = v1;
+			edge(e1).nextV = v2;
+			vertex(v1).nextE = e1;
+			vertex(v2).prevE = e1;
 
 			n--;
 		}else{
 			v0 = v1;
 			e0 = e1;
 			v1 = v2;
-			e1 = v1 -> nextE;
-			v2 = e1 -> nextV;
+			e1 = vertex(v1).nextE;
+			v2 = edge(e1).nextV;
 		}
 	}
 	
-	e2 = v2 -> nextE;
+	e2 = vertex(v2).nextE;
 
-	new Triangle(e0 -> e, e1 -> e, e2 -> e, v0 -> v, v1 -> v, v2 -> v, internal);
-
-	free(e0);
-	free(e1);
-	free(e2);
-	free(v0);
-	free(v1);
-	free(v2);
+	new Triangle(edge(e0).e, edge(e1).e, edge(e2).e, vertex(v0).v, vertex(v1).v, vertex(v2).v,
+		internal);
 
 	n = 0;
 
-	startVertex = NULL;
+	startVertex = -1;
 }
 
 /*
@@ -128,86 +126,94 @@ void Polygon::triangulateStar(){
 */
 void Polygon::triangulateVisible(){
 	double referenceDet, area;
-	PolygonVertex *v0, *v1, *v2, *additionalV;
-	PolygonEdge *e0, *e1, *e2;
-	Triangle *t;
+	int v0, v1, v2, additionalV;
+	int e0, e1, e2;
 	TEdge * newEdge;
 
 	// Get the first three vertices and their edges
 	v0 = startVertex;
-	e0 = v0 -> nextE;
-	v1 = e0 -> nextV;
-	e1 = v1 -> nextE;
-	v2 = e1 -> nextV;
+	e0 = vertex(v0).nextE;
+	v1 = edge(e0).nextV;
+	e1 = vertex(v1).nextE;
+	v2 = edge(e1).nextV;
 
 	// At first we have to find out whether positive or negative determinant values
 	// mark convex vertices
 	// For that we can exploit the fact that the vertices incident to the base edge
 	// must always be convex
-	additionalV = startVertex -> prevE-> prevV;
-	t = new Triangle(additionalV -> v, v0 -> v, v1 -> v);
-	referenceDet = (*t).signedArea();
-	delete t;
+	additionalV = edge(vertex(startVertex).prevE).prevV;
+	referenceDet = Triangle::signedArea(vertex(additionalV).v, vertex(v0).v, vertex(v1).v);
 
 	while(n > 3){
 
 		// Check whether the recent three vertices are in convex position
 		// Area == 0 is a special case which means that all three vertices lie on
 		// one line. We want to avoid cutting of such triangles!
-		t = new Triangle(v0 -> v, v1 -> v, v2 -> v);
-		area = (*t).signedArea();
-		delete t;
+		area = Triangle::signedArea(vertex(v0).v, vertex(v1).v, vertex(v2).v);
 
 		if(v1 != startVertex && area != 0 && signbit(area) == signbit(referenceDet)){
-			newEdge = new TEdge(v0 -> v, v2 -> v);
+			newEdge = new TEdge(vertex(v0).v, vertex(v2).v);
 			(*T).addEdge(newEdge, 0);
 
-			new Triangle(e0 -> e, e1 -> e, newEdge, v0 -> v, v1 -> v, v2 -> v, internal);
+			new Triangle(edge(e0).e, edge(e1).e, newEdge, vertex(v0).v, vertex(v1).v,
+				vertex(v2).v, internal);
 
-			// Remove the entries of the cut off entities
-			free(e0);
-			free(e1);
-			free(v1);
+			// The entries of the cut off entities just remain unused in the scratch memory
 
 			// Make a backtracking step
 			v1 = v0;
-			e0 = v1 -> prevE;
-			v0 = e0 -> prevV;
+			e0 = vertex(v1).prevE;
+			v0 = edge(e0).prevV;
 
 			// Create an entry for the new edge
-			e1 = (PolygonEdge*)malloc(sizeof(PolygonEdge));
-			e1 -> e = newEdge;
+			e1 = scratch.edges.size();
+			scratch.edges.push_back(PolygonEdge());
+			edge(e1).e = newEdge;
 
 			// Link the new entry with the adjacent entities
-			e1 -> prevV = v1;
-			e1 -> nextV = v2;
-			v1 -> nextE = e1;
-			v2 -> prevE = e1;
+			edge(e1).prevV = v1;
+			edge(e1).nextV = v2;
+			vertex(v1).nextE = e1;
+			vertex(v2).prevE = e1;
 
 			n--;
 		}else{
 			v0 = v1;
 			e0 = e1;
 			v1 = v2;
-			e1 = v1 -> nextE;
-			v2 = e1 -> nextV;
+			e1 = vertex(v1).nextE;
+			v2 = edge(e1).nextV;
 		}
 	}
 	
-	e2 = v2 -> nextE;
-
-	new Triangle(e0 -> e, e1 -> e, e2 -> e, v0 -> v, v1 -> v, v2 -> v, internal);
+	e2 = vertex(v2).nextE;
 
-	free(e0);
-	free(e1);
-	free(e2);
-	free(v0);
-	free(v1);
-	free(v2);
+	new Triangle(edge(e0).e, edge(e1).e, edge(e2).e, vertex(v0).v, vertex(v1).v, vertex(v2).v,
+		internal);
 
 	n = 0;
 
-	startVertex = NULL;
+	startVertex = -1;
+}
+
+
+/*
+	Polygons reuse the memory of deleted polygons of the same thread
+*/
+void *Polygon::operator new(size_t n){
+	void *p;
+
+	if(scratch.free.empty())
+		return ::operator new(n);
+
+	p = scratch.free.back();
+	scratch.free.pop_back();
+
+	return p;
+}
+
+void Polygon::operator delete(void *p){
+	scratch.free.push_back(p);
 }
 
 
@@ -226,8 +232,11 @@ void Polygon::triangulateVisible(){
 					is counted as exterior.
 */
 Polygon::Polygon(Triangulation *triang, PolygonType tp, bool intern) :
-	type(tp), T(triang), internal(intern), n(0), startVertex(NULL), closed(false), lastVUsed(NULL),
-	lastEUsed(NULL), kernel(NULL) {}
+	type(tp), T(triang), internal(intern), n(0), startVertex(-1), closed(false), lastVUsed(-1),
+	lastEUsed(-1), kernel(NULL) {
+
+	scratch.living++;
+}
 
 
 /*
@@ -242,31 +251,32 @@ Polygon::Polygon(Triangulation *triang, PolygonType tp, bool intern) :
 	@param 	v 	The new vertex
 */
 void Polygon::addVertex(Vertex *v){
-	PolygonVertex *entry;
+	int entry;
 
 	if(closed){
 		fprintf(stderr, "Polygon build error: polygon has already been closed!\n");
 		exit(15);
 	}
 
-	if(n != 0 && lastVUsed != NULL){
+	if(n != 0 && lastVUsed != -1){
 		fprintf(stderr, "Polygon build error: something went wrong while building a polygon to retriangulate....two vertices next to each other!\n");
 		exit(15);
 	}
 
-	entry = (PolygonVertex*)malloc(sizeof(PolygonVertex));
+	entry = scratch.vertices.size();
+	scratch.vertices.push_back(PolygonVertex());
 
-	entry -> v = v;
-	entry -> prevE = lastEUsed;
-	entry -> nextE = NULL;
+	vertex(entry).v = v;
+	vertex(entry).prevE = lastEUsed;
+	vertex(entry).nextE = -1;
 
 	if(n == 0)
 		startVertex = entry;
 	else
-		lastEUsed -> nextV = entry;
+		edge(lastEUsed).nextV = entry;
 
 	lastVUsed = entry;
-	lastEUsed = NULL;
+	lastEUsed = -1;
 
 	n++;
 }
@@ -279,7 +289,7 @@ void Polygon::addVertex(Vertex *v){
 	@param 	e 	The new edge
 */
 void Polygon::addEdge(TEdge *e){
-	PolygonEdge *entry;
+	int entry;
 
 	if(closed){
 		fprintf(stderr, "Polygon build error: polygon has already been closed!\n");
@@ -291,20 +301,21 @@ void Polygon::addEdge(TEdge *e){
 		exit(15);
 	}
 
-	if(lastEUsed != NULL){
+	if(lastEUsed != -1){
 		fprintf(stderr, "Polygon build error: something went wrong while building a polygon to retriangulate....two edges next to each other!\n");
 		exit(15);
 	}
 
-	entry = (PolygonEdge*)malloc(sizeof(PolygonEdge));
+	entry = scratch.edges.size();
+	scratch.edges.push_back(PolygonEdge());
 
-	entry -> e = e;
-	entry -> prevV = lastVUsed;
-	entry -> nextV = NULL;
+	edge(entry).e = e;
+	edge(entry).prevV = lastVUsed;
+	edge(entry).nextV = -1;
 
-	lastVUsed -> nextE = entry;
+	vertex(lastVUsed).nextE = entry;
 
-	lastVUsed = NULL;
+	lastVUsed = -1;
 	lastEUsed = entry;
 }
 
@@ -316,27 +327,28 @@ void Polygon::addEdge(TEdge *e){
 	@param 	e 	The edge to close the polygon with
 */
 void Polygon::close(TEdge *e){
-	PolygonEdge *entry;
+	int entry;
 
 	if(n < 3){
 		fprintf(stderr, "Polygon build error: something went wrong while building a polygon to retriangulate....the polygon is not allowed to have less then three vertices!\n");
 		exit(15);
 	}
 
-	if(lastEUsed != NULL){
+	if(lastEUsed != -1){
 		fprintf(stderr, "Polygon build error: something went wrong while building a polygon to retriangulate....two edges next to each other!\n");
 		exit(15);
 	}
 
-	entry = (PolygonEdge*)malloc(sizeof(PolygonEdge));
+	entry = scratch.edges.size();
+	scratch.edges.push_back(PolygonEdge());
 
-	entry -> e = e;
-	entry -> prevV = lastVUsed;
-	entry -> nextV = startVertex;
-	lastVUsed -> nextE = entry;
-	startVertex -> prevE = entry;
+	edge(entry).e = e;
+	edge(entry).prevV = lastVUsed;
+	edge(entry).nextV = startVertex;
+	vertex(lastVUsed).nextE = entry;
+	vertex(startVertex).prevE = entry;
 
-	lastVUsed = NULL;
+	lastVUsed = -1;
 
 	closed = true;
 }
@@ -381,28 +393,39 @@ void Polygon::changeType(PolygonType tp){
 	Prints the polygon to stderr.
 */
 void Polygon::print(){
-	PolygonVertex *vertex;
-	PolygonEdge *edge;
+	int v, e;
 
 	fprintf(stderr, "Polygon:\n");
 
-	vertex = startVertex;
-	edge = vertex -> nextE;
+	v = startVertex;
+	e = vertex(v).nextE;
 	do{
 		
-		fprintf(stderr, "Vertex %llu\n", (*vertex -> v).getID());
-		fprintf(stderr, "Edge %llu from Vertex %llu to Vertex %llu\n", (*edge -> e).getID(),
-			(*(*edge -> e).getV0()).getID(), (*(*edge -> e).getV1()).getID());
+		fprintf(stderr, "Vertex %llu\n", (*vertex(v).v).getID());
+		fprintf(stderr, "Edge %llu from Vertex %llu to Vertex %llu\n", (*edge(e).e).getID(),
+			(*(*edge(e).e).getV0()).getID(), (*(*edge(e).e).getV1()).getID());
 
-		vertex = edge -> nextV;
-		edge = vertex -> nextE;
+		v = edge(e).nextV;
+		e = vertex(v).nextE;
 		
-	}while(vertex != startVertex);
+	}while(v != startVertex);
 
 	fprintf(stderr, "End of polygon\n\n");
 }
 
 
+/*
+	G ~ E ~ T ~ T ~ E ~ R ~ S
+*/
+
+/*
+	@return 	The number of vertices of the polygon
+*/
+int Polygon::getSize() const{
+	return n;
+}
+
+
 /*
 	O ~ T ~ H ~ E ~ R ~ S
 */
@@ -413,6 +436,7 @@ void Polygon::print(){
 	throws a triangulation error.
 */
 void Polygon::triangulate(){
+	ScopedTimer timer(ProfileSection::TRIANGULATE);
 	if(type == PolygonType::STARSHAPED){
 		
 		if(kernel == NULL){
@@ -433,24 +457,13 @@ void Polygon::triangulate(){
 
 /*
 	Destructor:
-	Cleans up the polygonal chain if necessary.
+	Clears the scratch memory if no other polygon is alive anymore.
 */
 Polygon::~Polygon(){
-	PolygonEdge *e;
-
-	while(startVertex != NULL){
-
-		e = startVertex -> nextE;
-
-		free(startVertex);
-
-		if(e != NULL){
-			startVertex = e -> nextV;
-
-			free(e);
+	scratch.living--;
 
-			e = NULL;
-		}else
-			startVertex = NULL;
+	if(scratch.living == 0){
+		scratch.vertices.clear();
+		scratch.edges.clear();
 	}
 }
@@ -0,0 +1,200 @@
+/*
+ * Copyright 2021 Philipp Mayer - pmayer@cs.sbg.ac.at
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "polygonReader.h"
+
+/*
+	The function fail() reports a broken polygon file and errors with exit code 21.
+
+	@param 	filename 	The name of the polygon file
+	@param 	reason 		The description of the problem
+*/
+[[noreturn]] static void fail(const char *filename, const char *reason){
+	fprintf(stderr, "Reading the polygon file %s failed: %s\n", filename, reason);
+	exit(21);
+}
+
+/*
+	The function readBinary() reads the rings of a file in binary format, the magic bytes
+	have already been consumed.
+
+	@param 	f 			The opened file
+	@param 	filename 	The name of the file
+	@param 	rings 		The vector the rings get appended to
+*/
+static void readBinary(FILE *f, const char *filename, std::vector<std::vector<point>> &rings){
+	uint32_t nrRings, n, i, j;
+	double coords[2];
+
+	if(fread(&nrRings, sizeof(nrRings), 1, f) != 1)
+		fail(filename, "truncated header");
+
+	for(i = 0; i < nrRings; i++){
+		if(fread(&n, sizeof(n), 1, f) != 1)
+			fail(filename, "truncated ring");
+
+		rings.emplace_back();
+		rings.back().reserve(n);
+
+		for(j = 0; j < n; j++){
+			if(fread(coords, sizeof(double), 2, f) != 2)
+				fail(filename, "truncated ring");
+
+			rings.back().push_back({coords[0], coords[1]});
+		}
+	}
+}
+
+/*
+	The function readDat() reads the rings of a file in .dat format, i.e. each ring starts
+	with a quoted name followed by one vertex per line.
+
+	@param 	f 			The opened file
+	@param 	filename 	The name of the file
+	@param 	rings 		The vector the rings get appended to
+*/
+static void readDat(FILE *f, const char *filename, std::vector<std::vector<point>> &rings){
+	char line[256];
+	char *c;
+	point p;
+
+	while(fgets(line, sizeof(line), f) != NULL){
+		c = line;
+		while(*c == ' ' || *c == '\t')
+			c++;
+
+		if(*c == '"')
+			rings.emplace_back();
+		else if(sscanf(c, "%lf %lf", &p.x, &p.y) == 2){
+			if(rings.empty())
+				fail(filename, "vertex before the first ring");
+
+			rings.back().push_back(p);
+		}else if(*c != '\n' && *c != '\r' && *c != '\0')
+			fail(filename, "malformed line");
+	}
+}
+
+/*
+	The function readLine() reads the rings of a file in .line format, i.e. each ring starts
+	with its number of vertices followed by the vertices.
+
+	@param 	f 			The opened file
+	@param 	filename 	The name of the file
+	@param 	rings 		The vector the rings get appended to
+*/
+static void readLine(FILE *f, const char *filename, std::vector<std::vector<point>> &rings){
+	unsigned int n, i;
+	point p;
+
+	while(fscanf(f, "%u", &n) == 1){
+		rings.emplace_back();
+		rings.back().reserve(n);
+
+		for(i = 0; i < n; i++){
+			if(fscanf(f, "%lf %lf", &p.x, &p.y) != 2)
+				fail(filename, "truncated ring");
+
+			rings.back().push_back(p);
+		}
+	}
+
+	if(!feof(f))
+		fail(filename, "malformed ring size");
+}
+
+/*
+	@param 	ring 	A ring of vertices
+	@return 		Twice the signed area of the ring, positive for counterclockwise rings
+*/
+static double signedArea(std::vector<point> const &ring){
+	double area = 0;
+	unsigned int i, j;
+
+	for(i = 0, j = ring.size() - 1; i < ring.size(); j = i++)
+		area = area + ring[j].x * ring[i].y - ring[i].x * ring[j].y;
+
+	return area;
+}
+
+
+/*
+	The function readPolygonFile() reads the rings of a polygon from a file written in .line,
+	.dat or binary format, the format is detected by the content of the file. The repeated
+	first vertex at the end of each ring and consecutive duplicates get removed, afterwards
+	the first ring gets oriented counterclockwise and all other rings clockwise. It errors
+	with exit code 21 if the file can not be read or a ring has less than three vertices.
+
+	@param 	filename 	The name of the polygon file
+	@param 	rings 		The vector the rings get appended to, the first one is the outer
+						polygon and the others are the holes
+*/
+void readPolygonFile(const char *filename, std::vector<std::vector<point>> &rings){
+	FILE *f;
+	char header[sizeof(polygonMagic)];
+	int c;
+	unsigned int i;
+	double area;
+
+	f = fopen(filename, "rb");
+	if(f == NULL){
+		fprintf(stderr, "Opening the polygon file %s failed: %s\n", filename, strerror(errno));
+		exit(21);
+	}
+
+	// Detect the format by the beginning of the file
+	if(fread(header, 1, sizeof(header), f) == sizeof(header) &&
+		memcmp(header, polygonMagic, sizeof(polygonMagic)) == 0)
+		readBinary(f, filename, rings);
+	else{
+		rewind(f);
+
+		do{
+			c = fgetc(f);
+		}while(c == ' ' || c == '\t' || c == '\n' || c == '\r');
+		ungetc(c, f);
+
+		if(c == '"')
+			readDat(f, filename, rings);
+		else
+			readLine(f, filename, rings);
+	}
+
+	fclose(f);
+
+	if(rings.empty())
+		fail(filename, "no polygon found");
+
+	for(i = 0; i < rings.size(); i++){
+		std::vector<point> &ring = rings[i];
+
+		// Remove consecutive duplicates and the repeated first vertex
+		ring.erase(std::unique(ring.begin(), ring.end(),
+			[](point const &a, point const &b){ return a.x == b.x && a.y == b.y; }), ring.end());
+		if(ring.size() > 1 && ring.front().x == ring.back().x && ring.front().y == ring.back().y)
+			ring.pop_back();
+
+		if(ring.size() < 3)
+			fail(filename, "a ring has less than three vertices");
+
+		// The outer polygon is counterclockwise, the holes are clockwise
+		area = signedArea(ring);
+		if(area == 0)
+			fail(filename, "a ring has no area");
+		if((i == 0) != (area > 0))
+			std::reverse(ring.begin(), ring.end());
+	}
+}
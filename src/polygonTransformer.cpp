@@ -18,6 +18,149 @@
 #include "polygonTransformer.h"
 
 
+/*
+	The function tryTranslation() checks a single translation for an orientation change and
+	simplicity and executes it in case it passes both checks.
+
+	@param 	T 	The triangulation the polygon lives in
+	@param 	index 	The index of the moving vertex in the triangulation
+	@param 	dx 		The generated x-component of the translation vector
+	@param 	dy 		The generated y-component of the translation vector
+	@param 	checked True if the same translation already passed both checks in a speculative
+					check which is still up to date, then the checks get skipped
+	@param 	crossed The number of triangles passed by the speculative check, just used by
+					the hybrid engine if checked is true
+	@return 		Indicates whether the translation was rejected, aborted or fully processed
+
+	Note:
+		- The translation by retriangulation gets the components of the translation vector in
+			swapped order, so the parallel translation phase must know the effective vector, see
+			getEffectiveTranslation()
+		- The hybrid engine checks the translation as translation by retriangulation, but
+			without swapping the components. If the EngineSelector predicts the kinetic
+			translation to be cheaper, the checked translation gets discarded and the same
+			translation gets executed as kinetic translation. The checks of both engines
+			only differ in the splits of the kinetic translations at holes, so the hybrid
+			engine rejects these translations.
+*/
+enum Executed tryTranslation(Triangulation * const T, const int index, const double dx,
+	const double dy, const bool checked, const unsigned int crossed){
+
+	Translation *trans;
+	bool simple = true, orientationChange = false;
+	enum Executed ex = Executed::REJECTED;
+	Engine engine;
+	unsigned int triangles = crossed;
+	unsigned long long flips = 0, retriangulated = 0;
+	std::chrono::steady_clock::time_point start;
+	double time, scale = 0;
+	ScopedSpan span("translation", "translation", Tracer::sampleTranslation());
+
+	// The scale of a recorded translation depends on the surrounding before the execution
+	if(MoveLog::recording)
+		scale = MoveLog::getScale((*T).getVertex(index), dx, dy);
+
+	if(Settings::kinetic){
+		trans = new TranslationKinetic(T, index, dx, dy);
+		engine = Engine::KINETIC;
+	}else if(Settings::hybrid){
+		trans = new TranslationRetriangulation(T, index, dx, dy);
+		engine = Engine::RETRIANGULATION;
+	}else{
+		trans = new TranslationRetriangulation(T, index, dy, dx);
+		engine = Engine::RETRIANGULATION;
+	}
+
+	// Check for an orientation change
+	if(!checked)
+		orientationChange = (*trans).checkOrientation();
+
+	if(!orientationChange){
+		// Check whether the translation leads to a simple polygon
+		if(!checked){
+			simple = (*trans).checkSimplicityOfTranslation();
+			triangles = (*trans).getCrossedTriangles();
+		}
+
+		if(simple){
+			// Let the hybrid engine choose the cheaper engine for the translation
+			if(Settings::hybrid){
+				engine = EngineSelector::choose(triangles);
+
+				if(engine == Engine::KINETIC){
+					(*trans).discard();
+					delete trans;
+
+					trans = new TranslationKinetic(T, index, dx, dy);
+				}
+			}
+
+			flips = Statistics::flips;
+			retriangulated = Statistics::retriangulated;
+			start = std::chrono::steady_clock::now();
+
+			// Try to execute the translation
+			ex = (*trans).execute();
+
+			// Count executed translations
+			switch(ex){
+				case Executed::FULL:
+					Statistics::translationsPerf++;
+					break;
+				case Executed::PARTIAL:
+					Statistics::translationsPerf++;
+					break;
+				case Executed::UNDONE:
+					Statistics::undone++;
+					break;
+				case Executed::REJECTED:
+				default:
+					break;
+			}
+		}
+	}
+
+	delete trans;
+
+	// Record the costs of the executed translation
+	if(!orientationChange && simple){
+		time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+		Statistics::addEngineMove(engine, time);
+		if(Settings::hybrid)
+			EngineSelector::record(engine, triangles, Statistics::flips - flips,
+				Statistics::retriangulated - retriangulated);
+	}
+
+	if(MoveLog::recording || MoveLog::replaying)
+		MoveLog::addTranslation(index, dx, dy, scale, engine, ex);
+
+	span.setArg("index", index);
+	span.setArg("result", (int)ex);
+
+	return ex;
+}
+
+/*
+	The function getEffectiveTranslation() returns the translation vector a call of
+	tryTranslation() with the generated components dx and dy really applies.
+
+	@param 	dx 	The generated x-component of the translation vector
+	@param 	dy 	The generated y-component of the translation vector
+	@param 	tx 	The effective x-component of the translation vector
+	@param 	ty 	The effective y-component of the translation vector
+*/
+void getEffectiveTranslation(const double dx, const double dy, double &tx, double &ty){
+	if(Settings::kinetic || Settings::hybrid){
+		tx = dx;
+		ty = dy;
+	}else{
+		tx = dy;
+		ty = dx;
+	}
+}
+
+
 /*
 	The function transformPolygonByMoves() transforms a polygon by randomly selecting a
 	vertex and a direction to move and then randomly computing a distance to shift in
@@ -33,17 +176,37 @@
 			which should be tried
 		- For polygons with holes the vertex also is randomly selected, i.e. it can be from
 			the outer polygon as well as of one of the inner polygons
+		- If multiple threads are enabled and the polygon has no holes, the translations are
+			executed by transformPolygonByMovesParallel(), transformPolygonByMovesIndependent()
+			or transformPolygonByMovesSpeculative() depending on the parallel mode
+		- If bounded distances are enabled, the distance gets drawn from the normal
+			distribution truncated to the free distances of the vertex in the direction of
+			the translation and the opposite one
+		- If a target acceptance rate is given, the distances get scaled by the
+			AcceptanceController, which gets adjusted by the results of the moves
+		- If the relayout is enabled, the triangulation gets relayouted before the moves
+			in case the polygon has doubled since the last relayout
+		- If local blocks are enabled, the vertices of the sequential moves get selected
+			by the VertexScheduler
+		- If a log gets replayed, the vertices and the translation vectors are taken from
+			the MoveLog instead
+		- If batched proposals are enabled, the vertices, the directions and the normally
+			distributed values of the distances are taken from the ProposalBuffer, just
+			bounded distances still get drawn one by one
 */
 int transformPolygonByMoves(Triangulation * const T, const int iterations){
 	int index = 0;
-	double dx = 0, dy = 0, stddev, alpha, r;
-	bool simple, orientationChange;
-	Translation *trans;
+	double dx = 0, dy = 0, stddev, alpha, r, tx, ty, beta, cosAlpha, sinAlpha, z = 0;
 	int n = (*T).getActualNumberOfVertices();
 	int performedTranslations = 0;
 	Vertex *v;
 	enum Executed ex = Executed::FULL;
 	int div;
+	double startTime = (*Settings::timer).elapsedTime();
+	ScopedSpan span("transformPolygonByMoves", "phase");
+
+	span.setArg("iterations", iterations);
+	span.setArg("vertices", n);
 
 	if(iterations <= 1000)
 		div = 0.1 * iterations;
@@ -57,74 +220,143 @@ int transformPolygonByMoves(Triangulation * const T, const int iterations){
 	if(div == 0)
 		div = 1;
 
-	// Try the given number of moves
-	for(int i = 0; i < iterations; i++){
+	(*T).relayoutIfGrown();
+
+	if(parallelTranslationsApplicable(T)){
+		switch(Settings::parallelMode){
+			case ParallelMode::PARTITION:
+				performedTranslations = transformPolygonByMovesParallel(T, iterations);
+				break;
+			case ParallelMode::INDEPENDENTSET:
+				performedTranslations = transformPolygonByMovesIndependent(T, iterations);
+				break;
+			case ParallelMode::SPECULATIVE:
+				performedTranslations = transformPolygonByMovesSpeculative(T, iterations);
+				break;
+		}
 
-		// Chose a vertex randomly
-		index = (*Settings::generator).getRandomIndex(n);
+		recordTranslationPhase(iterations, performedTranslations, startTime);
 
-		v = (*T).getVertex(index);
+		// The parallel phases are controlled as a whole
+		if(Settings::controller != NULL)
+			(*Settings::controller).record(iterations, performedTranslations);
 
-		// Chose a direction randomly and get a suitable stddev for the distance
-		alpha = (*Settings::generator).getDoubleUniform(- M_PI, M_PI);
-		stddev = (*v).getDirectedEdgeLength(alpha);
+		span.setArg("performed", performedTranslations);
+		traceSize(T);
 
-		// Generate a random distance
-		r = (*Settings::generator).getDoubleNormal(stddev / 2, stddev / Settings::stddevDiv);
+		return performedTranslations;
+	}
 
-		// Split the translation into x- and y-components
-		dx = r * cos(alpha);
-		dy = r * sin(alpha);
+	if(Settings::scheduler != NULL)
+		(*Settings::scheduler).prepare(T);
 
-		if(Settings::kinetic)
-			trans = new TranslationKinetic(T, index, dx, dy);
-		else
-			trans = new TranslationRetriangulation(T, index, dy, dx);
+	// The buffered proposals just need indices if the scheduler does not select the vertices
+	if(Settings::proposals != NULL)
+		(*Settings::proposals).setRange(Settings::scheduler != NULL ? 0 : n);
 
-		// Check for an orientation change
-		orientationChange = (*trans).checkOrientation();
+	// Try the given number of moves
+	for(int i = 0; i < iterations; i++){
 
-		if(!orientationChange){
-			// Check whether the translation leads to a simple polygon
-			simple = (*trans).checkSimplicityOfTranslation();
+		// Take the move from the replayed log instead of drawing it, moves of vertices which
+		// do not exist in the replayed polygon get skipped
+		if(MoveLog::replaying){
+			if(!MoveLog::nextMove(T, index, dx, dy))
+				continue;
+		}else{
+			// Chose a vertex and a direction randomly, either drawn now or taken from the
+			// buffered proposals
+			if(Settings::proposals != NULL){
+				(*Settings::proposals).next(index, alpha, cosAlpha, sinAlpha, z);
+
+				if(Settings::scheduler != NULL)
+					index = (*Settings::scheduler).getIndex();
+			}else{
+				if(Settings::scheduler != NULL)
+					index = (*Settings::scheduler).getIndex();
+				else
+					index = (*Settings::generator).getRandomIndex(n);
+
+				alpha = (*Settings::generator).getDoubleUniform(- M_PI, M_PI);
+				cosAlpha = cos(alpha);
+				sinAlpha = sin(alpha);
+			}
 
-			if(simple){
-				// Try to execute the translation
-				ex = (*trans).execute();
+			v = (*T).getVertex(index);
 
-				// Count executed translations
-				if(ex != Executed::REJECTED){
-					performedTranslations++;
+			// Get a suitable stddev for the distance
+			stddev = (*v).getDirectedEdgeLength(alpha);
+			if(Settings::controller != NULL)
+				stddev = (*Settings::controller).getScale() * stddev;
 
-					switch(ex){
-						case Executed::FULL:
-							Statistics::translationsPerf++;
-							break;
-						case Executed::PARTIAL:
-							Statistics::translationsPerf++;
-							break;
-						case Executed::UNDONE:
-							Statistics::undone++;
-							performedTranslations--;
-							break;
-						case Executed::REJECTED:
-						default:
-							break;
-					}
+			// Generate a random distance
+			if(Settings::boundedDistance){
+				// Truncate the distance to the free distances of the vertex in the direction
+				// of the translation really applied and in the opposite direction
+				getEffectiveTranslation(cosAlpha, sinAlpha, tx, ty);
+				beta = atan2(ty, tx);
+
+				r = (*Settings::generator).getDoubleNormalTruncated(stddev / 2,
+					fabs(stddev) / Settings::stddevDiv, - (*v).getFreeDistance(beta > 0 ? beta - M_PI : beta + M_PI),
+					(*v).getFreeDistance(beta));
+			}else if(Settings::proposals != NULL)
+				r = ProposalBuffer::getDistance(stddev / 2, stddev / Settings::stddevDiv, z);
+			else
+				r = (*Settings::generator).getDoubleNormal(stddev / 2, stddev / Settings::stddevDiv);
 
-				}
-			}
+			// Split the translation into x- and y-components
+			dx = r * cosAlpha;
+			dy = r * sinAlpha;
 		}
 
-		delete trans;
+		ex = tryTranslation(T, index, dx, dy);
+
+		// Count executed translations
+		if(ex == Executed::FULL || ex == Executed::PARTIAL)
+			performedTranslations++;
+
+		if(Settings::controller != NULL)
+			(*Settings::controller).record(1, ex == Executed::FULL || ex == Executed::PARTIAL);
 
 		if(i % div == 0 && Settings::feedback != FeedbackMode::MUTE)
 			fprintf(stderr, "%.1f%% of %d translations performed after %f seconds \n", (double)i / (double)iterations * 100, iterations, (*Settings::timer).elapsedTime());
 	}
 
+	recordTranslationPhase(iterations, performedTranslations, startTime);
+
+	span.setArg("performed", performedTranslations);
+	traceSize(T);
+
 	return performedTranslations;
 }
 
+/*
+	The function recordTranslationPhase() adds the results of a translation phase to the
+	statistics.
+
+	@param 	tries 		The number of moves which have been tried
+	@param 	performed 	The number of moves which have been executed at least partially
+	@param 	startTime 	The time the translation phase started at (in seconds)
+*/
+void recordTranslationPhase(const int tries, const int performed, const double startTime){
+	Statistics::phaseTries += tries;
+	Statistics::phaseTranslations += performed;
+	Statistics::phaseTime += (*Settings::timer).elapsedTime() - startTime;
+}
+
+/*
+	The function traceSize() adds the actual number of vertices and triangles of the
+	triangulation to the trace if tracing is enabled.
+
+	@param 	T 	The triangulation the polygon lives in
+*/
+void traceSize(Triangulation const * const T){
+	if(!Tracer::enabled)
+		return;
+
+	Tracer::counter("size", {std::make_pair("vertices", (double)(*T).getActualNumberOfVertices()),
+		std::make_pair("triangles", (double)Triangle::getNumberOfExistingTriangles())});
+}
+
 
 /*
 	The function growPolygonBy() grows a polygon by n insertions.
@@ -134,15 +366,31 @@ int transformPolygonByMoves(Triangulation * const T, const int iterations){
 	@param 	n 		The number of vertices to insert
 
 	Note:
-		This function works just for polygons without holes!
+		- This function works just for polygons without holes!
+		- If bulk growth is enabled, the insertions are done by growPolygonByBulk()
+		- If direct insertion is enabled, the new vertices get placed by executeDirect() and
+			bulk growth is not used
+		- If the relayout is enabled, the triangulation gets relayouted whenever the polygon
+			has doubled since the last relayout
+		- If a log gets replayed, the edges to insert in are taken from the MoveLog
 */
 void growPolygonBy(Triangulation * const T, const unsigned int pID, const int n){
-	int index, actualN, i;
+	int i;
 	Insertion *in;
 	bool ok;
 	int div;
 	int counter = 0;
 	TEdge *e = NULL;
+	Vertex *v;
+	ScopedSpan span("growPolygonBy", "phase");
+
+	span.setArg("pID", pID);
+	span.setArg("insertions", n);
+
+	if(Settings::bulkGrowth && !Settings::directInsertion && Settings::nrInnerPolygons == 0 && (*T).getActualNrInnerPolygons() == 0){
+		growPolygonByBulk(T, pID, n);
+		return;
+	}
 
 	if(n <= 1000)
 		div = 0.1 * n;
@@ -158,26 +406,51 @@ void growPolygonBy(Triangulation * const T, const unsigned int pID, const int n)
 
 	for(i = 0; i < n;){
 
-		actualN = (*T).getActualNumberOfVertices(pID);
+		// Take the edge from the replayed log, recorded choices of unstable edges get
+		// skipped and recorded insertions which are not possible in the replay still count,
+		// such that the following proposals stay aligned to the log
+		if(MoveLog::replaying){
+			if(!MoveLog::nextInsertion(T, pID, e))
+				continue;
 
-		// Chose randomly an edge to insert in
-		if(Settings::weightedEdgeSelection){
-			e = (*T).getRandomEdgeWeighted(pID);
-
-			in = new Insertion(T, pID, e);
+			if(e == NULL){
+				i++;
+				continue;
+			}
 		}else{
-			index = (*Settings::generator).getRandomIndex(actualN);
+			// Chose randomly an edge to insert in, the SelectionTree just contains edges
+			// fulfilling the stability criteria for insertions with positive weight
+			e = (*T).getRandomEdgeWeighted(pID);
 
-			in = new Insertion(T, pID, index);
+			if(e == NULL){
+				fprintf(stderr, "Error: The polygon has no edge suitable for an insertion!\n");
+				exit(18);
+			}
 		}
 
+		in = new Insertion(T, pID, e);
+
 		// Check whether the chosen edge fulfills the stability criteria for insertions
 		ok = (*in).checkStability();
 
+		if(MoveLog::recording){
+			v = (*e).getV0();
+			if((*v).getToNext() != e)
+				v = (*e).getV1();
+
+			MoveLog::addInsertion(pID, (*v).getIndex(), ok);
+		}
+
 		// Recognized when it is hard to find a suitable edge to insert in
 		if(!ok){
 			delete in;
 
+			if(MoveLog::replaying){
+				MoveLog::skipInsertion();
+				i++;
+				continue;
+			}
+
 			counter++;
 			if(counter > 10000 && Settings::feedback == FeedbackMode::VERBOSE)
 				fprintf(stderr, "Warning: %d unsuccessful tries to find a suitable edge to insert in\n", counter);
@@ -188,19 +461,188 @@ void growPolygonBy(Triangulation * const T, const unsigned int pID, const int n)
 		counter = 0;
 
 		// Execute the insertion and try to move the new vertex away from the edge
-		(*in).execute();
+		if(Settings::directInsertion){
+			(*in).executeDirect();
+		}else{
+			(*in).execute();
 
-		(*in).translate();
+			(*in).translate();
+		}
 
 		delete in;
 
+		if(MoveLog::recording)
+			MoveLog::endInsertion();
+
 		// Just increase the iteration count if a vertex has really been inserted
 		i++;
 
+		(*T).relayoutIfGrown();
+
 		if(i % div == 0 && Settings::feedback != FeedbackMode::MUTE)
 			fprintf(stderr, "%.1f%% of %d insertions performed after %f seconds \n", (double)i / (double)n * 100,
 				n, (*Settings::timer).elapsedTime());
 	}
+
+	traceSize(T);
+}
+
+/*
+	The function growPolygonByBulk() grows a polygon by n insertions which are done in
+	rounds. Each round it selects a batch of polygon edges by the usual edge
+	selection, just taking edges which are not adjacent to an already selected one. It
+	splits all of them and afterwards translates the new vertices in parallel, each one
+	restricted to its reserved 2-ring neighbourhood. Translations of new vertices whose
+	neighbourhood could not be reserved or which would leave it are continued
+	sequentially at the end of the round.
+
+	@param 	T 		The triangulation the polygon lives in
+	@param	pID 	The ID of the polygon
+	@param 	n 		The number of vertices to insert
+
+	Note:
+		- The splits stay sequential, as they are cheap compared to the translations but
+			change the vertex list and the SelectionTree of the polygon
+		- Each new vertex draws its translations from its own random generator split from
+			the global one. The workers do not touch the SelectionTree, the updates of its
+			entries get recorded per insertion and applied in the order of the insertions
+			after all workers are done, so for a fixed seed the result does not depend on
+			the number of threads
+		- A round holds 1/512 of the current polygon size, but at least one insertion
+		- If the relayout is enabled, the triangulation gets relayouted between the rounds
+			whenever the polygon has doubled since the last relayout
+		- This function works just for polygons without holes!
+*/
+void growPolygonByBulk(Triangulation * const T, const unsigned int pID, const int n){
+	int actualN, roundSize, tries, size, k, div;
+	int inserted = 0, lastPrint = 0;
+	unsigned long long nrBounced;
+	Insertion *in;
+	TEdge *e;
+	WorkerPool *pool = getWorkerPool();
+	std::vector<Insertion*> insertions;
+	std::vector<RandomGenerator*> generators;
+	std::vector<unsigned int> counts;
+	std::vector<int> results;
+	std::vector<Vertex*> marked, reserved;
+	std::vector< std::vector<STEntry<TEdge*>*> > stUpdates;
+	std::vector< std::vector<EngineRecord> > engineRecords;
+	Timer wall;
+	CpuTimer cpu;
+	ScopedSpan span("growPolygonByBulk", "phase");
+
+	div = std::max(n / 100, 1);
+
+	while(inserted < n){
+		actualN = (*T).getActualNumberOfVertices(pID);
+		roundSize = std::min(std::max(actualN / 512, 1), n - inserted);
+
+		wall.start();
+		cpu.start();
+
+		// Select pairwise non-adjacent edges
+		for(tries = 0; (int)insertions.size() < roundSize && tries < 4 * roundSize; tries++){
+			e = (*T).getRandomEdgeWeighted(pID);
+
+			if(e == NULL){
+				fprintf(stderr, "Error: The polygon has no edge suitable for an insertion!\n");
+				exit(18);
+			}
+
+			in = new Insertion(T, pID, e);
+
+			if((*(*e).getV0()).getRegion() != -1 || (*(*e).getV1()).getRegion() != -1 ||
+				!(*in).checkStability()){
+
+				delete in;
+				continue;
+			}
+
+			(*(*e).getV0()).setRegion(0);
+			(*(*e).getV1()).setRegion(0);
+			marked.push_back((*e).getV0());
+			marked.push_back((*e).getV1());
+
+			insertions.push_back(in);
+		}
+
+		for(auto& v : marked)
+			(*v).setRegion(-1);
+		marked.clear();
+
+		// Split the edges
+		size = insertions.size();
+		for(k = 0; k < size; k++){
+			(*insertions[k]).execute();
+			generators.push_back((*Settings::generator).split());
+		}
+
+		// Reserve the neighbourhoods of the new vertices, each one gets its own region
+		results.assign(size, 0);
+		counts.assign(size, 0);
+		for(k = 0; k < size; k++){
+			if(reserveNeighbourhood((*insertions[k]).getNewVertex(), k, reserved))
+				results[k] = -1;
+		}
+
+		// Translate the new vertices concurrently
+		stUpdates.assign(size, std::vector<STEntry<TEdge*>*>());
+		engineRecords.assign(size, std::vector<EngineRecord>());
+		TEdge::deferSTUpdates(true);
+		EngineSelector::deferRecords(true);
+
+		(*pool).run(size, [&](const int j){
+			if(results[j] == -1){
+				results[j] = (*insertions[j]).translate(generators[j], j, counts[j]) ? 1 : 0;
+				TEdge::takeDeferredSTUpdates(stUpdates[j]);
+				EngineSelector::takeDeferredRecords(engineRecords[j]);
+			}
+		});
+
+		TEdge::deferSTUpdates(false);
+		EngineSelector::deferRecords(false);
+
+		// Update the SelectionTree and the EngineSelector in the order of the insertions
+		for(auto& u : stUpdates)
+			TEdge::applySTUpdates(u);
+		for(auto& r : engineRecords)
+			EngineSelector::applyRecords(r);
+
+		for(auto& v : reserved)
+			(*v).setRegion(-1);
+		reserved.clear();
+
+		// Continue the translations which could not be finished concurrently
+		nrBounced = 0;
+		for(k = 0; k < size; k++){
+			if(results[k] == 0){
+				nrBounced++;
+				(*insertions[k]).translate(generators[k], -1, counts[k]);
+			}
+
+			if(Settings::feedback == FeedbackMode::VERBOSE && counts[k] == Settings::insertionTries)
+				fprintf(stderr, "Warning: Was not able to find a suitable translation after the insertion!\n");
+
+			delete insertions[k];
+			delete generators[k];
+		}
+		insertions.clear();
+		generators.clear();
+
+		(*T).relayoutIfGrown();
+
+		recordParallelRound(size - nrBounced, nrBounced, cpu.elapsedTime(), wall.elapsedTime());
+
+		inserted = inserted + size;
+
+		if(inserted - lastPrint >= div && Settings::feedback != FeedbackMode::MUTE){
+			lastPrint = inserted;
+			fprintf(stderr, "%.1f%% of %d insertions performed after %f seconds (%llu of %d continued sequentially)\n",
+				(double)inserted / (double)n * 100, n, (*Settings::timer).elapsedTime(), nrBounced, size);
+		}
+	}
+
+	traceSize(T);
 }
 
 
@@ -213,6 +655,7 @@ void growPolygonBy(Triangulation * const T, const unsigned int pID, const int n)
 */
 void strategyNoHoles0(Triangulation * const T){
 	int performed;
+	ScopedSpan span("strategyNoHoles0", "strategy");
 
 
 	// Transform the initial polygon
@@ -286,6 +729,7 @@ void strategyNoHoles1(Triangulation * const T){
 	int performed;
 	int left;
 	int grow;
+	ScopedSpan span("strategyNoHoles1", "strategy");
 
 
 	// Transform the initial polygon
@@ -357,6 +801,7 @@ void strategyWithHoles0(Triangulation * const T){
 	int nrInsertions;
 	unsigned int i, k;
 	int actualN;
+	ScopedSpan span("strategyWithHoles0", "strategy");
 
 
 	// Transform the initial polygon
@@ -385,6 +830,8 @@ void strategyWithHoles0(Triangulation * const T){
 	// the program would run forever?!
 	k = 0;
 	while(performed != 0 && k < 20){
+		ScopedSpan stage("doublingRound", "stage");
+
 		performed = 0;
 
 		// Double up the sizes of the inner polygons (if still possible)
@@ -465,6 +912,7 @@ void strategyWithHoles1(Triangulation * const T){
 	int nrInsertions;
 	unsigned int i, k;
 	int actualN;
+	ScopedSpan span("strategyWithHoles1", "strategy");
 
 
 	// Do some translations
@@ -509,8 +957,12 @@ void strategyWithHoles1(Triangulation * const T){
 
 
 	// Insert the holes into the the polygon
-	for(i = 0; i < Settings::nrInnerPolygons; i++){
-		insertHole(T);
+	{
+		ScopedSpan stage("insertHoles", "stage");
+
+		for(i = 0; i < Settings::nrInnerPolygons; i++){
+			insertHole(T);
+		}
 	}
 
 	if(Settings::feedback != FeedbackMode::MUTE)
@@ -561,6 +1013,8 @@ void strategyWithHoles1(Triangulation * const T){
 
 	// Try to inflate the holes and shrink the polygon around them
 	for(k = 0; k < 10; k++){
+		ScopedSpan stage("inflateRound", "stage");
+
 		for(i = 1; i <= Settings::nrInnerPolygons; i++){
 			if(Settings::feedback != FeedbackMode::MUTE)
 				fprintf(stderr, "Inflate the hole with ID %d\n", i);
@@ -572,6 +1026,8 @@ void strategyWithHoles1(Triangulation * const T){
 	}
 
 	for(k = 0; k < 10; k++){
+		ScopedSpan stage("shrinkRound", "stage");
+
 		for(i = 1; i <= Settings::nrInnerPolygons; i++){
 			if(Settings::feedback != FeedbackMode::MUTE)
 				fprintf(stderr, "Shrink the polygon around the hole with ID %d\n", i);
@@ -610,6 +1066,8 @@ void strategyWithHoles1(Triangulation * const T){
 	// the program would run forever?!
 	k = 0;
 	while(performed != 0 && k < 20){
+		ScopedSpan stage("doublingRound", "stage");
+
 		performed = 0;
 
 		// Double up the sizes of the inner polygons (if still possible)
@@ -690,6 +1148,9 @@ void shrinkAroundHole(Triangulation * const T, int holeIndex, int offset){
 	Translation *trans;
 	bool orientationChange, simple;
 	Executed ex;
+	ScopedSpan span("shrinkAroundHole", "phase");
+
+	span.setArg("hole", holeIndex);
 
 	for(i = 0; i < n; i++){
 
@@ -778,6 +1239,9 @@ void inflateHole(Triangulation * const T, int holeIndex){
 	bool orientationChange, simple;
 	Executed ex;
 	int index;
+	ScopedSpan span("inflateHole", "phase");
+
+	span.setArg("hole", holeIndex);
 
 	for(i = 0; i < n; i++){
 
@@ -0,0 +1,272 @@
+/*
+ * Copyright 2021 Philipp Mayer - pmayer@cs.sbg.ac.at
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "profiler.h"
+
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+
+#include "settings.h"
+
+/*
+	S ~ T ~ A ~ T ~ I ~ C 	V ~ A ~ R ~ I ~ A ~ B ~ L ~ E ~ S
+*/
+
+/*
+	The flag for enabling the measurements
+*/
+bool Profiler::enabled = false;
+
+/*
+	The registry of the counters
+*/
+std::mutex Profiler::lock;
+std::vector<ProfileCounters*> Profiler::live;
+ProfileSectionCounters Profiler::finished[nrProfileSections] = {};
+
+/*
+	The counters of each thread
+*/
+thread_local ProfileCounters Profiler::counters;
+
+
+/*
+	C ~ O ~ N ~ S ~ T ~ R ~ U ~ C ~ T ~ O ~ R ~ S
+*/
+
+/*
+	Constructor:
+	Registers the counters of the calling thread at the Profiler.
+*/
+ProfileCounters::ProfileCounters(){
+	memset(sections, 0, sizeof(sections));
+	memset(depth, 0, sizeof(depth));
+
+	Profiler::registerCounters(this);
+}
+
+
+/*
+	D ~ E ~ S ~ T ~ R ~ U ~ C ~ T ~ O ~ R
+*/
+
+/*
+	Destructor:
+	Hands the counters of a finishing thread over to the Profiler.
+*/
+ProfileCounters::~ProfileCounters(){
+	Profiler::unregisterCounters(this);
+}
+
+
+/*
+	P ~ R ~ I ~ V ~ A ~ T ~ E 	M ~ E ~ M ~ B ~ E ~ R 	F ~ U ~ N ~ C ~ T ~ I ~ O ~ N ~ S
+*/
+
+/*
+	The function merge() adds the counters of all code sections to other counters.
+
+	@param 	to 		The counters to add to
+	@param 	from 	The counters to add
+*/
+void Profiler::merge(ProfileSectionCounters * const to, ProfileSectionCounters const * const from){
+	unsigned int i, j;
+
+	for(i = 0; i < nrProfileSections; i++){
+		to[i].count = to[i].count + from[i].count;
+		to[i].total = to[i].total + from[i].total;
+		to[i].max = std::max(to[i].max, from[i].max);
+
+		for(j = 0; j < profileBuckets; j++)
+			to[i].buckets[j] = to[i].buckets[j] + from[i].buckets[j];
+	}
+}
+
+/*
+	The function getPercentile() computes a percentile of the durations of a code
+	section by its histogram.
+
+	@param 	s 	The counters of the code section
+	@param 	p 	The percentile in [0, 1]
+	@return 	The geometric middle of the bucket containing the percentile (in
+				nanoseconds), 0 if there are no measurements
+*/
+double Profiler::getPercentile(ProfileSectionCounters const &s, const double p){
+	unsigned long long rank, sum = 0;
+	unsigned int i, e, m;
+	double low, high;
+
+	if(s.count == 0)
+		return 0;
+
+	rank = (unsigned long long)ceil(p * s.count);
+	if(rank == 0)
+		rank = 1;
+
+	for(i = 0; i < profileBuckets; i++){
+		sum = sum + s.buckets[i];
+		if(sum >= rank)
+			break;
+	}
+
+	// Durations below profileSubBuckets nanoseconds have their own buckets
+	if(i < profileSubBuckets)
+		return i;
+
+	e = i / profileSubBuckets;
+	m = i % profileSubBuckets;
+	low = ldexp(profileSubBuckets + m, e - 3);
+	high = ldexp(profileSubBuckets + m + 1, e - 3);
+
+	return sqrt(low * high);
+}
+
+
+/*
+	O ~ T ~ H ~ E ~ R ~ S
+*/
+
+/*
+	The function registerCounters() adds the counters of a new thread to the registry.
+
+	@param 	c 	The counters of the thread
+*/
+void Profiler::registerCounters(ProfileCounters * const c){
+	std::lock_guard<std::mutex> guard(lock);
+
+	live.push_back(c);
+}
+
+/*
+	The function unregisterCounters() removes the counters of a finishing thread from
+	the registry and merges them into the counters of the finished threads.
+
+	@param 	c 	The counters of the thread
+*/
+void Profiler::unregisterCounters(ProfileCounters * const c){
+	std::lock_guard<std::mutex> guard(lock);
+
+	live.erase(std::remove(live.begin(), live.end(), c), live.end());
+	merge(finished, (*c).sections);
+}
+
+/*
+	The function record() adds one measurement to the counters of the calling thread.
+
+	@param 	s 	The measured code section
+	@param 	ns 	The duration (in nanoseconds)
+*/
+void Profiler::record(const ProfileSection s, const unsigned long long ns){
+	ProfileSectionCounters &c = counters.sections[(unsigned int)s];
+	unsigned int e, index;
+
+	c.count++;
+	c.total = c.total + ns;
+	if(ns > c.max)
+		c.max = ns;
+
+	// The bucket is given by the exponent and the next three bits of the duration
+	if(ns < profileSubBuckets)
+		index = ns;
+	else{
+		e = 63 - __builtin_clzll(ns);
+		index = e * profileSubBuckets + ((ns >> (e - 3)) & (profileSubBuckets - 1));
+	}
+
+	c.buckets[index]++;
+}
+
+/*
+	@param 	s 	A code section
+	@return 	The name of the code section in the report
+*/
+const char *Profiler::getName(const ProfileSection s){
+	switch(s){
+		case ProfileSection::ORIENTATION: return "checkOrientation";
+		case ProfileSection::SIMPLICITY: return "checkSimplicityOfTranslation";
+		case ProfileSection::KINETIC: return "executeKinetic";
+		case ProfileSection::RETRIANGULATION: return "executeRetriangulation";
+		case ProfileSection::TRIANGULATE: return "triangulate";
+		case ProfileSection::INSERTIONEXECUTE: return "insertionExecute";
+		case ProfileSection::INSERTIONTRANSLATE: return "insertionTranslate";
+		case ProfileSection::GLOBALCHECK: return "globalCheck";
+		case ProfileSection::OUTPUT: return "output";
+	}
+
+	return "unknown";
+}
+
+/*
+	The function writeReport() merges the counters of all threads and writes the
+	count, the total, the mean and the percentiles of the durations of each code
+	section into a JSON file.
+
+	@param 	filename 	The name of the file
+
+	Note:
+		- Must not be called while other threads measure anything
+		- Sections can be nested in other sections, e.g. the translations of the
+			insertions, so their totals can add up to more than the elapsed time
+*/
+void Profiler::writeReport(const char *filename){
+	ProfileSectionCounters *all = new ProfileSectionCounters[nrProfileSections]();
+	ProfileSectionCounters *s;
+	unsigned int i;
+	FILE *f;
+
+	f = fopen(filename, "w");
+	if(f == NULL){
+		fprintf(stderr, "Profiler error: could not open the file %s\n", filename);
+		delete[] all;
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> guard(lock);
+
+		merge(all, finished);
+		for(auto const& c : live)
+			merge(all, (*c).sections);
+	}
+
+	fprintf(f, "{\n");
+	fprintf(f, "\t\"elapsed_s\": %.6f,\n", (*Settings::timer).elapsedTime());
+	fprintf(f, "\t\"threads\": %u,\n", Settings::threads);
+	fprintf(f, "\t\"sections\": [\n");
+
+	for(i = 0; i < nrProfileSections; i++){
+		s = &all[i];
+
+		fprintf(f, "\t\t{\n");
+		fprintf(f, "\t\t\t\"name\": \"%s\",\n", getName((ProfileSection)i));
+		fprintf(f, "\t\t\t\"count\": %llu,\n", (*s).count);
+		fprintf(f, "\t\t\t\"total_s\": %.9f,\n", (double)(*s).total / 1e9);
+		fprintf(f, "\t\t\t\"mean_us\": %.3f,\n",
+			(*s).count > 0 ? (double)(*s).total / (*s).count / 1e3 : 0);
+		fprintf(f, "\t\t\t\"p50_us\": %.3f,\n", getPercentile(*s, 0.5) / 1e3);
+		fprintf(f, "\t\t\t\"p90_us\": %.3f,\n", getPercentile(*s, 0.9) / 1e3);
+		fprintf(f, "\t\t\t\"p99_us\": %.3f,\n", getPercentile(*s, 0.99) / 1e3);
+		fprintf(f, "\t\t\t\"max_us\": %.3f\n", (double)(*s).max / 1e3);
+		fprintf(f, "\t\t}%s\n", i + 1 < nrProfileSections ? "," : "");
+	}
+
+	fprintf(f, "\t]\n");
+	fprintf(f, "}\n");
+
+	fclose(f);
+	delete[] all;
+}
@@ -0,0 +1,188 @@
+/*
+ * Copyright 2021 Philipp Mayer - pmayer@cs.sbg.ac.at
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "proposalBuffer.h"
+
+/*
+	P ~ R ~ I ~ V ~ A ~ T ~ E 	M ~ E ~ M ~ B ~ E ~ R 	F ~ U ~ N ~ C ~ T ~ I ~ O ~ N ~ S
+*/
+
+/*
+	The function fill() draws a new block of proposals.
+*/
+void ProposalBuffer::fill(){
+	if(range > 0)
+		(*gen).fillIndices(indices.data(), blockSize, range);
+	(*gen).fillUniform(alphas.data(), blockSize, - M_PI, M_PI);
+	(*gen).fillNormal(zs.data(), blockSize);
+
+	sinCos(alphas.data(), cosines.data(), sines.data(), blockSize);
+
+	pos = 0;
+	size = blockSize;
+}
+
+
+/*
+	C ~ O ~ N ~ S ~ T ~ R ~ U ~ C ~ T ~ O ~ R ~ S
+*/
+
+/*
+	Constructor:
+	Starts with an empty buffer which draws no indices.
+
+	@param 	g 	The generator the variates get drawn from
+*/
+ProposalBuffer::ProposalBuffer(RandomGenerator * const g) :
+	gen(g), range(0), pos(0), size(0), indices(blockSize, 0), alphas(blockSize),
+	cosines(blockSize), sines(blockSize), zs(blockSize) {}
+
+
+/*
+	S ~ E ~ T ~ T ~ E ~ R ~ S
+*/
+
+/*
+	The function setRange() sets the number of possible indices of the following
+	proposals. If it differs from the actual one, the remaining buffered proposals get
+	discarded.
+
+	@param 	n 	The number of possible indices, 0 if the proposals need no index
+*/
+void ProposalBuffer::setRange(const int n){
+	if(n == range)
+		return;
+
+	range = n;
+	pos = 0;
+	size = 0;
+
+	if(range == 0)
+		indices.assign(blockSize, 0);
+}
+
+
+/*
+	O ~ T ~ H ~ E ~ R ~ S
+*/
+
+/*
+	The function next() returns the next buffered proposal and draws a new block if the
+	buffer is empty.
+
+	@param 	index 		The index of the moving vertex, 0 if the range is 0
+	@param 	alpha 		The direction of the translation in [-pi, pi)
+	@param 	cosAlpha 	The cosine of alpha
+	@param 	sinAlpha 	The sine of alpha
+	@param 	z 			A standard normally distributed value for computing the distance
+*/
+void ProposalBuffer::next(int &index, double &alpha, double &cosAlpha, double &sinAlpha,
+	double &z){
+
+	if(pos == size)
+		fill();
+
+	index = indices[pos];
+	alpha = alphas[pos];
+	cosAlpha = cosines[pos];
+	sinAlpha = sines[pos];
+	z = zs[pos];
+
+	pos++;
+}
+
+/*
+	The function sinCos() computes the cosine and the sine of n directions in [-pi, pi].
+	It reduces the directions to [-pi/4, pi/4] and evaluates the polynomials of fdlibm
+	without branches, such that the compiler can vectorize the loop.
+
+	@param 	alpha 		The directions
+	@param 	cosAlpha 	The array the cosines get written to
+	@param 	sinAlpha 	The array the sines get written to
+	@param 	n 			The number of directions
+
+	Note:
+		The results differ from cos() and sin() by at most a few units in the last place,
+		but do not depend on the vectorization
+*/
+void ProposalBuffer::sinCos(double const * const alpha, double * const cosAlpha,
+	double * const sinAlpha, const unsigned int n){
+
+	// pi/2 split into a part with 33 bits, such that multiples of it are exact, and the rest
+	const double twoByPi = 6.36619772367581382433e-01;
+	const double pio2Hi = 1.57079632673412561417e+00;
+	const double pio2Lo = 6.07710050650619224932e-11;
+
+	// The coefficients of the polynomials of __kernel_sin() and __kernel_cos() of fdlibm
+	const double s1 = -1.66666666666666324348e-01;
+	const double s2 = 8.33333333332248946124e-03;
+	const double s3 = -1.98412698298579493134e-04;
+	const double s4 = 2.75573137070700676789e-06;
+	const double s5 = -2.50507602534068634195e-08;
+	const double s6 = 1.58969099521155010221e-10;
+	const double c1 = 4.16666666666666019037e-02;
+	const double c2 = -1.38888888888741095749e-03;
+	const double c3 = 2.48015872894767294178e-05;
+	const double c4 = -2.75573143513906633035e-07;
+	const double c5 = 2.08757232129817482790e-09;
+	const double c6 = -1.13596475577881948265e-11;
+
+	unsigned int i;
+	int q;
+	double x, r, z, s, c, odd;
+
+	for(i = 0; i < n; i++){
+		x = alpha[i];
+
+		// The quadrant and the remainder in [-pi/4, pi/4]
+		q = (int)(x * twoByPi + copysign(0.5, x));
+		r = (x - q * pio2Hi) - q * pio2Lo;
+
+		z = r * r;
+		s = r + r * z * (s1 + z * (s2 + z * (s3 + z * (s4 + z * (s5 + z * s6)))));
+		c = 1 - 0.5 * z + z * z * (c1 + z * (c2 + z * (c3 + z * (c4 + z * (c5 + z * c6)))));
+
+		// Rotate the result into the quadrant, the selection by multiplying with 0 or 1 is
+		// exact and keeps the loop free of branches
+		odd = q & 1;
+		sinAlpha[i] = (1 - (q & 2)) * (odd * c + (1 - odd) * s);
+		cosAlpha[i] = (1 - ((q + 1) & 2)) * (odd * s + (1 - odd) * c);
+	}
+}
+
+/*
+	The function getDistance() computes the translation distance from a standard normally
+	distributed value, bounded away from 0 in the same way RandomGenerator::getDoubleNormal()
+	does it.
+
+	@param 	mean 	The mean of the distance
+	@param 	stddev 	The standard deviation of the distance
+	@param 	z 		The standard normally distributed value
+	@return 		The distance
+*/
+double ProposalBuffer::getDistance(const double mean, const double stddev, const double z){
+	double r = mean + stddev * z;
+	double limit = 0.0000001;
+
+	if(r < limit && r > - limit){
+		if(r > 0)
+			r = limit;
+		else
+			r = - limit;
+	}
+
+	return r;
+}
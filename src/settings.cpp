@@ -16,6 +16,8 @@
  */
 
 #include "settings.h"
+#include "moveLog.h"
+#include "polygonReader.h"
 
 /*
 	Polygon parameters
@@ -29,22 +31,35 @@ bool Settings::holeInsertionAtStart = false;
 	Initial polygon
 */
 unsigned int Settings::initialSize = 20;
+StartShape Settings::startShape = StartShape::REGULAR;
 double Settings::radiusPolygon = 0.1;
 double Settings::radiusHole = 0.05;
 double Settings::boxSize = 3.0;
 unsigned int Settings::initialTranslationFactor = 100;
+bool Settings::fixedInitialFactor = false;
 int Settings::initialTranslationNumber = -1;
+char* Settings::inputFile = NULL;
+std::vector<std::vector<point>> Settings::inputRings;
 
 
 /*
 	Translation parameters
 */
 bool Settings::kinetic = false;
+bool Settings::hybrid = false;
 Arithmetics Settings::arithmetics = Arithmetics::DOUBLE;
 int Settings::stddevDiv = 3;
+bool Settings::boundedDistance = false;
+double Settings::targetAcceptance = 0;
+double Settings::maxBias = 4;
+bool Settings::relayout = false;
+unsigned int Settings::localBlockSize = 0;
 bool Settings::localChecking = true;
 bool Settings::globalChecking = false;
 unsigned int Settings::additionalTrans = 0;
+unsigned int Settings::threads = 1;
+unsigned int Settings::cellsPerSide = 8;
+ParallelMode Settings::parallelMode = ParallelMode::PARTITION;
 
 /*
 	Insertion parameters
@@ -52,12 +67,16 @@ unsigned int Settings::additionalTrans = 0;
 unsigned int Settings::insertionTries = 100;
 double Settings::minLength = 0.0000001;
 bool Settings::weightedEdgeSelection = true;
+bool Settings::bulkGrowth = false;
+bool Settings::directInsertion = false;
 
 
 /*
 	Utilities
 */
 Timer* Settings::timer = NULL;
+AcceptanceController* Settings::controller = NULL;
+VertexScheduler* Settings::scheduler = NULL;
 
 
 /*
@@ -65,7 +84,10 @@ Timer* Settings::timer = NULL;
 */
 bool Settings::fixedSeed = false;
 unsigned int Settings::seed = 0;
+RandomEngine Settings::randomEngine = RandomEngine::MT19937;
 RandomGenerator* Settings::generator = NULL;
+bool Settings::batchedProposals = false;
+ProposalBuffer* Settings::proposals = NULL;
 
 
 /*
@@ -78,6 +100,10 @@ bool Settings::triangulationOutputRequired = false;
 char* Settings::triangulationFile = NULL;
 bool Settings::enableStats = false;
 char* Settings::statisticsFile = NULL;
+char* Settings::profileFile = NULL;
+char* Settings::traceFile = NULL;
+char* Settings::recordFile = NULL;
+char* Settings::replayFile = NULL;
 
 bool Settings::simplicityCheck = false;
 double Settings::timing = 0;
@@ -87,8 +113,17 @@ void Settings::printSettings(){
 	unsigned int i;
 
 	fprintf(stderr, "Polygon settings:\n");
+	if(inputFile != NULL)
+		fprintf(stderr, "Input file: %s\n", inputFile);
+	else{
+		switch (startShape) {
+			case StartShape::REGULAR: fprintf(stderr, "Start polygon: regular\n"); break;
+			case StartShape::STAR: fprintf(stderr, "Start polygon: star\n"); break;
+		}
+	}
 	fprintf(stderr, "Number of holes: %d\n", nrInnerPolygons);
 	fprintf(stderr, "Number of vertices (start polygon): %d\n", initialSize);
+	fprintf(stderr, "Translations per vertex (start polygon): %u\n", initialTranslationFactor);
 	fprintf(stderr, "Target number of vertices (polygon): %d\n", outerSize);
 
 	if(nrInnerPolygons > 0){
@@ -110,6 +145,20 @@ void Settings::printSettings(){
 	else
 		fprintf(stderr, "Seed configuration: RANDOM\n");
 	fprintf(stderr, "Seed: %u\n", seed);
+	if(randomEngine == RandomEngine::MT19937)
+		fprintf(stderr, "Random generator: mt19937\n");
+	else
+		fprintf(stderr, "Random generator: xoshiro256++\n");
+	if(batchedProposals)
+		fprintf(stderr, "Batched proposals: enabled\n");
+	else
+		fprintf(stderr, "Batched proposals: disabled\n");
+	if(hybrid)
+		fprintf(stderr, "Translation engine: hybrid\n");
+	else if(kinetic)
+		fprintf(stderr, "Translation engine: kinetic\n");
+	else
+		fprintf(stderr, "Translation engine: retriangulation\n");
 	if(localChecking)
 		fprintf(stderr, "Local checking: enabled\n");
 	else
@@ -118,6 +167,38 @@ void Settings::printSettings(){
 		fprintf(stderr, "Global checking: enabled\n");
 	else
 		fprintf(stderr, "Global checking: disbaled\n");
+	if(boundedDistance)
+		fprintf(stderr, "Bounded translation distances: enabled\n");
+	else
+		fprintf(stderr, "Bounded translation distances: disabled\n");
+	if(targetAcceptance > 0)
+		fprintf(stderr, "Target acceptance rate: %.2f (max bias %.2f)\n", targetAcceptance, maxBias);
+	else
+		fprintf(stderr, "Target acceptance rate: disabled\n");
+	if(relayout)
+		fprintf(stderr, "Memory relayout: enabled\n");
+	else
+		fprintf(stderr, "Memory relayout: disabled\n");
+	if(localBlockSize > 0)
+		fprintf(stderr, "Local vertex blocks: %u vertices\n", localBlockSize);
+	else
+		fprintf(stderr, "Local vertex blocks: disabled\n");
+	fprintf(stderr, "Threads: %u\n", threads);
+	if(threads > 1){
+		switch (parallelMode) {
+			case ParallelMode::PARTITION: fprintf(stderr, "Parallel mode: partition\n"); break;
+			case ParallelMode::INDEPENDENTSET: fprintf(stderr, "Parallel mode: independentset\n"); break;
+			case ParallelMode::SPECULATIVE: fprintf(stderr, "Parallel mode: speculative\n"); break;
+		}
+	}
+	if(bulkGrowth)
+		fprintf(stderr, "Bulk growth: enabled\n");
+	else
+		fprintf(stderr, "Bulk growth: disabled\n");
+	if(directInsertion)
+		fprintf(stderr, "Direct insertion: enabled\n");
+	else
+		fprintf(stderr, "Direct insertion: disabled\n");
 
 	fprintf(stderr, "\n");
 
@@ -127,11 +208,20 @@ void Settings::printSettings(){
 		case OutputFormat::DAT: fprintf(stderr, "OutputFormat: dat\n"); break;
 		case OutputFormat::LINE: fprintf(stderr, "OutputFormat: line\n"); break;
 		case OutputFormat::GRAPHML: fprintf(stderr, "OutputFormat: graphml\n"); break;
+		case OutputFormat::BIN: fprintf(stderr, "OutputFormat: bin\n"); break;
 	}
 	if(triangulationOutputRequired)
 		fprintf(stderr, "Triangulation file: %s\n", triangulationFile);
 	if(statisticsFile != NULL)
 		fprintf(stderr, "Statistics file: %s\n", statisticsFile);
+	if(profileFile != NULL)
+		fprintf(stderr, "Profile file: %s\n", profileFile);
+	if(traceFile != NULL)
+		fprintf(stderr, "Trace file: %s\n", traceFile);
+	if(recordFile != NULL)
+		fprintf(stderr, "Record file: %s\n", recordFile);
+	if(replayFile != NULL)
+		fprintf(stderr, "Replay file: %s\n", replayFile);
 	if(Settings::feedback != FeedbackMode::MUTE)
 		fprintf(stderr, "Print execution information: true\n");
 	else
@@ -151,6 +241,45 @@ void Settings::checkAndApplySettings(){
 	bool conflict = false;
 	fprintf(stderr, "Checking for configuration conflicts...");
 
+	if(inputFile != NULL && startShape != StartShape::REGULAR){
+		fprintf(stderr, "A start shape can not be chosen for a start polygon read from a file\n");
+		exit(14);
+	}
+
+	if(startShape == StartShape::STAR && nrInnerPolygons > 0 && holeInsertionAtStart){
+		fprintf(stderr, "Holes can not be placed into a star-shaped start polygon, they must be inserted during the growth\n");
+		exit(14);
+	}
+
+	// Take the start polygon and its holes from the input file
+	if(inputFile != NULL){
+		readPolygonFile(inputFile, inputRings);
+		initialSize = inputRings[0].size();
+
+		// The read polygon is already random, so by default it does not get shuffled
+		if(!fixedInitialFactor)
+			initialTranslationFactor = 0;
+
+		if(inputRings.size() > 1){
+			if(nrInnerPolygons != 0 && nrInnerPolygons != inputRings.size() - 1){
+				fprintf(stderr, "Conflicting number of holes:\n");
+				fprintf(stderr, "Given number: %u Number of holes in the input file: %lu\n",
+					nrInnerPolygons, inputRings.size() - 1);
+				exit(14);
+			}
+
+			// The holes already exist, they just grow to their target sizes
+			nrInnerPolygons = inputRings.size() - 1;
+			innerSizes.resize(nrInnerPolygons, 0);
+			for(i = 0; i < nrInnerPolygons; i++)
+				innerSizes[i] = std::max(innerSizes[i], (unsigned int)inputRings[i + 1].size());
+			holeInsertionAtStart = true;
+		}else if(nrInnerPolygons > 0 && holeInsertionAtStart){
+			fprintf(stderr, "Holes can not be placed into a start polygon read from a file, they must be inserted during the growth\n");
+			exit(14);
+		}
+	}
+
 	if(outerSize < 3){
 		fprintf(stderr, "The polygon must have at least 3 vertices, given number %d\n", outerSize);
 		exit(14);
@@ -177,6 +306,47 @@ void Settings::checkAndApplySettings(){
 		}
 	}
 
+	if(threads == 0){
+		fprintf(stderr, "The number of threads must be at least 1\n");
+		exit(14);
+	}
+
+	if(targetAcceptance < 0 || targetAcceptance >= 1){
+		fprintf(stderr, "The target acceptance rate must be in [0, 1), given rate: %f\n", targetAcceptance);
+		exit(14);
+	}
+
+	if(maxBias < 1){
+		fprintf(stderr, "The maximum bias must be at least 1, given bias: %f\n", maxBias);
+		exit(14);
+	}
+
+	if(kinetic && hybrid){
+		fprintf(stderr, "The kinetic and the hybrid translation engine can not be enabled both\n");
+		exit(14);
+	}
+
+	if((recordFile != NULL || replayFile != NULL) &&
+		(threads > 1 || nrInnerPolygons > 0 || bulkGrowth || directInsertion)){
+		fprintf(stderr, "Recording and replaying are just supported for sequential runs without holes, bulk growth and direct insertion\n");
+		exit(14);
+	}
+
+	if(threads > 1 && nrInnerPolygons > 0)
+		fprintf(stderr, "\nNote: Parallel translations are just supported for polygons without holes!\n");
+
+	if(bulkGrowth && nrInnerPolygons > 0)
+		fprintf(stderr, "\nNote: Bulk growth is just supported for polygons without holes!\n");
+
+	if(boundedDistance && threads > 1 && nrInnerPolygons == 0)
+		fprintf(stderr, "\nNote: Bounded translation distances are just used by the sequential translation phase!\n");
+
+	if(bulkGrowth && directInsertion)
+		fprintf(stderr, "\nNote: Bulk growth is not used in combination with direct insertion!\n");
+
+	if(hybrid && nrInnerPolygons > 0)
+		fprintf(stderr, "\nNote: The hybrid engine is not used for the inflation of the holes!\n");
+
 	if(fixedSeed){
 		if(seed == 0){
 			fprintf(stderr, "\nNote: FixedSeed is marked to use, but no seed is given!\n");
@@ -213,12 +383,38 @@ void Settings::checkAndApplySettings(){
 	}
 
 	// Initialize the RandomGenerator
-	generator = new RandomGenerator(fixedSeed, seed);
+	generator = new RandomGenerator(randomEngine, fixedSeed, seed);
+
+	// Initialize the buffer of the proposed translations
+	if(batchedProposals)
+		proposals = new ProposalBuffer(generator);
+
+	// Initialize the controller of the translation distances
+	if(targetAcceptance > 0)
+		controller = new AcceptanceController(targetAcceptance, maxBias);
+
+	// Initialize the scheduler of the vertices to translate
+	if(localBlockSize > 0)
+		scheduler = new VertexScheduler(localBlockSize);
 
 	// Enable triangulation output
 	if(triangulationFile != NULL)
 		triangulationOutputRequired = true;
 
+	// Enable the profiler
+	if(profileFile != NULL)
+		Profiler::enabled = true;
+
+	// Start the trace
+	if(traceFile != NULL)
+		Tracer::begin();
+
+	// Open the logs of the proposals
+	if(recordFile != NULL)
+		MoveLog::openRecord(recordFile);
+	if(replayFile != NULL)
+		MoveLog::openReplay(replayFile);
+
 	// Initialize the exact arithmetic
 	if(arithmetics == Arithmetics::EXACT)
 		exactinit();
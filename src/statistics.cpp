@@ -26,19 +26,319 @@ double Statistics::twistMax = 0;
 double Statistics:: maxTwist = 0;
 unsigned int Statistics::twistNumber = 0;
 unsigned int Statistics::directionChanges = 0;
+double Statistics::startMaxTwist = 0;
+unsigned int Statistics::startDirectionChanges = 0;
+double Statistics::startTime = 0;
 
 /*
 	Initialise global variables
 */
-unsigned long long Statistics::translationTries = 0;
-unsigned long long Statistics::translationsPerf = 0;
-unsigned long long Statistics::splits = 0;
-unsigned int Statistics::undone = 0;
-unsigned long long Statistics::nrChecks = 0;
-unsigned long long Statistics::nrSPTriangles = 0;
-unsigned int Statistics::maxSPTriangles = 0;
-unsigned long long Statistics::nrTriangles = 0;
-unsigned int Statistics::maxTriangles = 0;
+thread_local unsigned long long Statistics::translationTries = 0;
+thread_local unsigned long long Statistics::translationsPerf = 0;
+thread_local unsigned long long Statistics::splits = 0;
+thread_local unsigned int Statistics::undone = 0;
+thread_local unsigned long long Statistics::nrChecks = 0;
+thread_local unsigned long long Statistics::nrSPTriangles = 0;
+thread_local unsigned int Statistics::maxSPTriangles = 0;
+thread_local unsigned long long Statistics::nrTriangles = 0;
+thread_local unsigned int Statistics::maxTriangles = 0;
+thread_local unsigned long long Statistics::rejections[nrRejections] = {};
+thread_local double Statistics::rejectionTime[nrRejections] = {};
+thread_local unsigned long long Statistics::flips = 0;
+thread_local unsigned long long Statistics::retriangulated = 0;
+thread_local LogHistogram Statistics::histograms[nrEngines][nrDistributions] = {};
+thread_local unsigned long long Statistics::engineMoves[nrEngines] = {};
+thread_local double Statistics::engineTime[nrEngines] = {};
+unsigned long long Statistics::parallelRounds = 0;
+unsigned long long Statistics::parallelTranslations = 0;
+unsigned long long Statistics::deferredTranslations = 0;
+unsigned long long Statistics::maxParallelTranslations = 0;
+double Statistics::parallelCpuTime = 0;
+double Statistics::parallelWallTime = 0;
+unsigned long long Statistics::phaseTries = 0;
+unsigned long long Statistics::phaseTranslations = 0;
+double Statistics::phaseTime = 0;
+unsigned int Statistics::relayouts = 0;
+double Statistics::relayoutTime = 0;
+
+
+/*
+	The function add() records a value.
+
+	@param 	value 	The value
+*/
+void LogHistogram::add(const unsigned long long value){
+	unsigned int e, index;
+
+	count++;
+	sum = sum + value;
+	if(value > max)
+		max = value;
+
+	// The bucket is given by the exponent and the next two bits of the value
+	if(value < histogramSubBuckets)
+		index = value;
+	else{
+		e = 63 - __builtin_clzll(value);
+		index = (e - 1) * histogramSubBuckets + ((value >> (e - 2)) & (histogramSubBuckets - 1));
+	}
+
+	if(index >= histogramBuckets)
+		index = histogramBuckets - 1;
+
+	buckets[index]++;
+}
+
+/*
+	The function merge() adds the values of another histogram.
+
+	@param 	h 	The other histogram
+*/
+void LogHistogram::merge(const LogHistogram &h){
+	unsigned int i;
+
+	count = count + h.count;
+	sum = sum + h.sum;
+	if(h.max > max)
+		max = h.max;
+
+	for(i = 0; i < histogramBuckets; i++)
+		buckets[i] = buckets[i] + h.buckets[i];
+}
+
+/*
+	@param 	i 	The index of a bucket
+	@return 	The smallest value of the bucket
+*/
+unsigned long long LogHistogram::getBucketLow(const unsigned int i){
+	unsigned int e, m;
+
+	// Values below histogramSubBuckets have their own buckets
+	if(i < histogramSubBuckets)
+		return i;
+
+	e = i / histogramSubBuckets + 1;
+	m = i % histogramSubBuckets;
+
+	return (unsigned long long)(histogramSubBuckets + m) << (e - 2);
+}
+
+/*
+	@param 	p 	The percentile in [0, 1]
+	@return 	The smallest value of the bucket containing the percentile, 0 if there are
+				no values
+*/
+unsigned long long LogHistogram::getPercentile(const double p) const{
+	unsigned long long rank, s = 0;
+	unsigned int i;
+
+	if(count == 0)
+		return 0;
+
+	rank = (unsigned long long)ceil(p * count);
+	if(rank == 0)
+		rank = 1;
+
+	for(i = 0; i < histogramBuckets; i++){
+		s = s + buckets[i];
+		if(s >= rank)
+			break;
+	}
+
+	return getBucketLow(i);
+}
+
+
+/*
+	The function collectCounters() returns the translation counters of the calling thread.
+
+	@return 	The translation counters of the calling thread
+*/
+StatisticsCounters Statistics::collectCounters(){
+	StatisticsCounters c;
+	unsigned int i, j;
+
+	c.translationTries = translationTries;
+	c.translationsPerf = translationsPerf;
+	c.splits = splits;
+	c.undone = undone;
+	c.nrChecks = nrChecks;
+	c.nrSPTriangles = nrSPTriangles;
+	c.maxSPTriangles = maxSPTriangles;
+	c.nrTriangles = nrTriangles;
+	c.maxTriangles = maxTriangles;
+
+	for(i = 0; i < nrRejections; i++){
+		c.rejections[i] = rejections[i];
+		c.rejectionTime[i] = rejectionTime[i];
+	}
+
+	c.flips = flips;
+	c.retriangulated = retriangulated;
+	for(i = 0; i < nrEngines; i++){
+		for(j = 0; j < nrDistributions; j++)
+			c.histograms[i][j] = histograms[i][j];
+
+		c.engineMoves[i] = engineMoves[i];
+		c.engineTime[i] = engineTime[i];
+	}
+
+	return c;
+}
+
+/*
+	The function addCounters() merges translation counters of another thread into the
+	counters of the calling thread. Sums are added, maxima are combined.
+
+	@param 	c 	The translation counters of the other thread
+*/
+void Statistics::addCounters(const StatisticsCounters &c){
+	unsigned int i, j;
+
+	translationTries = translationTries + c.translationTries;
+	translationsPerf = translationsPerf + c.translationsPerf;
+	splits = splits + c.splits;
+	undone = undone + c.undone;
+	nrChecks = nrChecks + c.nrChecks;
+	nrSPTriangles = nrSPTriangles + c.nrSPTriangles;
+	nrTriangles = nrTriangles + c.nrTriangles;
+
+	if(c.maxSPTriangles > maxSPTriangles)
+		maxSPTriangles = c.maxSPTriangles;
+	if(c.maxTriangles > maxTriangles)
+		maxTriangles = c.maxTriangles;
+
+	for(i = 0; i < nrRejections; i++){
+		rejections[i] = rejections[i] + c.rejections[i];
+		rejectionTime[i] = rejectionTime[i] + c.rejectionTime[i];
+	}
+
+	flips = flips + c.flips;
+	retriangulated = retriangulated + c.retriangulated;
+	for(i = 0; i < nrEngines; i++){
+		for(j = 0; j < nrDistributions; j++)
+			histograms[i][j].merge(c.histograms[i][j]);
+
+		engineMoves[i] = engineMoves[i] + c.engineMoves[i];
+		engineTime[i] = engineTime[i] + c.engineTime[i];
+	}
+}
+
+/*
+	The function resetCounters() sets the translation counters of the calling thread
+	to zero.
+*/
+void Statistics::resetCounters(){
+	unsigned int i, j;
+
+	translationTries = 0;
+	translationsPerf = 0;
+	splits = 0;
+	undone = 0;
+	nrChecks = 0;
+	nrSPTriangles = 0;
+	maxSPTriangles = 0;
+	nrTriangles = 0;
+	maxTriangles = 0;
+
+	for(i = 0; i < nrRejections; i++){
+		rejections[i] = 0;
+		rejectionTime[i] = 0;
+	}
+
+	flips = 0;
+	retriangulated = 0;
+	for(i = 0; i < nrEngines; i++){
+		for(j = 0; j < nrDistributions; j++)
+			histograms[i][j] = LogHistogram();
+
+		engineMoves[i] = 0;
+		engineTime[i] = 0;
+	}
+}
+
+/*
+	The function addRejection() counts a rejection of the calling thread.
+
+	@param 	r 		The reason of the rejection
+	@param 	time 	The time spent on the rejected translation or insertion (in seconds)
+*/
+void Statistics::addRejection(const Rejection r, const double time){
+	rejections[(unsigned int)r]++;
+	rejectionTime[(unsigned int)r] = rejectionTime[(unsigned int)r] + time;
+}
+
+/*
+	@param 	r 	A reason of a rejection
+	@return 	The name of the reason in the statistics
+*/
+const char *Statistics::getRejectionName(const Rejection r){
+	switch(r){
+		case Rejection::ORIENTATION: return "orientation";
+		case Rejection::VERTEXHIT: return "vertexhit";
+		case Rejection::POLYGONHIT: return "polygonhit";
+		case Rejection::FRAMEHIT: return "framehit";
+		case Rejection::NUMERICAL: return "numerical";
+		case Rejection::UNSTABLE: return "unstable";
+		case Rejection::UNDONE: return "undone";
+		case Rejection::ABORTED: return "aborted";
+		case Rejection::STABILITY: return "stability";
+	}
+
+	return "unknown";
+}
+
+/*
+	The function addToHistogram() records a value of a distribution of a translation
+	engine.
+
+	@param 	e 		The translation engine
+	@param 	d 		The distribution
+	@param 	value 	The value
+*/
+void Statistics::addToHistogram(const Engine e, const Distribution d, const unsigned long long value){
+	histograms[(unsigned int)e][(unsigned int)d].add(value);
+}
+
+/*
+	The function addEngineMove() counts a translation of the calling thread which has
+	been executed by the translation engine e.
+
+	@param 	e 		The translation engine
+	@param 	time 	The time spent on the execution (in seconds)
+*/
+void Statistics::addEngineMove(const Engine e, const double time){
+	engineMoves[(unsigned int)e]++;
+	engineTime[(unsigned int)e] = engineTime[(unsigned int)e] + time;
+}
+
+/*
+	@param 	e 	A translation engine
+	@return 	The name of the engine in the statistics
+*/
+const char *Statistics::getEngineName(const Engine e){
+	switch(e){
+		case Engine::KINETIC: return "kinetic";
+		case Engine::RETRIANGULATION: return "retriangulation";
+	}
+
+	return "unknown";
+}
+
+/*
+	@param 	d 	A distribution
+	@return 	The name of the distribution in the statistics
+*/
+const char *Statistics::getDistributionName(const Distribution d){
+	switch(d){
+		case Distribution::TIME: return "time_ns";
+		case Distribution::TRIANGLES: return "triangles";
+		case Distribution::FLIPS: return "flips";
+		case Distribution::POLYGONSIZE: return "polygonsize";
+	}
+
+	return "unknown";
+}
 
 
 /*
@@ -228,6 +528,31 @@ void Statistics::calculateTwistNumber(Triangulation const * const T){
 	}
 }
 
+/*
+	Calculates the max twist and the number of direction changes of the start polygon
+	and keeps them together with the elapsed time, such that the quality of the start
+	polygon can be compared to the one of the final polygon.
+
+	@param 	T 	The triangulation the start polygon lives in
+*/
+void Statistics::calculateStartShape(Triangulation const * const T){
+	calculateMaxTwist(T);
+	calculateDirectionChanges(T);
+
+	startMaxTwist = maxTwist;
+	startDirectionChanges = directionChanges;
+	startTime = (*Settings::timer).elapsedTime();
+}
+
+/*
+	@return 	True if the generation started from the regular polygon of radius
+				Settings::radiusPolygon, otherwise the radius of the start polygon and the
+				radial deviation from it are undefined and do not get reported
+*/
+static bool startsRegular(){
+	return Settings::inputFile == NULL && Settings::startShape == StartShape::REGULAR;
+}
+
 /*
 	Prints the calculated statistics to stderr. 
 
@@ -239,6 +564,7 @@ void Statistics::calculateTwistNumber(Triangulation const * const T){
 void Statistics::printStats(Triangulation const * const T){
 	unsigned int i;
 	unsigned int nrOfHoles;
+	unsigned long long total = 0;
 
 	fprintf(stderr, "\n");
 
@@ -256,7 +582,8 @@ void Statistics::printStats(Triangulation const * const T){
 			fprintf(stderr, "%d %d\n", i, (*T).getActualNumberOfVertices(i));
 		}
 	}
-	fprintf(stderr, "Radius of the start polygon: %.2f\n", Settings::radiusPolygon);
+	if(startsRegular())
+		fprintf(stderr, "Radius of the start polygon: %.2f\n", Settings::radiusPolygon);
 	fprintf(stderr, "Edge length of the bounding box: %.2f\n", Settings::boxSize);
 
 	fprintf(stderr, "\n");
@@ -276,16 +603,80 @@ void Statistics::printStats(Triangulation const * const T){
 	fprintf(stderr, "Average number of passed triangles: %.2f\n",
 		(double)nrTriangles / (double) nrChecks);
 	fprintf(stderr, "Max number of passed triangles: %d\n", maxTriangles);
+	if(phaseTries > 0){
+		fprintf(stderr, "Acceptance rate of the translation phases: %.2f%%\n",
+			(double)phaseTranslations / (double)phaseTries * 100);
+		if(phaseTime > 0)
+			fprintf(stderr, "Performed translations per second in the translation phases: %.0f\n",
+				(double)phaseTranslations / phaseTime);
+	}
+	if(Settings::controller != NULL){
+		fprintf(stderr, "Target acceptance rate: %.2f%%\n", (*Settings::controller).getTarget() * 100);
+		fprintf(stderr, "Number of distance adjustments: %lu\n",
+			(*Settings::controller).getTrajectory().size());
+		fprintf(stderr, "Final distance scale: %.3f (max bias %.2f)\n", (*Settings::controller).getScale(),
+			(*Settings::controller).getMaxBias());
+	}
+	if(parallelRounds > 0){
+		fprintf(stderr, "Number of parallel rounds: %llu\n", parallelRounds);
+		fprintf(stderr, "Number of translations processed in parallel: %llu\n", parallelTranslations);
+		fprintf(stderr, "Number of deferred translations: %llu\n", deferredTranslations);
+		fprintf(stderr, "Average number of parallel translations per round: %.2f\n",
+			(double)parallelTranslations / (double)parallelRounds);
+		fprintf(stderr, "Max number of parallel translations per round: %llu\n", maxParallelTranslations);
+		fprintf(stderr, "Time of the parallel rounds: %.3f seconds (%.3f seconds CPU time)\n",
+			parallelWallTime, parallelCpuTime);
+		if(parallelWallTime > 0)
+			fprintf(stderr, "CPU utilization of the parallel rounds: %.2f with %u threads\n",
+				parallelCpuTime / parallelWallTime, Settings::threads);
+	}
+	if(Settings::relayout)
+		fprintf(stderr, "Number of memory relayouts: %u (%.3f seconds)\n", relayouts, relayoutTime);
+	if(Settings::scheduler != NULL){
+		fprintf(stderr, "Number of local vertex blocks: %llu of %u vertices\n",
+			(*Settings::scheduler).getNumberOfBlocks(), (*Settings::scheduler).getBlockSize());
+		fprintf(stderr, "Selection dispersion of the vertices: %.2f (1 for independent selections)\n",
+			(*Settings::scheduler).getSelectionDispersion());
+	}
+
+	fprintf(stderr, "\n");
+
+	fprintf(stderr, "Rejections:\n");
+	fprintf(stderr, "%-12s %12s %8s %10s\n", "Reason", "Count", "Share", "Seconds");
+	for(i = 0; i < nrRejections; i++){
+		fprintf(stderr, "%-12s %12llu %7.2f%% %10.3f\n", getRejectionName((Rejection)i), rejections[i],
+			translationTries > 0 ? (double)rejections[i] / (double)translationTries * 100 : 0,
+			rejectionTime[i]);
+	}
+
+	fprintf(stderr, "\n");
+
+	fprintf(stderr, "Engines:\n");
+	fprintf(stderr, "%-16s %12s %8s %10s\n", "Engine", "Executed", "Share", "Seconds");
+	for(i = 0; i < nrEngines; i++)
+		total = total + engineMoves[i];
+	for(i = 0; i < nrEngines; i++){
+		fprintf(stderr, "%-16s %12llu %7.2f%% %10.3f\n", getEngineName((Engine)i), engineMoves[i],
+			total > 0 ? (double)engineMoves[i] / (double)total * 100 : 0, engineTime[i]);
+	}
 
 	fprintf(stderr, "\n");
 
 	fprintf(stderr, "Shape:\n");
-	fprintf(stderr, "Radial deviation from the start polygon: %.2f\n", radialDistDev);
+	if(startsRegular())
+		fprintf(stderr, "Radial deviation from the start polygon: %.2f\n", radialDistDev);
 	fprintf(stderr, "Number of direction changes: %d\n", directionChanges);
 	fprintf(stderr, "Max inside twist: %.2f°\n", twistMin);
 	fprintf(stderr, "Max outside twist: %.2f°\n", twistMax);
 	fprintf(stderr, "Overall max twist: %.2f°\n", maxTwist);
 	fprintf(stderr, "Number of twists by pi: %u\n", twistNumber);
+
+	fprintf(stderr, "\n");
+
+	fprintf(stderr, "Start polygon:\n");
+	fprintf(stderr, "Ready after: %.3f seconds of %.3f seconds\n", startTime, Settings::timing);
+	fprintf(stderr, "Number of direction changes: %d\n", startDirectionChanges);
+	fprintf(stderr, "Overall max twist: %.2f°\n", startMaxTwist);
 }
 
 /*
@@ -298,7 +689,7 @@ void Statistics::printStats(Triangulation const * const T){
 */
 void Statistics::writeStatsFile(Triangulation const * const T){
 	ptree tree;
-	unsigned int i;
+	unsigned int i, j, k;
 	unsigned int nrOfHoles = (*T).getActualNrInnerPolygons();
 
 	ptree& stats = tree.add("statistics", "");
@@ -314,7 +705,8 @@ void Statistics::writeStatsFile(Triangulation const * const T){
 		hole.add("size", (*T).getActualNumberOfVertices(i));
 	}
 
-	polygon.add("startradius", Settings::radiusPolygon);
+	if(startsRegular())
+		polygon.add("startradius", Settings::radiusPolygon);
 	polygon.add("boxsize", Settings::boxSize);
 
 
@@ -331,16 +723,110 @@ void Statistics::writeStatsFile(Triangulation const * const T){
 	trans.add("averagepassed", (double)nrTriangles / (double) nrChecks);
 	trans.add("maxpassed", maxSPTriangles);
 	trans.add("timing", Settings::timing);
+	if(phaseTries > 0){
+		trans.add("acceptancerate", (double)phaseTranslations / (double)phaseTries);
+		if(phaseTime > 0)
+			trans.add("translationspersecond", (double)phaseTranslations / phaseTime);
+	}
+	if(Settings::controller != NULL){
+		ptree& controller = trans.add("controller", "");
+		controller.add("target", (*Settings::controller).getTarget());
+		controller.add("maxbias", (*Settings::controller).getMaxBias());
+		controller.add("finalscale", (*Settings::controller).getScale());
+
+		// The trajectory of the adjustments
+		ptree& trajectory = controller.add("trajectory", "");
+		for(auto const &s : (*Settings::controller).getTrajectory()){
+			ptree& step = trajectory.add("step", "");
+			step.add("<xmlattr>.tries", s.tries);
+			step.add("<xmlattr>.rate", s.rate);
+			step.add("<xmlattr>.scale", s.scale);
+		}
+	}
+	if(parallelRounds > 0){
+		trans.add("parallelrounds", parallelRounds);
+		trans.add("parallel", parallelTranslations);
+		trans.add("deferred", deferredTranslations);
+		trans.add("averageparallel", (double)parallelTranslations / (double)parallelRounds);
+		trans.add("maxparallel", maxParallelTranslations);
+		trans.add("threads", Settings::threads);
+		trans.add("paralleltime", parallelWallTime);
+		trans.add("parallelcputime", parallelCpuTime);
+	}
+	if(Settings::relayout){
+		ptree& layout = trans.add("relayout", "");
+		layout.add("count", relayouts);
+		layout.add("time", relayoutTime);
+	}
+	if(Settings::scheduler != NULL){
+		ptree& scheduler = trans.add("localblocks", "");
+		scheduler.add("blocksize", (*Settings::scheduler).getBlockSize());
+		scheduler.add("blocks", (*Settings::scheduler).getNumberOfBlocks());
+		scheduler.add("dispersion", (*Settings::scheduler).getSelectionDispersion());
+	}
+
+	// The number of rejections and the time spent on them per reason
+	ptree& rejected = trans.add("rejections", "");
+	for(i = 0; i < nrRejections; i++){
+		ptree& reason = rejected.add(getRejectionName((Rejection)i), "");
+		reason.add("count", rejections[i]);
+		reason.add("time", rejectionTime[i]);
+	}
+
+	// The number of executed translations and the time spent on their execution per engine
+	ptree& engines = trans.add("engines", "");
+	for(i = 0; i < nrEngines; i++){
+		ptree& engine = engines.add(getEngineName((Engine)i), "");
+		engine.add("count", engineMoves[i]);
+		engine.add("time", engineTime[i]);
+	}
+
+	// The histograms of the costs of the translations per engine, just the non-empty
+	// buckets get written
+	ptree& costs = trans.add("histograms", "");
+	for(i = 0; i < nrEngines; i++){
+		ptree& engine = costs.add(getEngineName((Engine)i), "");
+		for(j = 0; j < nrDistributions; j++){
+			LogHistogram const &h = histograms[i][j];
+
+			if(h.count == 0)
+				continue;
+
+			ptree& dist = engine.add(getDistributionName((Distribution)j), "");
+			dist.add("count", h.count);
+			dist.add("mean", (double)h.sum / (double)h.count);
+			dist.add("p50", h.getPercentile(0.5));
+			dist.add("p90", h.getPercentile(0.9));
+			dist.add("p99", h.getPercentile(0.99));
+			dist.add("p999", h.getPercentile(0.999));
+			dist.add("max", h.max);
+
+			for(k = 0; k < histogramBuckets; k++){
+				if(h.buckets[k] == 0)
+					continue;
+
+				ptree& bucket = dist.add("bucket", "");
+				bucket.add("<xmlattr>.low", LogHistogram::getBucketLow(k));
+				bucket.add("<xmlattr>.count", h.buckets[k]);
+			}
+		}
+	}
 
 
 	ptree& shape = stats.add("shape", "");
-	shape.add("radialdev", radialDistDev);
+	if(startsRegular())
+		shape.add("radialdev", radialDistDev);
 	shape.add("dir_change", directionChanges);
 	shape.add("maxinsidetwist", twistMin);
 	shape.add("maxoutsidetwist", twistMax);
 	shape.add("maxtwist", maxTwist);
 	shape.add("twistnumber", twistNumber);
 
+	ptree& start = shape.add("start", "");
+	start.add("time", startTime);
+	start.add("dir_change", startDirectionChanges);
+	start.add("maxtwist", startMaxTwist);
+
 
 	write_xml(Settings::statisticsFile, tree,
         std::locale(),
@@ -0,0 +1,448 @@
+/*
+ * Copyright 2021 Philipp Mayer - pmayer@cs.sbg.ac.at
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "sweepTriangulation.h"
+
+/*
+	The types of the vertices of the sweep
+*/
+enum class SweepVertex {START, END, SPLIT, MERGE, REGULAR};
+
+/*
+	The state of the sweep over one domain. The vertices of all rings are numbered
+	consecutively (slots), the edge of a slot is the edge from the slot to its next slot.
+*/
+struct Sweep{
+	// The coordinates of all vertices
+	std::vector<point> const &points;
+
+	// The index into points, the previous and the next slot of each slot
+	std::vector<int> pt;
+	std::vector<int> prev;
+	std::vector<int> next;
+
+	// The helper of the edge of each slot while the edge intersects the sweep line
+	std::vector<int> helper;
+
+	// The slots connected to each slot by diagonals
+	std::vector<std::vector<int>> diagonals;
+
+	// The actual position of the sweep line, sweepX is the x-coordinate of the actual vertex
+	double sweepY;
+	double sweepX;
+
+	Sweep(std::vector<point> const &p) : points(p), sweepY(0), sweepX(0) {}
+
+	point const &at(const int s) const{
+		return points[pt[s]];
+	}
+
+	/*
+		@return 	True if slot a comes before slot b in the sweep, i.e. it has a larger
+					y-coordinate or the same one and a smaller x-coordinate
+	*/
+	bool above(const int a, const int b) const{
+		return at(a).y > at(b).y || (at(a).y == at(b).y && at(a).x < at(b).x);
+	}
+
+	/*
+		@param 	e 	The slot of an edge intersecting the sweep line, -1 for the actual vertex
+		@return 	The x-coordinate of the intersection of the edge with the sweep line
+	*/
+	double xAt(const int e) const{
+		if(e == -1)
+			return sweepX;
+
+		point const &u = at(e);
+		point const &l = at(next[e]);
+
+		// Horizontal edges are only compared while the sweep is at their left vertex
+		if(u.y == l.y)
+			return u.x;
+
+		return u.x + (sweepY - u.y) * (l.x - u.x) / (l.y - u.y);
+	}
+
+	/*
+		The function addDiagonal() connects two slots by a diagonal if they are not
+		connected yet.
+	*/
+	void addDiagonal(const int a, const int b){
+		if(std::find(diagonals[a].begin(), diagonals[a].end(), b) != diagonals[a].end())
+			return;
+
+		diagonals[a].push_back(b);
+		diagonals[b].push_back(a);
+	}
+};
+
+/*
+	The order of the edges intersecting the sweep line from left to right
+*/
+struct SweepOrder{
+	Sweep const *sweep;
+
+	bool operator()(const int a, const int b) const{
+		return (*sweep).xAt(a) < (*sweep).xAt(b);
+	}
+};
+
+/*
+	The function orientation() computes the orientation of three points with the arithmetic
+	given by the settings.
+
+	@return 	A positive value for a left turn, a negative value for a right turn and 0 if
+				the points are collinear
+*/
+static double orientation(point const &a, point const &b, point const &c){
+	if(Settings::arithmetics == Arithmetics::EXACT)
+		return orient2d(a, b, c);
+
+	return (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+}
+
+/*
+	The function decompose() adds the diagonals which split the domain into y-monotone
+	polygons.
+
+	@param 	S 	The sweep over the domain
+	@return 	False if the sweep ran into an inconsistency, otherwise true
+*/
+static bool decompose(Sweep &S){
+	int m = S.pt.size();
+	int s, e, left;
+	std::vector<int> order(m);
+	std::vector<SweepVertex> type(m);
+	SweepOrder cmp = {&S};
+	std::set<int, SweepOrder> status(cmp);
+	std::vector<std::set<int, SweepOrder>::iterator> position(m, status.end());
+	std::set<int, SweepOrder>::iterator it;
+
+	// Classify the vertices
+	for(s = 0; s < m; s++){
+		order[s] = s;
+
+		if(S.above(s, S.prev[s]) && S.above(s, S.next[s])){
+			if(orientation(S.at(S.prev[s]), S.at(s), S.at(S.next[s])) > 0)
+				type[s] = SweepVertex::START;
+			else
+				type[s] = SweepVertex::SPLIT;
+		}else if(S.above(S.prev[s], s) && S.above(S.next[s], s)){
+			if(orientation(S.at(S.prev[s]), S.at(s), S.at(S.next[s])) > 0)
+				type[s] = SweepVertex::END;
+			else
+				type[s] = SweepVertex::MERGE;
+		}else
+			type[s] = SweepVertex::REGULAR;
+	}
+
+	std::sort(order.begin(), order.end(), [&](const int a, const int b){
+		return S.above(a, b);
+	});
+
+	// The edge directly left of the actual vertex
+	auto findLeft = [&]() -> int {
+		it = status.lower_bound(-1);
+		if(it == status.begin())
+			return -1;
+		--it;
+		return *it;
+	};
+
+	auto insert = [&](const int edge){
+		position[edge] = status.insert(edge).first;
+		S.helper[edge] = edge;
+	};
+
+	auto remove = [&](const int edge) -> bool {
+		if(position[edge] == status.end())
+			return false;
+		status.erase(position[edge]);
+		position[edge] = status.end();
+		return true;
+	};
+
+	for(auto& v : order){
+		S.sweepY = S.at(v).y;
+		S.sweepX = S.at(v).x;
+		e = S.prev[v];
+
+		switch(type[v]){
+			case SweepVertex::START:
+				insert(v);
+				break;
+			case SweepVertex::END:
+				if(type[S.helper[e]] == SweepVertex::MERGE)
+					S.addDiagonal(v, S.helper[e]);
+				if(!remove(e))
+					return false;
+				break;
+			case SweepVertex::SPLIT:
+				left = findLeft();
+				if(left == -1)
+					return false;
+				S.addDiagonal(v, S.helper[left]);
+				S.helper[left] = v;
+				insert(v);
+				break;
+			case SweepVertex::MERGE:
+				if(type[S.helper[e]] == SweepVertex::MERGE)
+					S.addDiagonal(v, S.helper[e]);
+				if(!remove(e))
+					return false;
+				left = findLeft();
+				if(left == -1)
+					return false;
+				if(type[S.helper[left]] == SweepVertex::MERGE)
+					S.addDiagonal(v, S.helper[left]);
+				S.helper[left] = v;
+				break;
+			case SweepVertex::REGULAR:
+				// The domain lies to the right if the boundary goes downwards
+				if(S.above(e, v)){
+					if(type[S.helper[e]] == SweepVertex::MERGE)
+						S.addDiagonal(v, S.helper[e]);
+					if(!remove(e))
+						return false;
+					insert(v);
+				}else{
+					left = findLeft();
+					if(left == -1)
+						return false;
+					if(type[S.helper[left]] == SweepVertex::MERGE)
+						S.addDiagonal(v, S.helper[left]);
+					S.helper[left] = v;
+				}
+				break;
+		}
+	}
+
+	return status.empty();
+}
+
+/*
+	The function triangulateMonotone() triangulates a y-monotone polygon by the stack
+	algorithm.
+
+	@param 	S 			The sweep over the domain
+	@param 	face 		The slots of the polygon in counterclockwise order
+	@param 	triangles 	The indices of the vertices of the triangles get appended to it
+*/
+static void triangulateMonotone(Sweep const &S, std::vector<int> const &face,
+	std::vector<int> &triangles){
+
+	int k = face.size();
+	int i, top = 0, bottom = 0, li, ri, u, last;
+	std::vector<int> order, stack;
+	std::vector<bool> left(k, false);
+
+	auto emit = [&](const int a, const int b, const int c){
+		triangles.push_back(S.pt[face[a]]);
+		triangles.push_back(S.pt[face[b]]);
+		triangles.push_back(S.pt[face[c]]);
+	};
+
+	for(i = 1; i < k; i++){
+		if(S.above(face[i], face[top]))
+			top = i;
+		if(S.above(face[bottom], face[i]))
+			bottom = i;
+	}
+
+	// Merge the left chain, from the top forwards, and the right chain, from the top
+	// backwards, into the order of the sweep
+	order.push_back(top);
+	left[top] = true;
+	li = (top + 1) % k;
+	ri = (top - 1 + k) % k;
+	while(li != bottom || ri != bottom){
+		if(li != bottom && (ri == bottom || S.above(face[li], face[ri]))){
+			left[li] = true;
+			order.push_back(li);
+			li = (li + 1) % k;
+		}else{
+			order.push_back(ri);
+			ri = (ri - 1 + k) % k;
+		}
+	}
+	order.push_back(bottom);
+
+	stack.push_back(order[0]);
+	stack.push_back(order[1]);
+
+	for(i = 2; i < k - 1; i++){
+		u = order[i];
+
+		if(left[u] != left[stack.back()]){
+			// Connect u to all vertices on the other chain
+			for(size_t j = 0; j + 1 < stack.size(); j++){
+				if(left[u])
+					emit(u, stack[j + 1], stack[j]);
+				else
+					emit(u, stack[j], stack[j + 1]);
+			}
+
+			last = stack.back();
+			stack.clear();
+			stack.push_back(last);
+			stack.push_back(u);
+		}else{
+			// Cut off the vertices of the same chain visible from u
+			last = stack.back();
+			stack.pop_back();
+
+			while(!stack.empty()){
+				if(left[u]){
+					if(orientation(S.at(face[stack.back()]), S.at(face[last]), S.at(face[u])) <= 0)
+						break;
+					emit(stack.back(), last, u);
+				}else{
+					if(orientation(S.at(face[u]), S.at(face[last]), S.at(face[stack.back()])) <= 0)
+						break;
+					emit(u, last, stack.back());
+				}
+
+				last = stack.back();
+				stack.pop_back();
+			}
+
+			stack.push_back(last);
+			stack.push_back(u);
+		}
+	}
+
+	// Connect the bottom to the remaining vertices
+	u = order[k - 1];
+	for(size_t j = 0; j + 1 < stack.size(); j++){
+		if(!left[stack.back()])
+			emit(u, stack[j + 1], stack[j]);
+		else
+			emit(u, stack[j], stack[j + 1]);
+	}
+}
+
+/*
+	The function triangulateDomain() triangulates a polygonal domain, i.e. a polygon with
+	holes, in O(n log n) time. It splits the domain into y-monotone polygons by a plane
+	sweep and triangulates each of them in linear time (see de Berg et al., Computational
+	Geometry, chapter 3).
+
+	@param 	points 		The coordinates of all vertices
+	@param 	rings 		The rings of the domain as lists of indices into points, the first
+						one is the boundary in counterclockwise order, the others are the
+						holes in clockwise order, i.e. the domain is always to the left
+	@param 	triangles 	The indices of the vertices of the triangles get appended to it,
+						three per triangle in counterclockwise order
+	@return 			False if the sweep found the rings to be no valid domain, e.g. as
+						they intersect, otherwise true
+
+	Note:
+		- The rings must be simple, disjoint and the holes must lie inside the boundary,
+			violations are just detected if they break the sweep
+		- The orientations are computed with the arithmetic given by Settings::arithmetics
+*/
+bool triangulateDomain(std::vector<point> const &points, std::vector<std::vector<int>> const &rings,
+	std::vector<int> &triangles){
+
+	Sweep S(points);
+	int m = 0, first, i, d, a, b, c, start;
+	size_t expected = triangles.size() / 3;
+	std::vector<std::vector<std::pair<double, int>>> around;
+	std::vector<std::vector<bool>> used;
+	std::vector<int> face;
+
+	// Number the vertices of all rings consecutively
+	for(auto const& r : rings){
+		first = m;
+		d = r.size();
+
+		for(i = 0; i < d; i++){
+			S.pt.push_back(r[i]);
+			S.prev.push_back(first + (i - 1 + d) % d);
+			S.next.push_back(first + (i + 1) % d);
+		}
+
+		m = m + d;
+
+		// A domain with h holes gets n + 2h - 2 triangles
+		expected = expected + d + (first == 0 ? -2 : 2);
+	}
+
+	S.helper.assign(m, -1);
+	S.diagonals.assign(m, std::vector<int>());
+
+	if(!decompose(S))
+		return false;
+
+	// Sort the neighbours of each slot counterclockwise
+	around.resize(m);
+	used.resize(m);
+	for(a = 0; a < m; a++){
+		auto add = [&](const int b){
+			around[a].push_back(std::make_pair(atan2(S.at(b).y - S.at(a).y, S.at(b).x - S.at(a).x), b));
+		};
+
+		add(S.prev[a]);
+		add(S.next[a]);
+		for(auto& diagonal : S.diagonals[a])
+			add(diagonal);
+
+		std::sort(around[a].begin(), around[a].end());
+		used[a].assign(around[a].size(), false);
+	}
+
+	// The edge from a slot to its previous slot borders the outside of the domain
+	for(a = 0; a < m; a++){
+		for(d = 0; d < (int)around[a].size(); d++){
+			if(around[a][d].second == S.prev[a])
+				used[a][d] = true;
+		}
+	}
+
+	// Walk around the monotone polygons, the next edge of a polygon is the first edge in
+	// clockwise order after the edge it arrives on
+	for(start = 0; start < m; start++){
+		for(d = 0; d < (int)around[start].size(); d++){
+			if(used[start][d])
+				continue;
+
+			face.clear();
+			a = start;
+			i = d;
+
+			while(!used[a][i]){
+				used[a][i] = true;
+				face.push_back(a);
+
+				b = around[a][i].second;
+				auto back = std::make_pair(atan2(S.at(a).y - S.at(b).y, S.at(a).x - S.at(b).x), a);
+				c = std::lower_bound(around[b].begin(), around[b].end(), back) - around[b].begin();
+				if(c == (int)around[b].size() || around[b][c].second != a)
+					return false;
+
+				i = (c - 1 + around[b].size()) % around[b].size();
+				a = b;
+			}
+
+			if(face.size() < 3)
+				return false;
+
+			triangulateMonotone(S, face, triangles);
+		}
+	}
+
+	return triangles.size() == 3 * expected;
+}
@@ -24,7 +24,35 @@
 /*
 	The number of already generated edges
 */
-unsigned long long TEdge::n = 0;
+std::atomic<unsigned long long> TEdge::n(0);
+
+/*
+	The flag whether the updates of the SelectionTree entries get deferred
+*/
+bool TEdge::stUpdatesDeferred = false;
+
+/*
+	The entries updated by the calling thread while the updates are deferred
+*/
+thread_local std::vector<STEntry<TEdge*>*> TEdge::deferredSTUpdates;
+
+
+/*
+	P ~ R ~ I ~ V ~ A ~ T ~ E 	M ~ E ~ M ~ B ~ E ~ R 	F ~ U ~ N ~ C ~ T ~ I ~ O ~ N ~ S
+*/
+
+/*
+	The function replaceTriangle() replaces a triangle of the edge by another one.
+
+	@param 	oldT 	The triangle to be replaced
+	@param 	newT 	The new triangle
+*/
+void TEdge::replaceTriangle(Triangle * const oldT, Triangle * const newT){
+	if(t0 == oldT)
+		t0 = newT;
+	else
+		t1 = newT;
+}
 
 
 /*
@@ -41,14 +69,12 @@ unsigned long long TEdge::n = 0;
 */
 TEdge::TEdge(Vertex * const V0, Vertex * const V1) :
 	T(NULL), v0(V0), v1(V1), t0(NULL), t1(NULL), type(EdgeType::TRIANGULATION), entry(NULL), 
-	intersected(false), id(n) { 
+	intersected(false), id(n++), relocated(NULL) { 
 	
 	// Register the new edge at its vertices
 	(*v0).addEdge(this);
 	(*v1).addEdge(this);
 
-	n++;
-
 	if(v0 == NULL || v1 == NULL || *v0 == *v1){
 		fprintf(stderr, "error circle edge\n");
 		exit(1);
@@ -72,7 +98,7 @@ TEdge::TEdge(Vertex * const V0, Vertex * const V1) :
 */
 TEdge::TEdge(Vertex * const V0, Vertex * const V1, const EdgeType tp) :
 	T(NULL), v0(V0), v1(V1), t0(NULL), t1(NULL), type(tp), entry(NULL), intersected(false),
-	id(n) {
+	id(n++), relocated(NULL) {
 	
 	// For polygon edges set the ordering in the polygon
 	if(type == EdgeType::POLYGON){
@@ -84,14 +110,33 @@ TEdge::TEdge(Vertex * const V0, Vertex * const V1, const EdgeType tp) :
 	(*v0).addEdge(this);
 	(*v1).addEdge(this);
 
-	n++;
-
 	if(v0 == NULL || v1 == NULL || *v0 == *v1){
 		fprintf(stderr, "error circle edge\n");
 		exit(1);
 	}
 }
 
+/*
+	Constructor:
+	Generates a copy of the edge e for the relayout of the triangulation. The copy
+	connects the copies of the vertices of e and takes over the ID, the type, the
+	triangulation and the SelectionTree entry of e, whereas e gets unregistered from the
+	triangulation and the SelectionTree.
+
+	@param 	e 	The edge to be copied
+*/
+TEdge::TEdge(TEdge * const e) :
+	T((*e).T), v0((*(*e).v0).getRelocated()), v1((*(*e).v1).getRelocated()), t0(NULL), t1(NULL),
+	type((*e).type), entry((*e).entry), intersected((*e).intersected), id((*e).id),
+	relocated(NULL) {
+
+	if(entry != NULL)
+		(*entry).replaceObject(this);
+
+	(*e).entry = NULL;
+	(*e).T = NULL;
+}
+
 
 /*
 	S ~ E ~ T ~ T ~ E ~ R ~ S
@@ -141,7 +186,8 @@ void TEdge::setEdgeType(const EdgeType tp, const bool temp){
 	edge. The new triangle is set at t0 if t0 is NULL, otherwise it is set at t1 if
 	t1 is NULL, otherwise the function errors with exit code 4 if the edge has already
 	registered two triangles. The function errors with exit code 5 if the edge has already
-	registered the same triangle.
+	registered the same triangle. As the weight of a polygon edge depends on its
+	triangles, its STEntry gets updated as soon as both triangles are registered.
 
 	@param 	t 	The new triangle
 */
@@ -157,6 +203,9 @@ void TEdge::setTriangle(Triangle * const t){
 		fprintf(stderr, "The edge from vertex %llu to vertex %llu has already registered the same triangle! \n", (*v0).getID(), (*v1).getID());
 		exit(5);
 	}	
+
+	if(entry != NULL && t0 != NULL && t1 != NULL)
+		updateSTEntry();
 }
 
 /*
@@ -280,12 +329,20 @@ STEntry<TEdge*> *TEdge::getSTEntry() const{
 }
 
 /*
-	Computes the weight for the SelectionTree which is the length of the edge.
+	Computes the weight for the SelectionTree which is the length of the edge. Edges which
+	are not suitable for insertions get the weight 0, so they never get selected.
+
+	@return 	The length of the edge if it is suitable for insertions, otherwise 0
 
-	@return 	The length of the edge
+	Note:
+		The weight depends on the triangles of the edge, so it just gets computed by the
+		thread changing them respectively by the main thread after a parallel round
 */
 double TEdge::getWeight() const{
- return length();
+	if(!isSuitableForInsertion())
+		return 0;
+
+	return length();
 }
 
 /*
@@ -295,6 +352,14 @@ bool TEdge::isIntersected() const{
 	return intersected;
 }
 
+/*
+	@return 	The copy of the edge generated by the running relayout, NULL if the edge
+				has not been relocated
+*/
+TEdge *TEdge::getRelocated() const{
+	return relocated;
+}
+
 
 /*
 	R ~ E ~ M ~ O ~ V ~ E ~ R
@@ -477,10 +542,177 @@ bool TEdge::isBetween(Vertex const * const v) const{
 
 /*
 	Updates the length in the STEntry of the edge which also updates the entries of
-	all ancestors in the SelectionTree
+	all ancestors in the SelectionTree. While the updates are deferred, the entry just
+	gets recorded for the calling thread.
+
+	Note:
+		The parallel phases defer the updates, as the ancestors of an entry are shared with
+		edges processed by other threads. The recorded entries get applied sequentially
+		after the threads have joined.
 */
 void TEdge::updateSTEntry() const{
-	(*entry).update();
+	if(stUpdatesDeferred)
+		deferredSTUpdates.push_back(entry);
+	else
+		(*entry).update();
+}
+
+/*
+	The function isSuitableForInsertion() checks whether a vertex can be inserted into the
+	edge without risking numerical problems. Therefore the edge must have two triangles and
+	at least the length Settings::minLength and, in case we use the double arithmetics,
+	both triangles' determinants must be at least Settings::minDetInsertion.
+
+	@return 	True if the edge fulfills the criteria, otherwise false
+*/
+bool TEdge::isSuitableForInsertion() const{
+
+	if(t0 == NULL || t1 == NULL)
+		return false;
+
+	// Check the length of the edge
+	if(length() < Settings::minLength)
+		return false;
+
+	// Check the triangle areas
+	if(Settings::arithmetics == Arithmetics::DOUBLE){
+		if(fabs((*t0).signedArea()) < Settings::minDetInsertion)
+			return false;
+
+		if(fabs((*t1).signedArea()) < Settings::minDetInsertion)
+			return false;
+	}
+
+	return true;
+}
+
+/*
+	The function relocate() places a copy of the edge in an arena during a relayout of
+	the triangulation. The copy connects the copies of the vertices of the edge and takes
+	over its ID, type, triangulation and SelectionTree entry.
+
+	@param 	a 	The arena of the relayout
+	@return 	The copy of the edge
+
+	Note:
+		- Both vertices of the edge must already be relocated
+		- The copy does not register itself at its vertices, this is done by
+			Vertex::relocateReferences()
+*/
+TEdge *TEdge::relocate(Arena * const a){
+	relocated = ::new((*a).allocate(sizeof(TEdge))) TEdge(this);
+
+	return relocated;
+}
+
+/*
+	The function flip() replaces the edge by the other diagonal of the quadrilateral formed
+	by its two triangles. The edge and both triangles are reused and just get rewired at
+	their vertices and edges, so they keep their IDs and SelectionTree entries. Afterwards
+	t is the triangle containing the former vertex v0 of the edge and the other triangle
+	is the one containing the former vertex v1.
+
+	@param 	t 	One of the triangles of the edge
+
+	Note:
+		- The edge must be a triangulation edge with two triangles forming a convex
+			quadrilateral
+		- Flipping the edge again restores the state before the flip
+		- The SelectionTree entries of the triangles and of the polygon edges of the
+			quadrilateral get updated, as their weights depend on the triangles
+*/
+void TEdge::flip(Triangle * const t){
+	Triangle *other;
+	Vertex *oldV0, *oldV1, *newV0, *newV1;
+	TEdge *e00, *e01, *e10, *e11;
+
+	other = getOtherTriangle(t);
+
+	oldV0 = v0;
+	oldV1 = v1;
+	newV0 = (*t).getOtherVertex(this);
+	newV1 = (*other).getOtherVertex(this);
+
+	// The edges of the quadrilateral, e01 moves from the other triangle to t and e10 moves
+	// from t to the other triangle
+	e00 = (*oldV0).getEdgeTo(newV0);
+	e01 = (*oldV0).getEdgeTo(newV1);
+	e10 = (*oldV1).getEdgeTo(newV0);
+	e11 = (*oldV1).getEdgeTo(newV1);
+
+	// Connect the edge to the other diagonal
+	(*oldV0).removeEdge(this);
+	(*oldV1).removeEdge(this);
+
+	v0 = newV0;
+	v1 = newV1;
+	intersected = false;
+
+	(*v0).addEdge(this);
+	(*v1).addEdge(this);
+
+	// Rewire the triangles
+	(*t).reassign(this, e00, e01, newV0, newV1, oldV0);
+	(*other).reassign(this, e10, e11, newV0, newV1, oldV1);
+
+	(*e01).replaceTriangle(other, t);
+	(*e10).replaceTriangle(t, other);
+
+	(*oldV0).removeTriangle(other);
+	(*oldV1).removeTriangle(t);
+	(*newV0).addTriangle(other);
+	(*newV1).addTriangle(t);
+
+	// Update the weights depending on the triangles
+	(*t).updateSTEntry();
+	(*other).updateSTEntry();
+
+	if((*e00).entry != NULL) (*e00).updateSTEntry();
+	if((*e01).entry != NULL) (*e01).updateSTEntry();
+	if((*e10).entry != NULL) (*e10).updateSTEntry();
+	if((*e11).entry != NULL) (*e11).updateSTEntry();
+}
+
+/*
+	The function relocateReferences() sets the triangles of the copy of the edge to the
+	copies of its own triangles.
+*/
+void TEdge::relocateReferences(){
+	(*relocated).t0 = t0 == NULL ? NULL : (*t0).getRelocated();
+	(*relocated).t1 = t1 == NULL ? NULL : (*t1).getRelocated();
+}
+
+/*
+	The function deferSTUpdates() starts respectively stops deferring the updates of the
+	SelectionTree entries of all edges. It must only be called while no worker thread is
+	running.
+
+	@param 	defer 	True if the updates get deferred from now on, false otherwise
+*/
+void TEdge::deferSTUpdates(const bool defer){
+	stUpdatesDeferred = defer;
+}
+
+/*
+	The function takeDeferredSTUpdates() hands the entries the calling thread has
+	recorded while the updates were deferred over to the caller.
+
+	@param 	updates 	The vector the recorded entries get appended to
+*/
+void TEdge::takeDeferredSTUpdates(std::vector<STEntry<TEdge*>*> &updates){
+	updates.insert(updates.end(), deferredSTUpdates.begin(), deferredSTUpdates.end());
+	deferredSTUpdates.clear();
+}
+
+/*
+	The function applySTUpdates() updates the given SelectionTree entries in the given
+	order.
+
+	@param 	updates 	The entries to update
+*/
+void TEdge::applySTUpdates(std::vector<STEntry<TEdge*>*> const &updates){
+	for(auto& e : updates)
+		(*e).update();
 }
 
 
@@ -25,7 +25,6 @@
 /*
 	The number of already generated polygons
 */
-unsigned int TPolygon::N = 0;
 
 
 /*
@@ -37,14 +36,13 @@ unsigned int TPolygon::N = 0;
 	Already allocates memory for all vertices which will be inserted in the future.
 
 	@param 	t 	The triangulation the new polygon lives in
+	@param 	i 	The ID of the new polygon in its triangulation
 	@param 	n 	The target number of vertices of the new polygon
 */
-TPolygon::TPolygon(Triangulation const * const t, const int n) :
-	T(t), tree(new SelectionTree<TEdge*>(true)), id(N) {
+TPolygon::TPolygon(Triangulation const * const t, const unsigned int i, const int n) :
+	T(t), tree(new SelectionTree<TEdge*>(Settings::weightedEdgeSelection)), id(i) {
 
 	vertices.reserve(n);
-
-	N++;
 }
 
 
@@ -108,7 +106,9 @@ int TPolygon::getActualPolygonSize() const{
 }
 
 /*
-	@return 	Any edge of the polygon selected uniformly at random by its length
+	@return 	Any edge of the polygon suitable for insertions selected uniformly at random,
+				weighted by its length if weighted edge selection is enabled, NULL if there
+				is no such edge
 */
 TEdge *TPolygon::getRandomEdgeWeighted() const{
 	return (*tree).getRandomObject();
@@ -161,6 +161,28 @@ void TPolygon::writeToLine(std::ostream& os) const {
 	os << std::endl;
 }
 
+/*
+	Write this polygon to f in binary format, i.e. its number of vertices followed by
+	their coordinates.
+
+	@param  f       Output file
+*/
+void TPolygon::writeToBinary(FILE *f) const {
+	uint32_t num_v = vertices.size();
+	double coords[2];
+	const Vertex * const start = getVertex(0);
+	const Vertex * other = start;
+
+	fwrite(&num_v, sizeof(num_v), 1, f);
+
+	do {
+		coords[0] = other->getX();
+		coords[1] = other->getY();
+		fwrite(coords, sizeof(double), 2, f);
+		other = other->getNext();
+	} while (other != start);
+}
+
 /*
 	Check the correctness of the SelectionTree
 */
@@ -171,3 +193,13 @@ void TPolygon::checkST() const{
 
 	fprintf(stderr, "SelectionTree successfully checked\n");
 }
+
+/*
+	The function relocateVertices() replaces all vertices of the polygon by their copies
+	generated by a relayout of the triangulation. The order of the vertices stays the
+	same.
+*/
+void TPolygon::relocateVertices(){
+	for(auto& i : vertices)
+		i = (*i).getRelocated();
+}
@@ -0,0 +1,164 @@
+/*
+ * Copyright 2021 Philipp Mayer - pmayer@cs.sbg.ac.at
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "tracer.h"
+
+/*
+	S ~ T ~ A ~ T ~ I ~ C 	V ~ A ~ R ~ I ~ A ~ B ~ L ~ E ~ S
+*/
+
+/*
+	The flag for enabling the recording
+*/
+bool Tracer::enabled = false;
+
+/*
+	The recorded events and their start time
+*/
+std::mutex Tracer::lock;
+std::vector<TraceEvent> Tracer::events;
+std::chrono::steady_clock::time_point Tracer::start;
+
+/*
+	The IDs of the threads
+*/
+std::atomic<unsigned int> Tracer::nrThreads(0);
+thread_local unsigned int Tracer::tid = 0;
+
+/*
+	The number of translations of each thread
+*/
+thread_local unsigned long long Tracer::translations = 0;
+
+
+/*
+	O ~ T ~ H ~ E ~ R ~ S
+*/
+
+/*
+	The function begin() enables the recording and sets the start time of the trace.
+*/
+void Tracer::begin(){
+	start = std::chrono::steady_clock::now();
+	enabled = true;
+}
+
+/*
+	@return 	The time since the start of the trace (in microseconds)
+*/
+double Tracer::now(){
+	return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+
+/*
+	@return 	The ID of the calling thread in the trace
+*/
+unsigned int Tracer::getThreadID(){
+	if(tid == 0)
+		tid = ++nrThreads;
+
+	return tid;
+}
+
+/*
+	The function add() adds an event to the trace.
+
+	@param 	e 	The event
+*/
+void Tracer::add(TraceEvent &e){
+	e.tid = getThreadID();
+
+	std::lock_guard<std::mutex> guard(lock);
+	events.push_back(e);
+}
+
+/*
+	The function counter() adds counter values at the actual time to the trace.
+
+	@param 	name 	The name of the counter track
+	@param 	values 	The names and values of the counters
+*/
+void Tracer::counter(const char *name, std::vector<std::pair<const char*, double>> values){
+	TraceEvent e;
+
+	if(!enabled)
+		return;
+
+	e.phase = 'C';
+	e.name = name;
+	e.category = "counter";
+	e.ts = now();
+	e.dur = 0;
+	e.args = values;
+
+	add(e);
+}
+
+/*
+	The function sampleTranslation() counts a translation of the calling thread and
+	decides whether it gets its own span.
+
+	@return 	True if the translation should be traced, otherwise false
+*/
+bool Tracer::sampleTranslation(){
+	if(!enabled)
+		return false;
+
+	translations++;
+
+	return translations % translationSampling == 0;
+}
+
+/*
+	The function write() writes all recorded events in the Chrome trace event format
+	into a JSON file.
+
+	@param 	filename 	The name of the file
+
+	Note:
+		Must not be called while other threads record anything
+*/
+void Tracer::write(const char *filename){
+	FILE *f;
+	unsigned int i, j;
+
+	f = fopen(filename, "w");
+	if(f == NULL){
+		fprintf(stderr, "Tracer error: could not open the file %s\n", filename);
+		return;
+	}
+
+	fprintf(f, "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n");
+
+	for(i = 0; i < events.size(); i++){
+		TraceEvent const &e = events[i];
+
+		fprintf(f, "{\"name\": \"%s\", \"cat\": \"%s\", \"ph\": \"%c\", \"ts\": %.3f, ",
+			e.name, e.category, e.phase, e.ts);
+		if(e.phase == 'X')
+			fprintf(f, "\"dur\": %.3f, ", e.dur);
+		fprintf(f, "\"pid\": 1, \"tid\": %u, \"args\": {", e.tid);
+
+		for(j = 0; j < e.args.size(); j++)
+			fprintf(f, "%s\"%s\": %.17g", j > 0 ? ", " : "", e.args[j].first, e.args[j].second);
+
+		fprintf(f, "}}%s\n", i + 1 < events.size() ? "," : "");
+	}
+
+	fprintf(f, "]}\n");
+
+	fclose(f);
+}
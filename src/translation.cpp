@@ -24,7 +24,7 @@
 /*
 	The number of already generated vertices
 */
-unsigned long long Translation::n = 0;
+std::atomic<unsigned long long> Translation::n(0);
 
 
 /*
@@ -50,9 +50,11 @@ unsigned long long Translation::n = 0;
 			which makes the function think, that the vertex is outside of the quadrilateral.
 			Therefore the function automatically returns true, if it gets two or more vertex
 			intersection anywhere. This leads to rejecting the translation.
+		- The dummy edge starts at a copy of v, as v may belong to another region of the
+			triangulation during a parallel translation phase
 */
 bool Translation::insideQuadrilateral(Vertex * const v) const{
-	Vertex *dummyVertex;
+	Vertex *dummyVertex, *copyV;
 	TEdge *dummyEdge;
 	double maxX, x;
 	int count = 0;
@@ -79,7 +81,9 @@ bool Translation::insideQuadrilateral(Vertex * const v) const{
 	maxX = maxX + 10;
 	dummyVertex = new Vertex(maxX, (*v).getY());
 
-	dummyEdge = new TEdge(v, dummyVertex);
+	// The dummy edge starts at a copy of v, so it does not get registered at v itself
+	copyV = (*v).getTranslated(0, 0);
+	dummyEdge = new TEdge(copyV, dummyVertex);
 
 	// Count the intersection
 	intersection = checkIntersection(dummyEdge, prevOldE, false);
@@ -108,6 +112,7 @@ bool Translation::insideQuadrilateral(Vertex * const v) const{
 
 	delete dummyEdge;
 	delete dummyVertex;
+	delete copyV;
 
 	// If there was any intersection of type vertex return false, so the translation gets
 	// refused. The point is, for an vertex intersection we can not say anything for sure
@@ -128,9 +133,11 @@ bool Translation::insideQuadrilateral(Vertex * const v) const{
 	continue the check in the other triangle assigned to the intersected edge until newE either
 	intersects a polygon edge or ends in any triangle.
 
-	@param 	fromV 	The vertex where the new edge starts
-	@param 	newE 	The new edge
-	@return 		True if the new edge does not intersect any polygon edge, otherwise false
+	@param 	fromV 		The vertex where the new edge starts
+	@param 	newE 		The new edge
+	@param 	exempt0 	A polygon edge which is treated as triangulation edge, can be NULL
+	@param 	exempt1 	A polygon edge which is treated as triangulation edge, can be NULL
+	@return 			True if the new edge does not intersect any polygon edge, otherwise false
 
 	Note:
 		- If the edge goes right through another vertex we also count it as intersecting a polygon
@@ -143,8 +150,14 @@ bool Translation::insideQuadrilateral(Vertex * const v) const{
 			in checkIntersection() should lead to getting all these cases as intersections of
 			type VERTEX.
 		- Edges of the bounding box are treated as polygon edges
+		- All edges of the surrounding polygon get checked, not just the ones in direction
+			of the new edge, as the epsilon of checkIntersection() also reports vertices of
+			other edges close to the new edge
+		- The function does not change anything, so the checks of multiple translations
+			can run concurrently
 */
-bool Translation::checkEdge(Vertex * const fromV, TEdge * const newE) const{
+bool Translation::checkEdge(Vertex * const fromV, TEdge * const newE, TEdge * const exempt0,
+	TEdge * const exempt1) const{
 	std::vector<TEdge*> surEdges;
 	enum IntersectionType iType = IntersectionType::NONE;
 	enum IntersectionType iType0, iType1;
@@ -157,9 +170,16 @@ bool Translation::checkEdge(Vertex * const fromV, TEdge * const newE) const{
 
 	Statistics::nrChecks++;
 	Statistics::nrTriangles++;
+	crossedTriangles++;
 
 	surEdges = (*fromV).getSurroundingEdges();
 
+	addToReadSet(fromV);
+	for(auto& i : surEdges){
+		addToReadSet((*i).getV0());
+		addToReadSet((*i).getV1());
+	}
+
 	size = surEdges.size();
 
 	Statistics::nrSPTriangles = Statistics::nrSPTriangles + size;
@@ -171,8 +191,10 @@ bool Translation::checkEdge(Vertex * const fromV, TEdge * const newE) const{
 		iType = checkIntersection(newE, i, false);
 
 		// New edge hits vertex of surrounding polygon
-		if(iType == IntersectionType::VERTEX)
+		if(iType == IntersectionType::VERTEX){
+			edgeFailure = Rejection::VERTEXHIT;
 			return false;
+		}
 
 		// Count intersections to detect numerical errors
 		if(iType == IntersectionType::EDGE){
@@ -189,23 +211,29 @@ bool Translation::checkEdge(Vertex * const fromV, TEdge * const newE) const{
 		if(Settings::feedback == FeedbackMode::VERBOSE)
 			fprintf(stderr, "CheckEdge: new edge intersects multiple edges of the surrounding polygon -> translation rejected due to numerical problem\n");
 		
+		edgeFailure = Rejection::NUMERICAL;
 		return false;
 	}
 
 	// One real intersection with an edge of the surrounding polygon
 	eType = (*intersectedE).getEdgeType();
+	if(intersectedE == exempt0 || intersectedE == exempt1)
+		eType = EdgeType::TRIANGULATION;
 
 	// Intersected edge is a polygon or frame edge
 	if(eType != EdgeType::TRIANGULATION){
+		edgeFailure = (eType == EdgeType::FRAME) ? Rejection::FRAMEHIT : Rejection::POLYGONHIT;
 		return false;
 	// Intersected edge is just a triangulation edge
 	}else{
 		nextT = (*intersectedE).getTriangleNotContaining(fromV);
 		surEdges = (*nextT).getOtherEdges(intersectedE);
+		addToReadSet((*nextT).getOtherVertex(intersectedE));
 	}
 
 	passedTriangles++;
 	Statistics::nrTriangles++;
+	crossedTriangles++;
 
 	// Iterate over the adjacent triangles if there was an intersection with a triangulation edge
 	// Here surEdges always have the length 2
@@ -218,16 +246,17 @@ bool Translation::checkEdge(Vertex * const fromV, TEdge * const newE) const{
 			return true;
 
 		// New edge hits a vertex
-		if(iType0 == IntersectionType::VERTEX) 
-			return false;
-		if(iType1 == IntersectionType::VERTEX) 
+		if(iType0 == IntersectionType::VERTEX || iType1 == IntersectionType::VERTEX){
+			edgeFailure = Rejection::VERTEXHIT;
 			return false;
+		}
 
 		// Check for numerical problems
 		if(iType0 != IntersectionType::NONE && iType1 != IntersectionType::NONE){
 			if(Settings::feedback == FeedbackMode::VERBOSE)
 				fprintf(stderr, "CheckEdge: new edge intersects multiple edges of the actual triangle -> translation rejected due to numerical problem\n");
 			
+			edgeFailure = Rejection::NUMERICAL;
 			return false;
 		}
 
@@ -241,18 +270,23 @@ bool Translation::checkEdge(Vertex * const fromV, TEdge * const newE) const{
 		}
 
 		eType = (*intersectedE).getEdgeType();
+		if(intersectedE == exempt0 || intersectedE == exempt1)
+			eType = EdgeType::TRIANGULATION;
 
 		// intersected edge is a polygon or frame edge
 		if(eType != EdgeType::TRIANGULATION){
+			edgeFailure = (eType == EdgeType::FRAME) ? Rejection::FRAMEHIT : Rejection::POLYGONHIT;
 			return false;
 		// Intersected edge is just a triangulation edge
 		}else{
 			nextT = (*intersectedE).getOtherTriangle(nextT);
 			surEdges = (*nextT).getOtherEdges(intersectedE);
+			addToReadSet((*nextT).getOtherVertex(intersectedE));
 		}
 
 		passedTriangles++;
 		Statistics::nrTriangles++;
+		crossedTriangles++;
 
 		if(passedTriangles > Statistics::maxTriangles)
 			Statistics::maxTriangles = passedTriangles;
@@ -261,6 +295,51 @@ bool Translation::checkEdge(Vertex * const fromV, TEdge * const newE) const{
 	return true;
 }
 
+/*
+	The function addToReadSet() appends a vertex to the read set of the translation if it
+	has one.
+
+	@param 	v 	The vertex which has been read
+*/
+void Translation::addToReadSet(Vertex * const v) const{
+	if(readSet != NULL)
+		(*readSet).push_back(v);
+}
+
+/*
+	The function setRejection() marks the translation as rejected. The rejection gets
+	counted in the statistics when the translation is destroyed.
+
+	@param 	r 	The reason of the rejection
+*/
+void Translation::setRejection(const Rejection r) const{
+	rejected = true;
+	rejection = r;
+}
+
+/*
+	The function recordCosts() records the wall time, the number of passed triangles and
+	the number of flips of the translation in the histograms of its engine.
+
+	@param 	e 	The engine of the translation
+
+	Note:
+		- Must be called by the destructors of the derived classes, such that the time
+			includes their clean up
+		- Translations executed by the translation itself, e.g. the parts of a split
+			translation, are included
+*/
+void Translation::recordCosts(const Engine e) const{
+	if(!counted)
+		return;
+
+	Statistics::addToHistogram(e, Distribution::TIME, std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now() - created).count());
+	Statistics::addToHistogram(e, Distribution::TRIANGLES, Statistics::nrTriangles - startTriangles);
+	if(e == Engine::KINETIC)
+		Statistics::addToHistogram(e, Distribution::FLIPS, Statistics::flips - startFlips);
+}
+
 
 /*
 	C ~ O ~ N ~ S ~ T ~ R ~ U ~ C ~ T ~ O ~ R ~ S
@@ -277,7 +356,7 @@ bool Translation::checkEdge(Vertex * const fromV, TEdge * const newE) const{
 	@param 	dY 		The y-component of the translation vector
 */
 Translation::Translation(Triangulation *Tr, int i, double dX, double dY) :
-	T(Tr), index(i), dx(dX), dy(dY), id(n){
+	T(Tr), index(i), dx(dX), dy(dY), id(n++), readSet(NULL){
 
 	original = (*T).getVertex(index);
 
@@ -293,10 +372,50 @@ Translation::Translation(Triangulation *Tr, int i, double dX, double dY) :
 	prevNewE = new TEdge(prevV, newV);
 	nextNewE = new TEdge(newV, nextV);
 
-	n++;
+	created = std::chrono::steady_clock::now();
+	edgeFailure = Rejection::POLYGONHIT;
+	rejected = false;
+	counted = true;
+	startTriangles = Statistics::nrTriangles;
+	startFlips = Statistics::flips;
+	crossedTriangles = 0;
+
 	Statistics::translationTries++;
 }
 
+/*
+	Constructor:
+	Generates a translation which is just used for checking. It initializes everything
+	except of the new polygon edges, which have to be generated by the derived class. The
+	translation does not get counted in the statistics.
+
+	@param 	Tr 		The triangulation the moving vertex lives in
+	@param 	v 		The vertex to move
+	@param 	dX 		The x-component of the translation vector
+	@param 	dY 		The y-component of the translation vector
+	@param 	rs 		The list the read vertices get appended to, can be NULL
+*/
+Translation::Translation(Triangulation *Tr, Vertex *v, double dX, double dY,
+	std::vector<Vertex*> *rs) :
+	T(Tr), index(-1), original(v), prevNewE(NULL), nextNewE(NULL), dx(dX), dy(dY), id(0),
+	readSet(rs){
+
+	prevV = (*original).getPrev();
+	nextV = (*original).getNext();
+
+	oldV = (*original).getTranslated(0, 0);
+	newV = (*original).getTranslated(dx, dy);
+
+	prevOldE = (*original).getToPrev();
+	nextOldE = (*original).getToNext();
+
+	created = std::chrono::steady_clock::now();
+	edgeFailure = Rejection::POLYGONHIT;
+	rejected = false;
+	counted = false;
+	crossedTriangles = 0;
+}
+
 /*
 	Constructor:
 	Generates a new Translation. Picks the moving vertex and its neighbors from the
@@ -308,7 +427,7 @@ Translation::Translation(Triangulation *Tr, int i, double dX, double dY) :
 	@param 	dY 		The y-component of the translation vector
 */
 Translation::Translation(Triangulation *Tr, Vertex *v, double dX, double dY) :
-	T(Tr), index(-1), original(v), dx(dX), dy(dY), id(n){
+	T(Tr), index(-1), original(v), dx(dX), dy(dY), id(n++), readSet(NULL){
 
 	prevV = (*original).getPrev();
 	nextV = (*original).getNext();
@@ -322,7 +441,14 @@ Translation::Translation(Triangulation *Tr, Vertex *v, double dX, double dY) :
 	prevNewE = new TEdge(prevV, newV);
 	nextNewE = new TEdge(newV, nextV);
 
-	n++;
+	created = std::chrono::steady_clock::now();
+	edgeFailure = Rejection::POLYGONHIT;
+	rejected = false;
+	counted = true;
+	startTriangles = Statistics::nrTriangles;
+	startFlips = Statistics::flips;
+	crossedTriangles = 0;
+
 	Statistics::translationTries++;
 }
 
@@ -355,6 +481,7 @@ Translation::Translation(Triangulation *Tr, Vertex *v, double dX, double dY) :
 		take a look at my Master Thesis
 */
 bool Translation::checkOrientation(){
+	ScopedTimer timer(ProfileSection::ORIENTATION);
 	bool orientationChange;
 	Vertex *randomV;
 	unsigned int i;
@@ -378,8 +505,10 @@ bool Translation::checkOrientation(){
 		inside0 = Triangle::insideTriangle(oldV, newV, prevV, randomV);
 		inside1 = Triangle::insideTriangle(oldV, newV, nextV, randomV);
 
-		if(inside0 || inside1)
+		if(inside0 || inside1){
+			setRejection(Rejection::ORIENTATION);
 			return true;
+		}
 	}
 
 	// Now we check whether the polygon rolls over another polygon or itself
@@ -408,23 +537,29 @@ bool Translation::checkOrientation(){
 		delete dummy;
 
 		// This already checks whether the vertex moves onto its opposing edge
-		if(signbit(areaOld) != signbit(areaNew) || fabs(areaNew) <= Settings::epsInt)
+		if(signbit(areaOld) != signbit(areaNew) || fabs(areaNew) <= Settings::epsInt){
+			setRejection(Rejection::ORIENTATION);
 			return true;
+		}
 
 	// Default Case:
 	}else{
 		// Check for vertex before the previous vertex whether it is inside the quadrilateral
 		randomV = (*prevV).getPrev();
+		addToReadSet(randomV);
 
 		orientationChange = insideQuadrilateral(randomV);
 
 		// Check also for a second vertex to increase the chance to reject non-simple translation
 		randomV = (*nextV).getNext();
+		addToReadSet(randomV);
 
 		orientationChange = orientationChange || insideQuadrilateral(randomV);
 
-		if(orientationChange)
+		if(orientationChange){
+			setRejection(Rejection::ORIENTATION);
 			return true;
+		}
 	}
 
 	
@@ -446,8 +581,10 @@ bool Translation::checkOrientation(){
 
 		orientationChange = insideQuadrilateral(randomV);
 
-		if(orientationChange)
+		if(orientationChange){
+			setRejection(Rejection::ORIENTATION);
 			return true;
+		}
 	}
 
 	return false;
@@ -459,18 +596,82 @@ bool Translation::checkOrientation(){
 	to one of its neighbors intersects a polygon edge.
 
 	@return 	True if the resulting polygon is still simple, otherwise false
+
+	Note:
+		The old polygon edges of the moving vertex are treated as triangulation edges
+		without changing their type
 */
 bool Translation::checkSimplicityOfTranslation() const{
+	ScopedTimer timer(ProfileSection::SIMPLICITY);
 	bool simple;
 
-	(*prevOldE).setEdgeType(EdgeType::TRIANGULATION, true);
-	(*nextOldE).setEdgeType(EdgeType::TRIANGULATION, true);
-
-	simple = checkEdge(prevV, prevNewE);
-	simple = simple && checkEdge(nextV, nextNewE);
+	simple = checkEdge(prevV, prevNewE, prevOldE, nextOldE);
+	simple = simple && checkEdge(nextV, nextNewE, prevOldE, nextOldE);
 
-	(*prevOldE).setEdgeType(EdgeType::POLYGON, true);
-	(*nextOldE).setEdgeType(EdgeType::POLYGON, true);
+	if(!simple)
+		setRejection(edgeFailure);
 
 	return simple;
 }
+
+/*
+	The function discard() excludes a translation which has been checked but does not get
+	executed from the statistics, e.g. as the same translation gets executed by another
+	translation engine.
+*/
+void Translation::discard(){
+	if(!counted)
+		return;
+
+	counted = false;
+
+	Statistics::translationTries--;
+}
+
+
+/*
+	G ~ E ~ T ~ T ~ E ~ R ~ S
+*/
+
+/*
+	@return 	True if the translation has been rejected, otherwise false
+*/
+bool Translation::isRejected() const{
+	return rejected;
+}
+
+/*
+	@return 	The reason of the rejection, just valid if the translation has been rejected
+*/
+Rejection Translation::getRejection() const{
+	return rejection;
+}
+
+/*
+	@return 	The time since the translation has been generated (in seconds)
+*/
+double Translation::getAge() const{
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - created).count();
+}
+
+/*
+	@return 	The number of triangles passed by the simplicity check of the translation
+*/
+unsigned int Translation::getCrossedTriangles() const{
+	return crossedTriangles;
+}
+
+
+/*
+	D ~ E ~ S ~ T ~ R ~ U ~ C ~ T ~ O ~ R
+*/
+
+/*
+	Destructor:
+	Counts the rejection of the translation in the statistics if it has been rejected and
+	is not just used for checking.
+*/
+Translation::~Translation(){
+	if(rejected && counted)
+		Statistics::addRejection(rejection, getAge());
+}
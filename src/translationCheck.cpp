@@ -0,0 +1,115 @@
+/*
+ * Copyright 2021 Philipp Mayer - pmayer@cs.sbg.ac.at
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "translationCheck.h"
+
+/*
+	C ~ O ~ N ~ S ~ T ~ R ~ U ~ C ~ T ~ O ~ R ~ S
+*/
+
+/*
+	Constructor:
+	Generates a translation which can just be checked but not executed. In contrast to
+	the other translations its construction does not change the triangulation at all, so
+	multiple translations can be checked concurrently as long as nobody changes the
+	triangulation.
+
+	@param 	Tr 		The triangulation the moving vertex lives in
+	@param 	v 		The vertex to move
+	@param 	dX 		The x-component of the translation vector
+	@param 	dY 		The y-component of the translation vector
+	@param 	rs 		The list all vertices the check depends on get appended to, can be NULL
+
+	Note:
+		The translation vector must be the one which really gets applied, see
+		getEffectiveTranslation()
+*/
+TranslationCheck::TranslationCheck(Triangulation *Tr, Vertex *v, double dX, double dY,
+	std::vector<Vertex*> *rs) :
+	Translation(Tr, v, dX, dY, rs){
+
+	std::list<TEdge*> edges;
+
+	prevCopy = (*prevV).getTranslated(0, 0);
+	nextCopy = (*nextV).getTranslated(0, 0);
+
+	prevNewE = new TEdge(prevCopy, newV);
+	nextNewE = new TEdge(newV, nextCopy);
+
+	// The translation vector gets computed from the star of the moving vertex
+	addToReadSet(original);
+	addToReadSet(prevV);
+	addToReadSet(nextV);
+
+	edges = (*original).getEdges();
+	for(auto& i : edges){
+		addToReadSet((*i).getV0());
+		addToReadSet((*i).getV1());
+	}
+}
+
+
+/*
+	O ~ T ~ H ~ E ~ R ~ S
+*/
+
+/*
+	The function check() checks the translation for an orientation change and simplicity
+	in the same way as it is done before executing a translation.
+
+	@return 	True if the translation passes both checks, otherwise false
+
+	Note:
+		- The checks for polygons with holes are not supported, as the kinetic
+			translation solves some of these cases by splits
+		- The result stays valid as long as none of the vertices of the read set
+			changes its version
+*/
+bool TranslationCheck::check(){
+	if(checkOrientation())
+		return false;
+
+	return checkSimplicityOfTranslation();
+}
+
+/*
+	The function execute() must not be called for this kind of translation.
+
+	@return 	Always REJECTED
+*/
+enum Executed TranslationCheck::execute(){
+	fprintf(stderr, "TranslationCheck: a translation which is just used for checking can not be executed\n");
+	return Executed::REJECTED;
+}
+
+
+/*
+	D ~ E ~ S ~ T ~ R ~ U ~ C ~ T ~ O ~ R
+*/
+
+/*
+	Destructor:
+	Deletes all construction vertices and edges.
+*/
+TranslationCheck::~TranslationCheck(){
+	delete prevNewE;
+	delete nextNewE;
+
+	delete oldV;
+	delete newV;
+	delete prevCopy;
+	delete nextCopy;
+}
@@ -17,6 +17,16 @@
 
 #include "translationKinetic.h"
 
+/*
+	S ~ T ~ A ~ T ~ I ~ C 	V ~ A ~ R ~ I ~ A ~ B ~ L ~ E ~ S
+*/
+
+/*
+	The log of the flips of each thread
+*/
+thread_local std::vector<TEdge*> TranslationKinetic::flipLog;
+
+
 /*
 	P ~ R ~ I ~ V ~ A ~ T ~ E 	M ~ E ~ M ~ B ~ E ~ R 	F ~ U ~ N ~ C ~ T ~ I ~ O ~ N ~ S
 */
@@ -38,7 +48,7 @@
 		must be split.
 */
 TranslationKinetic::TranslationKinetic(Triangulation *Tr, Vertex *v, double dX, double dY, TranslationType tp) : 
-	Translation(Tr, v, dX, dY), split(false), type(tp), actualTime(0){
+	Translation(Tr, v, dX, dY), split(false), type(tp), flipBase(flipLog.size()), actualTime(0){
 
 	transPath = new TEdge(oldV, newV);
 
@@ -227,6 +237,7 @@ enum Executed TranslationKinetic::executeSplitRetainSide() const{
 	if(intersectionPoint == NULL)
 		intersectionPoint = getIntersectionPoint(nextOldE, prevNewE);
 	if(intersectionPoint == NULL){
+		setRejection(Rejection::NUMERICAL);
 		return Executed::REJECTED;
 	}
 
@@ -325,9 +336,9 @@ enum Executed TranslationKinetic::executeSplitChangeSide(){
 }
 
 /*
-	The function flip() executes one event by removing the longest edge of the collapsing
-	triangle and inserting the other diagonal of the resulting quadrilateral. It errors
-	with exit code 3 if the longest edge is a polygon edge. If the flip is no singleFlip
+	The function flip() executes one event by replacing the longest edge of the collapsing
+	triangle in place by the other diagonal of the quadrilateral formed by its triangles.
+	It errors with exit code 3 if the longest edge is a polygon edge. If the flip is no singleFlip
 	it also computes whether the the two resulting triangles will also collapse during the
 	further translation and in case insert them into the event queue and check its stability.
 	This computation is outsourced to the functions insertAfterOppositeFlip() and
@@ -348,7 +359,7 @@ enum Executed TranslationKinetic::executeSplitChangeSide(){
 		- For more information on the method of deciding take a look into my Master Thesis
 */
 bool TranslationKinetic::flip(Triangle *t0, const bool singleFlip){
-	TEdge *e, *e1, *e2;
+	TEdge *e;
 	Triangle *t1;
 	Vertex *vj0, *vj1; // Joint vertices
 	Vertex *vn0, *vn1; // Non-joint vertices
@@ -359,7 +370,6 @@ bool TranslationKinetic::flip(Triangle *t0, const bool singleFlip){
 	// Indicates whether a new triangle has been inserted into the event queue
 	bool insertion = false; 
 	Vertex *common, *opposite;
-	bool internal;
 
 	if(!singleFlip)
 		// Move vertex to event time
@@ -390,36 +400,19 @@ bool TranslationKinetic::flip(Triangle *t0, const bool singleFlip){
 	vn0 = (*t0).getOtherVertex(e);
 	vn1 = (*t1).getOtherVertex(e);
 
-	// Find out whether the triangles are internal or external
-	// As e is not allowed to be a polygon edge, both triangles must
-	// be at the same side of the polygon
-	internal = (*t0).isInternal();
-
-	// This automatically also deletes the two triangles
-	delete e;
-
-	// New triangle vn0, vn1, vj0
-	e = new TEdge(vn0, vn1);
-	(*T).addEdge(e, 0);
+	// Flip the edge in place, afterwards t0 is the triangle vn0, vn1, vj0 and t1 is the
+	// triangle vn0, vn1, vj1
+	// As e is not allowed to be a polygon edge, both triangles stay at the same side of
+	// the polygon
+	(*e).flip(t0);
 
-	e1 = (*vj0).getEdgeTo(vn0);
-	e2 = (*vj0).getEdgeTo(vn1);
-
-	t0 = new Triangle(e, e1, e2, vn0, vn1, vj0, internal);
-
-	// New triangle vn0, vn1, vj1
-	(*T).addEdge(e, 0);
-
-	e1 = (*vj1).getEdgeTo(vn0);
-	e2 = (*vj1).getEdgeTo(vn1);
-
-	t1 = new Triangle(e, e1, e2, vn0, vn1, vj1, internal);
+	Statistics::flips++;
 
 	if(!singleFlip){
 		
-		// Add the flip to the flip stack
+		// Add the flip to the flip log
 		if(Settings::localChecking)
-			FlipStack.push(new Flip(vj0, vj1, vn0, vn1));
+			flipLog.push_back(e);
 
 		// Reset coordinates temporarily to original position for the calculation of the event time
 		x = (*original).getX();
@@ -693,13 +686,8 @@ bool TranslationKinetic::insertAfterNonOppositeFlip(Triangle *t, Vertex * shared
 	@return 	True if the translation has been undone, otherwise false
 */
 bool TranslationKinetic::undo(){
-	struct Flip *f;
 	bool ok;
-	Vertex *oldD0, *oldD1;
-	Vertex *newD0, *newD1;
 	TEdge *e;
-	Triangle *t;
-	bool internal;
 
 	if(!Settings::localChecking)
 		return false;
@@ -711,35 +699,13 @@ bool TranslationKinetic::undo(){
 		if(Settings::feedback == FeedbackMode::VERBOSE)
 			fprintf(stderr, "Surrounding polygon check after abortion failed...");
 
-		// Undo all flips
-		while(!FlipStack.empty()){
-			
-			f = FlipStack.top();
-			FlipStack.pop();
-
-			oldD0 = f -> oldDV0;
-			oldD1 = f -> oldDV1;
-			newD0 = f -> newDV0;
-			newD1 = f -> newDV1;
-
-			// Get the new edge to delete it
-			e = (*newD0).getEdgeTo(newD1);
-
-			// Find out whether the triangle are internal or external
-			t = (*e).getT0();
-			internal = (*t).isInternal();
+		// Undo all flips of this translation, flipping an edge again restores the old edge
+		// as the later flips have already been undone
+		while(flipLog.size() > flipBase){
+			e = flipLog.back();
+			flipLog.pop_back();
 
-			delete e;
-
-			// Recreate the old edge
-			e = new TEdge(oldD0, oldD1);
-			(*T).addEdge(e, 0);
-
-			// And the old triangles
-			new Triangle(e, (*oldD0).getEdgeTo(newD0), (*oldD1).getEdgeTo(newD0), oldD0, oldD1, newD0, internal);
-			new Triangle(e, (*oldD0).getEdgeTo(newD1), (*oldD1).getEdgeTo(newD1), oldD0, oldD1, newD1, internal);
-
-			delete f;
+			(*e).flip((*e).getT0());
 		}
 
 		// Reset the vertex to the start position
@@ -773,7 +739,8 @@ bool TranslationKinetic::undo(){
 		Translations of other types can just be generated by the translation class itself.
 */
 TranslationKinetic::TranslationKinetic(Triangulation *Tr, int i, double dX, double dY) :
-	Translation(Tr, i, dX, dY), split(false), type(TranslationType::DEFAULT), actualTime(0){
+	Translation(Tr, i, dX, dY), split(false), type(TranslationType::DEFAULT),
+	flipBase(flipLog.size()), actualTime(0){
 
 	transPath = new TEdge(oldV, newV);
 
@@ -795,7 +762,8 @@ TranslationKinetic::TranslationKinetic(Triangulation *Tr, int i, double dX, doub
 		Translations of other types can just be generated by the translation class itself.
 */
 TranslationKinetic::TranslationKinetic(Triangulation *Tr, Vertex *v, double dX, double dY) :
-	Translation(Tr, v, dX, dY), split(false), type(TranslationType::DEFAULT), actualTime(0){
+	Translation(Tr, v, dX, dY), split(false), type(TranslationType::DEFAULT),
+	flipBase(flipLog.size()), actualTime(0){
 
 	transPath = new TEdge(oldV, newV);
 
@@ -831,6 +799,7 @@ TranslationKinetic::TranslationKinetic(Triangulation *Tr, Vertex *v, double dX,
 		take a look at my Master Thesis
 */
 bool TranslationKinetic::checkOrientation(){
+	ScopedTimer timer(ProfileSection::ORIENTATION);
 	bool orientationChange;
 	Vertex *randomV;
 	unsigned int i;
@@ -861,8 +830,10 @@ bool TranslationKinetic::checkOrientation(){
 			continue;
 		}
 
-		if(inside0 || inside1)
+		if(inside0 || inside1){
+			setRejection(Rejection::ORIENTATION);
 			return true;
+		}
 	}
 
 	// Now we check whether the polygon rolls over another polygon or itself
@@ -891,8 +862,10 @@ bool TranslationKinetic::checkOrientation(){
 		delete dummy;
 
 		// This already checks whether the vertex moves onto its opposing edge
-		if(signbit(areaOld) != signbit(areaNew) || fabs(areaNew) <= Settings::epsInt)
+		if(signbit(areaOld) != signbit(areaNew) || fabs(areaNew) <= Settings::epsInt){
+			setRejection(Rejection::ORIENTATION);
 			return true;
+		}
 
 	// Default Case:
 	}else{
@@ -906,8 +879,10 @@ bool TranslationKinetic::checkOrientation(){
 
 		orientationChange = orientationChange || insideQuadrilateral(randomV);
 
-		if(orientationChange)
+		if(orientationChange){
+			setRejection(Rejection::ORIENTATION);
 			return true;
+		}
 	}
 
 	
@@ -929,8 +904,10 @@ bool TranslationKinetic::checkOrientation(){
 
 		orientationChange = insideQuadrilateral(randomV);
 
-		if(orientationChange)
+		if(orientationChange){
+			setRejection(Rejection::ORIENTATION);
 			return true;
+		}
 	}
 
 	return false;
@@ -949,6 +926,7 @@ bool TranslationKinetic::checkOrientation(){
 		For more information on the splits see my Master Thesis
 */
 enum Executed TranslationKinetic::execute(){
+	ScopedTimer timer(ProfileSection::KINETIC);
 	Triangle *t = NULL;
 	std::pair<double, Triangle*> e;
 	double oldArea, newArea;
@@ -978,8 +956,10 @@ enum Executed TranslationKinetic::execute(){
 	// Default translation
 	}else{
 
-		if(!generateInitialQueue())
+		if(!generateInitialQueue()){
+			setRejection(Rejection::UNSTABLE);
 			return Executed::REJECTED;
+		}
 
 		// Do till all events are processed
 		while((*Q).size() > 0){
@@ -990,8 +970,10 @@ enum Executed TranslationKinetic::execute(){
 			// Abort if the event queue becomes unstable
 			if(!flip(t, false)){
 				undone = undo();
-				if(undone)
+				if(undone){
+					setRejection(Rejection::UNDONE);
 					return Executed::UNDONE;
+				}
 				else
 					return Executed::PARTIAL;
 			}
@@ -1013,36 +995,37 @@ enum Executed TranslationKinetic::execute(){
 	Destructor:
 	Checks the surrounding polygon of the moved vertex and deletes all the remaining construction
 	vertices and edges. It errors with exit code 6 if the surrounding polygon check fails. It also
-	deletes the flip stack.
+	drops the flips of the translation from the flip log.
 */
 // TODO:
 // Does it still make sense to check the surrounding polygon here?
 TranslationKinetic::~TranslationKinetic(){
 	bool ok;
-	struct Flip *f;
 	std::list<Triangle*> triangles;
+	TEdge *e;
 
-	// Update the edge lengths in the SelectionTree
-	if(Settings::weightedEdgeSelection){
-		(*prevOldE).updateSTEntry();
-		(*nextOldE).updateSTEntry();
+	// Update the edge weights in the SelectionTree
+	(*prevOldE).updateSTEntry();
+	(*nextOldE).updateSTEntry();
+
+	triangles = (*original).getTriangles();
+
+	// The weights of the polygon edges opposite to original depend on the areas of their
+	// triangles, which have changed by the translation
+	for(auto& i : triangles){
+		e = (*i).getEdgeNotContaining(original);
+		if((*e).getEdgeType() == EdgeType::POLYGON)
+			(*e).updateSTEntry();
 	}
 
 	// And also the weights of the internal triangles incident to original
 	if(!Settings::holeInsertionAtStart){
-		triangles = (*original).getTriangles();
-
 		for(auto& i : triangles)
 			(*i).updateSTEntry();
 	}
 
-	// Delete the flip stack
-	while(!FlipStack.empty()){
-		f = FlipStack.top();
-		FlipStack.pop();
-
-		delete f;
-	}
+	// Drop the flips of this translation from the flip log
+	flipLog.resize(flipBase);
 
 	repairEnd();
 
@@ -1067,4 +1050,8 @@ TranslationKinetic::~TranslationKinetic(){
 	delete nextNewE;
 	delete oldV;
 	delete newV;
+
+	// The parts of split translations are included in the costs of the split translation
+	if(type == TranslationType::DEFAULT)
+		recordCosts(Engine::KINETIC);
 }
@@ -127,7 +127,7 @@ void TranslationRetriangulation::buildPolygonsSideRemainCase3(){
 	between the two adjacent vertices.
 */
 void TranslationRetriangulation::bPSCOppositeDirection(){
-	Triangle *t, *tTest, *oldTriangle;
+	Triangle *t, *oldTriangle;
 	Vertex *v;
 	TEdge *e, *oldEdge, *edgeToRemove;
 	double areaOld, areaNew;
@@ -137,17 +137,13 @@ void TranslationRetriangulation::bPSCOppositeDirection(){
 
 	// First of all we have to find the triangle in the correct direction of the
 	// surrounding polygon
-	tTest = new Triangle(prevV, oldV, nextV);
-	areaNew = (*tTest).signedArea();
-	delete tTest;
+	areaNew = Triangle::signedArea(prevV, oldV, nextV);
 
 	// We simple check one triangle and take the other one if it is not the right
 	// one
 	t = (*prevOldE).getT0();
 	v = (*t).getOtherVertex(prevOldE);
-	tTest = new Triangle(prevV, oldV, v);
-	areaOld = (*tTest).signedArea();
-	delete tTest;
+	areaOld = Triangle::signedArea(prevV, oldV, v);
 
 	// Make sure to take the triangle in the right direction
 	if(signbit(areaOld) == signbit(areaNew) || *v == *nextV)
@@ -223,7 +219,7 @@ void TranslationRetriangulation::bPSCOppositeDirection(){
 	vertex between the two adjacent vertices.
 */
 void TranslationRetriangulation::bPSRC1OppositeDirection(){
-	Triangle *t, *tTest, *oldTriangle;
+	Triangle *t, *oldTriangle;
 	Vertex *v;
 	TEdge *e, *oldEdge, *edgeToRemove;
 	double areaOld, areaNew;
@@ -233,17 +229,13 @@ void TranslationRetriangulation::bPSRC1OppositeDirection(){
 
 	// First of all we have to find the triangle in the correct direction of the
 	// surrounding polygon
-	tTest = new Triangle(prevV, oldV, newV);
-	areaNew = (*tTest).signedArea();
-	delete tTest;
+	areaNew = Triangle::signedArea(prevV, oldV, newV);
 
 	// We simple check one triangle and take the other one if it is not the right
 	// one
 	t = (*prevOldE).getT0();
 	v = (*t).getOtherVertex(prevOldE);
-	tTest = new Triangle(prevV, oldV, v);
-	areaOld = (*tTest).signedArea();
-	delete tTest;
+	areaOld = Triangle::signedArea(prevV, oldV, v);
 
 	// Make sure to take the triangle in the right direction
 	if(signbit(areaOld) == signbit(areaNew))
@@ -305,7 +297,7 @@ void TranslationRetriangulation::bPSRC1OppositeDirection(){
 	vertex between the two adjacent vertices.
 */
 void TranslationRetriangulation::bPSRC2OppositeDirection(){
-	Triangle *t, *tTest, *oldTriangle;
+	Triangle *t, *oldTriangle;
 	Vertex *v;
 	TEdge *e, *oldEdge, *edgeToRemove;
 	double areaOld, areaNew;
@@ -315,17 +307,13 @@ void TranslationRetriangulation::bPSRC2OppositeDirection(){
 
 	// First of all we have to find the triangle in the correct direction of the
 	// surrounding polygon
-	tTest = new Triangle(prevV, oldV, nextV);
-	areaNew = (*tTest).signedArea();
-	delete tTest;
+	areaNew = Triangle::signedArea(prevV, oldV, nextV);
 
 	// We simple check one triangle and take the other one if it is not the right
 	// one
 	t = (*prevOldE).getT0();
 	v = (*t).getOtherVertex(prevOldE);
-	tTest = new Triangle(prevV, oldV, v);
-	areaOld = (*tTest).signedArea();
-	delete tTest;
+	areaOld = Triangle::signedArea(prevV, oldV, v);
 
 	// Make sure to take the triangle in the right direction
 	if(signbit(areaOld) != signbit(areaNew))
@@ -395,7 +383,7 @@ void TranslationRetriangulation::bPSRC3OppositeDirection(Vertex *primaryV, Verte
 	TEdge *e = NULL, *SPEdge;
 	Vertex *v;
 	double area0, area1;
-	Triangle *t, *test;
+	Triangle *t;
 	std::list<TEdge*> edgesToRemove;
 	bool internal;
 
@@ -416,13 +404,9 @@ void TranslationRetriangulation::bPSRC3OppositeDirection(Vertex *primaryV, Verte
 		t = (*primaryE).getT0();
 		v = (*t).getOtherVertex(primaryE);
 
-		test = new Triangle(primaryV, oldV, v);
-		area0 = (*test).signedArea();
-		delete test;
+		area0 = Triangle::signedArea(primaryV, oldV, v);
 
-		test = new Triangle(primaryV, oldV, newV);
-		area1 = (*test).signedArea();
-		delete test;
+		area1 = Triangle::signedArea(primaryV, oldV, newV);
 
 		if(signbit(area0) != signbit(area1))
 			t = (*primaryE).getT1();
@@ -468,7 +452,7 @@ void TranslationRetriangulation::bPSRC3OppositeDirection(Vertex *primaryV, Verte
 */
 void TranslationRetriangulation::bPSCTranslationDirection(){
 	std::list<TEdge*> edgesToRemove;
-	Triangle *t = NULL, *test, *t1, *t2, *t3;
+	Triangle *t = NULL, *t1, *t2, *t3;
 	TEdge *e = NULL, *e1, *e2, *e3;
 	Vertex *v = NULL, *v1, *v2, *v3;
 	std::vector<TEdge*> surEdges;
@@ -502,15 +486,11 @@ void TranslationRetriangulation::bPSCTranslationDirection(){
 		leavesSP1 = false;
 	else{
 		// Check the orientation of nextV relative to prevNewE
-		test = new Triangle(prevV, newV, nextV);
-		areaOther = (*test).signedArea();
-		delete test;
+		areaOther = Triangle::signedArea(prevV, newV, nextV);
 
 		// Get the right vertex
 		v = (*e).getV0();
-		test = new Triangle(prevV, newV, v);
-		areaTest = (*test).signedArea();
-		delete test;
+		areaTest = Triangle::signedArea(prevV, newV, v);
 
 		if(signbit(areaOther) == signbit(areaTest))
 			v = (*e).getV1();
@@ -546,9 +526,7 @@ void TranslationRetriangulation::bPSCTranslationDirection(){
 			edgesToRemove.push_back(e);
 
 			v = (*t).getOtherVertex(e);
-			test = new Triangle(prevV, newV, v);
-			areaTest = (*test).signedArea();
-			delete test;
+			areaTest = Triangle::signedArea(prevV, newV, v);
 
 			if(signbit(areaTest) != signbit(areaOther)){	
 				(*p1).addVertex(v);
@@ -595,15 +573,11 @@ void TranslationRetriangulation::bPSCTranslationDirection(){
 		leavesSP2 = false;
 	else{
 		// Check the orientation of prevV relative to nextNewE
-		test = new Triangle(nextV, newV, prevV);
-		areaOther = (*test).signedArea();
-		delete test;
+		areaOther = Triangle::signedArea(nextV, newV, prevV);
 
 		// Get the right vertex
 		v = (*e).getV0();
-		test = new Triangle(nextV, newV, v);
-		areaTest = (*test).signedArea();
-		delete test;
+		areaTest = Triangle::signedArea(nextV, newV, v);
 
 		if(signbit(areaOther) == signbit(areaTest))
 			v = (*e).getV1();
@@ -639,9 +613,7 @@ void TranslationRetriangulation::bPSCTranslationDirection(){
 			}
 
 			v = (*t).getOtherVertex(e);
-			test = new Triangle(nextV, newV, v);
-			areaTest = (*test).signedArea();
-			delete test;
+			areaTest = Triangle::signedArea(nextV, newV, v);
 
 			if(signbit(areaTest) != signbit(areaOther)){
 				(*p2).addVertex(v);
@@ -890,13 +862,9 @@ void TranslationRetriangulation::bPSCTranslationDirection(){
 			new Triangle(e1, e3, (*v1).getEdgeTo(v3), v1, original, v3, internal);
 			new Triangle(e2, e3, (*v2).getEdgeTo(v3), original, v2, v3, internal);
 
-			t = new Triangle(nextV, newV, prevV);
-			areaOther = (*t).signedArea();
-			delete t;
+			areaOther = Triangle::signedArea(nextV, newV, prevV);
 
-			t = new Triangle(nextV, newV, v1);
-			areaTest = (*t).signedArea();
-			delete t;
+			areaTest = Triangle::signedArea(nextV, newV, v1);
 
 			// v1 lies at the same side of (nextV, newV) as prevV and thus,
 			// it closes p1 and v2 closes p2
@@ -1233,7 +1201,7 @@ TEdge *TranslationRetriangulation::bPSRC3SPOld(Vertex *primaryV, Vertex *seconda
 void TranslationRetriangulation::bPSRC3TranslationDirection(Vertex *primaryV, Vertex *secondaryV,
 	TEdge *borderE, TEdge *primaryE, TEdge *primaryNewE, TEdge *secondaryE, TEdge *secondaryNewE){
 	
-	Triangle *t, *test;
+	Triangle *t;
 	std::vector<TEdge*> surEdges;
 	TEdge *e = NULL, *SPEdge, *e2, *e3;
 	Vertex *v, *v2 = secondaryV, *v3; // v2/v3 is the vertex last added to p2/p3,
@@ -1317,9 +1285,7 @@ void TranslationRetriangulation::bPSRC3TranslationDirection(Vertex *primaryV, Ve
 		t = (*borderE).getT1();
 
 	// We need a reference value the check on which side of primaryNewE a vertex is
-	test = new Triangle(primaryV, newV, v2);
-	areaRef = (*test).signedArea();
-	delete test;
+	areaRef = Triangle::signedArea(primaryV, newV, v2);
 
 	e = borderE;
 	edgesToRemove.push_back(e);
@@ -1339,9 +1305,7 @@ void TranslationRetriangulation::bPSRC3TranslationDirection(Vertex *primaryV, Ve
 
 		edgesToRemove.push_back(e);
 
-		test = new Triangle(primaryV, newV, v);
-		area = (*test).signedArea();
-		delete test;
+		area = Triangle::signedArea(primaryV, newV, v);
 
 		if(signbit(areaRef) == signbit(area)){
 			(*p2).addEdge((*v2).getEdgeTo(v));
@@ -1421,13 +1385,9 @@ bool TranslationRetriangulation::checkVisibility(Vertex *v0, Vertex *v1, Vertex
 	// First we have to check whether borderV is turn by at least one pi
 	// around original relative to primaryV
 	// If it is, then its also visible after the translation
-	t = new Triangle(v1, original, refV);
-	areaRef = (*t).signedArea();
-	delete t;
+	areaRef = Triangle::signedArea(v1, original, refV);
 
-	t = new Triangle(v1, original, v0);
-	area = (*t).signedArea();
-	delete t;
+	area = Triangle::signedArea(v1, original, v0);
 
 	if(signbit(areaRef) == signbit(area)){
 		delete e;
@@ -1540,19 +1500,12 @@ bool TranslationRetriangulation::checkVisibility(Vertex *v0, Vertex *v1, Vertex
 TranslationRetriangulation::TranslationRetriangulation(Triangulation *Tr, int i, double dX, double dY) :
 	Translation(Tr, i, dX, dY), aborted(false), p0(NULL), p1(NULL), p2(NULL), p3(NULL){
 
-	Triangle *t0, *t1;
 	double areaOld, areaNew;
 
-	t0 = new Triangle(prevV, nextV, oldV);
-	t1 = new Triangle(prevV, nextV, newV);
-
-	areaOld = (*t0).signedArea();
-	areaNew = (*t1).signedArea();
+	areaOld = Triangle::signedArea(prevV, nextV, oldV);
+	areaNew = Triangle::signedArea(prevV, nextV, newV);
 
 	sideChange = signbit(areaOld) != signbit(areaNew);
-
-	delete t0;
-	delete t1;
 }
 
 /*
@@ -1571,19 +1524,12 @@ TranslationRetriangulation::TranslationRetriangulation(Triangulation *Tr, int i,
 TranslationRetriangulation::TranslationRetriangulation(Triangulation *Tr, Vertex *v, double dX, double dY) :
 	Translation(Tr, v, dX, dY), aborted(false), p0(NULL), p1(NULL), p2(NULL), p3(NULL){
 
-	Triangle *t0, *t1;
 	double areaOld, areaNew;
 
-	t0 = new Triangle(prevV, nextV, oldV);
-	t1 = new Triangle(prevV, nextV, newV);
-
-	areaOld = (*t0).signedArea();
-	areaNew = (*t1).signedArea();
+	areaOld = Triangle::signedArea(prevV, nextV, oldV);
+	areaNew = Triangle::signedArea(prevV, nextV, newV);
 
 	sideChange = signbit(areaOld) != signbit(areaNew);
-
-	delete t0;
-	delete t1;
 }
 
 
@@ -1599,6 +1545,7 @@ TranslationRetriangulation::TranslationRetriangulation(Triangulation *Tr, Vertex
 	@return 	Indicates whether the execution was aborted or fully processed
 */
 enum Executed TranslationRetriangulation::execute(){
+	ScopedTimer timer(ProfileSection::RETRIANGULATION);
 	bool newInsideOld, oldInsideNew;
 
 	// Find the polygons to retriangulate
@@ -1633,21 +1580,34 @@ enum Executed TranslationRetriangulation::execute(){
 	if(!aborted)
 		(*original).setPosition((*newV).getX(), (*newV).getY());
 
-	if(p0 != NULL)
+	if(p0 != NULL){
+		Statistics::addToHistogram(Engine::RETRIANGULATION, Distribution::POLYGONSIZE, (*p0).getSize());
+		Statistics::retriangulated = Statistics::retriangulated + (*p0).getSize();
 		(*p0).triangulate();
+	}
 
-	if(p1 != NULL)
+	if(p1 != NULL){
+		Statistics::addToHistogram(Engine::RETRIANGULATION, Distribution::POLYGONSIZE, (*p1).getSize());
+		Statistics::retriangulated = Statistics::retriangulated + (*p1).getSize();
 		(*p1).triangulate();
+	}
 
-	if(p2 != NULL)
+	if(p2 != NULL){
+		Statistics::addToHistogram(Engine::RETRIANGULATION, Distribution::POLYGONSIZE, (*p2).getSize());
+		Statistics::retriangulated = Statistics::retriangulated + (*p2).getSize();
 		(*p2).triangulate();
+	}
 
-	if(p3 != NULL)
+	if(p3 != NULL){
+		Statistics::addToHistogram(Engine::RETRIANGULATION, Distribution::POLYGONSIZE, (*p3).getSize());
+		Statistics::retriangulated = Statistics::retriangulated + (*p3).getSize();
 		(*p3).triangulate();
+	}
 
-	if(aborted)
+	if(aborted){
+		setRejection(Rejection::ABORTED);
 		return Executed::UNDONE;
-	else
+	}else
 		return Executed::FULL;
 }
 
@@ -1661,30 +1621,45 @@ enum Executed TranslationRetriangulation::execute(){
 	Checks the surrounding polygon of the moved vertex and deletes all the remaining construction
 	vertices and edges. It errors with exit code 6 if the surrounding polygon check fails. It also
 	deletes the additional entities used during the translation.
+
+	Note:
+		The check and the update of the edge weights get skipped for discarded translations,
+		as they did not change anything
 */	
 TranslationRetriangulation::~TranslationRetriangulation(){
 	bool ok;
+	std::list<Triangle*> triangles;
+	TEdge *e;
 
-	// Update the edge lengths in the SelectionTree
-	if(Settings::weightedEdgeSelection){
+	// Discarded translations have not changed anything
+	if(counted){
 		(*prevOldE).updateSTEntry();
 		(*nextOldE).updateSTEntry();
-	}
 
-	ok = (*original).checkSurroundingPolygon();
+		// The weights of the polygon edges opposite to original depend on the areas of their
+		// triangles, which have changed by the translation
+		triangles = (*original).getTriangles();
+		for(auto& i : triangles){
+			e = (*i).getEdgeNotContaining(original);
+			if((*e).getEdgeType() == EdgeType::POLYGON)
+				(*e).updateSTEntry();
+		}
+
+		ok = (*original).checkSurroundingPolygon();
 
-	if(!ok){
-		fprintf(stderr, "\nstart position:\n");
-		(*oldV).print();
-		fprintf(stderr, "original position:\n");
-		(*original).print();
-		fprintf(stderr, "target position:\n");
-		(*newV).print();
-		fprintf(stderr, "translation vector: dx = %.20f dy = %.20f \n", dx, dy);
+		if(!ok){
+			fprintf(stderr, "\nstart position:\n");
+			(*oldV).print();
+			fprintf(stderr, "original position:\n");
+			(*original).print();
+			fprintf(stderr, "target position:\n");
+			(*newV).print();
+			fprintf(stderr, "translation vector: dx = %.20f dy = %.20f \n", dx, dy);
 
-		(*T).writeTriangulation("failure.graphml");
+			(*T).writeTriangulation("failure.graphml");
 
-		exit(6);
+			exit(6);
+		}
 	}
 
 	delete prevNewE;
@@ -1696,4 +1671,6 @@ TranslationRetriangulation::~TranslationRetriangulation(){
 	if(p1 != NULL) delete p1;
 	if(p2 != NULL) delete p2;
 	if(p3 != NULL) delete p3;
+
+	recordCosts(Engine::RETRIANGULATION);
 }
@@ -24,12 +24,12 @@
 /*
 	The number of already generated triangles
 */
-unsigned long long Triangle::n = 0;
+std::atomic<unsigned long long> Triangle::n(0);
 
 /*
 	Number of triangles existing at the moment
 */
-unsigned long long Triangle::existing = 0; 
+std::atomic<unsigned long long> Triangle::existing(0); 
 
 
 /*
@@ -43,22 +43,25 @@ unsigned long long Triangle::existing = 0;
 	trustworthy, whereas the exact value might still have numerical errors. Also 0 is
 	trustworthy.
 
+	@param 	V0 	The first vertex of the triangle
+	@param 	V1 	The second vertex of the triangle
+	@param 	V2 	The third vertex of the triangle
 	@return 	The estimate for the signed area
 
 	Note:
 		In fact this functions computes 2 times the signed area of the triangle.
 */
-double Triangle::signedAreaExact() const{
+double Triangle::signedAreaExact(Vertex * const V0, Vertex * const V1, Vertex * const V2){
 	point p0, p1, p2;
 
-	p0.x = (*v0).getX();
-	p0.y = (*v0).getY();
+	p0.x = (*V0).getX();
+	p0.y = (*V0).getY();
 
-	p1.x = (*v1).getX();
-	p1.y = (*v1).getY();
+	p1.x = (*V1).getX();
+	p1.y = (*V1).getY();
 
-	p2.x = (*v2).getX();
-	p2.y = (*v2).getY();
+	p2.x = (*V2).getX();
+	p2.y = (*V2).getY();
 
 	return orient2d(p0, p1, p2);
 }
@@ -70,28 +73,31 @@ double Triangle::signedAreaExact() const{
 	have the same order independent of the ordering of the vertices in the triangle class. The
 	correct sign therefore is ensured by the case distinctions here.
 
+	@param 	V0 	The first vertex of the triangle
+	@param 	V1 	The second vertex of the triangle
+	@param 	V2 	The third vertex of the triangle
 	@return 	The estimate for the signed area
 
 	Note:
 		- In fact this functions computes 2 times the signed area of the triangle.
 */
-double Triangle::signedAreaDouble() const{
+double Triangle::signedAreaDouble(Vertex * const V0, Vertex * const V1, Vertex * const V2){
 
-	if(*v0 < *v1 && *v0 < *v2){
-		if(*v1 < *v2)
-			return det(v0, v1, v2);
+	if(*V0 < *V1 && *V0 < *V2){
+		if(*V1 < *V2)
+			return det(V0, V1, V2);
 		else
-			return - det(v0, v2, v1);
-	}else if(*v1 < *v0 && *v1 < *v2){
-		if(*v0 < *v2)
-			return- det(v1, v0, v2);
+			return - det(V0, V2, V1);
+	}else if(*V1 < *V0 && *V1 < *V2){
+		if(*V0 < *V2)
+			return- det(V1, V0, V2);
 		else
-			return det(v1, v2, v0);
+			return det(V1, V2, V0);
 	}else{
-		if(*v0 < *v1)
-			return det(v2, v0, v1);
+		if(*V0 < *V1)
+			return det(V2, V0, V1);
 		else
-			return - det(v2, v1, v0);
+			return - det(V2, V1, V0);
 	}
 }
 
@@ -109,7 +115,7 @@ double Triangle::signedAreaDouble() const{
 	Note:
 		This is just default floating-point arithmetic!
 */
-double Triangle::det(Vertex * const V0, Vertex * const V1, Vertex * const V2) const{
+double Triangle::det(Vertex * const V0, Vertex * const V1, Vertex * const V2){
 	double area;
 	double ax, ay, bx, by, cx, cy;
 
@@ -127,6 +133,26 @@ double Triangle::det(Vertex * const V0, Vertex * const V1, Vertex * const V2) co
 	return area;
 }
 
+/*
+	Constructor:
+	Generates a copy of the triangle t for the relayout of the triangulation. The copy is
+	built by the copies of the vertices and edges of t and takes over the ID, the flags
+	and the SelectionTree entry of t, whereas t gets removed from the SelectionTree.
+
+	@param 	t 	The triangle to be copied
+*/
+Triangle::Triangle(Triangle * const t) :
+	e0((*(*t).e0).getRelocated()), e1((*(*t).e1).getRelocated()), e2((*(*t).e2).getRelocated()),
+	v0((*(*t).v0).getRelocated()), v1((*(*t).v1).getRelocated()), v2((*(*t).v2).getRelocated()),
+	internal((*t).internal), enqueued((*t).enqueued), entry((*t).entry), id((*t).id),
+	relocated(NULL) {
+
+	if(entry != NULL)
+		(*entry).replaceObject(this);
+
+	(*t).entry = NULL;
+}
+
 
 /*
 	C ~ O ~ N ~ S ~ T ~ R ~ U ~ C ~ T ~ O ~ R ~ S
@@ -154,7 +180,7 @@ double Triangle::det(Vertex * const V0, Vertex * const V1, Vertex * const V2) co
 */
 Triangle::Triangle(TEdge *E0, TEdge *E1, TEdge *E2, Vertex *V0, Vertex *V1, Vertex *V2,
 	bool intern) : e0(E0), e1(E1), e2(E2), v0(V0), v1(V1), v2(V2), internal(intern),
-	enqueued(false), entry(NULL), id(n) {
+	enqueued(false), entry(NULL), id(n++), relocated(NULL) {
 
 	Triangle *t;
 	Triangulation *T;
@@ -185,8 +211,6 @@ Triangle::Triangle(TEdge *E0, TEdge *E1, TEdge *E2, Vertex *V0, Vertex *V1, Vert
 		(*T).addInternalTriangle(this);
 	}
 
-	n++;
-
 	existing++;
 }
 
@@ -202,18 +226,14 @@ Triangle::Triangle(TEdge *E0, TEdge *E1, TEdge *E2, Vertex *V0, Vertex *V1, Vert
 	@param 	V2 	The third vertex of the triangle
 
 	Note:
-		The order of the vertices is important to check the orientation. It is always the
-		ordering v0 -> v1 -> v2 considered.
+		- The order of the vertices is important to check the orientation. It is always the
+			ordering v0 -> v1 -> v2 considered.
+		- Test triangles are not registered at their vertices, so orientation tests do not
+			modify the triangulation at all
 */
 Triangle::Triangle(Vertex *V0, Vertex *V1, Vertex *V2) :
 	e0(NULL), e1(NULL), e2(NULL), v0(V0), v1(V1), v2(V2), internal(false), enqueued(false),
-	entry(NULL), id(n) {
-
-	(*v0).addTriangle(this);
-	(*v1).addTriangle(this);
-	(*v2).addTriangle(this);
-
-	n++;
+	entry(NULL), id(n++), relocated(NULL) {
 
 	existing++;
 }
@@ -594,6 +614,14 @@ double Triangle::getWeight() const{
 	return (double)n;
 }
 
+/*
+	@return 	The copy of the triangle generated by the running relayout, NULL if the
+				triangle has not been relocated
+*/
+Triangle *Triangle::getRelocated() const{
+	return relocated;
+}
+
 
 /*
 	S ~ E ~ T ~ T ~ E ~ R ~ S
@@ -757,10 +785,7 @@ double Triangle::calculateCollapseTime(Vertex * const moving, const double dx, c
 		In fact, it computes two times the signed area of the triangle.
 */
 double Triangle::signedArea() const{
-	if(Settings::arithmetics == Arithmetics::EXACT)
-		return signedAreaExact();
-	else
-		return signedAreaDouble();
+	return signedArea(v0, v1, v2);
 }
 
 /*
@@ -771,22 +796,14 @@ double Triangle::signedArea() const{
 */
 bool Triangle::inside(Vertex *v) const{
 	double area0, area1;
-	Triangle *t;
-
-	t = new Triangle(v0, v1, v);
-	area0 = (*t).signedArea();
-	delete t;
 
-	t = new Triangle(v1, v2, v);
-	area1 = (*t).signedArea();
-	delete t;
+	area0 = signedArea(v0, v1, v);
+	area1 = signedArea(v1, v2, v);
 
 	if(signbit(area0) != signbit(area1))
 		return false;
 
-	t = new Triangle(v2, v0, v);
-	area1 = (*t).signedArea();
-	delete t;
+	area1 = signedArea(v2, v0, v);
 
 	if(signbit(area0) != signbit(area1))
 		return false;
@@ -802,6 +819,53 @@ void Triangle::updateSTEntry() const{
 		(*entry).update();
 }
 
+/*
+	The function reassign() replaces the edges and vertices of the triangle during an
+	in-place flip of one of its edges. The triangle keeps its ID, its SelectionTree entry
+	and its internal flag, and gets dequeued as a newly generated triangle.
+
+	@param 	E0 		The first edge of the triangle
+	@param 	E1 		The second edge of the triangle
+	@param 	E2 		The third edge of the triangle
+	@param 	V0 		The first vertex of the triangle
+	@param 	V1 		The second vertex of the triangle
+	@param 	V2 		The third vertex of the triangle
+
+	Note:
+		The triangle does not register itself at its new vertices and edges, this is
+		done by TEdge::flip()
+*/
+void Triangle::reassign(TEdge *E0, TEdge *E1, TEdge *E2, Vertex *V0, Vertex *V1, Vertex *V2){
+	e0 = E0;
+	e1 = E1;
+	e2 = E2;
+
+	v0 = V0;
+	v1 = V1;
+	v2 = V2;
+
+	enqueued = false;
+}
+
+/*
+	The function relocate() places a copy of the triangle in an arena during a relayout
+	of the triangulation. The copy is built by the copies of the vertices and edges of the
+	triangle and takes over its ID, flags and SelectionTree entry.
+
+	@param 	a 	The arena of the relayout
+	@return 	The copy of the triangle
+
+	Note:
+		- All vertices and edges of the triangle must already be relocated
+		- The copy does not register itself at its vertices and edges, this is done by
+			Vertex::relocateReferences() and TEdge::relocateReferences()
+*/
+Triangle *Triangle::relocate(Arena * const a){
+	relocated = ::new((*a).allocate(sizeof(Triangle))) Triangle(this);
+
+	return relocated;
+}
+
 
 /*
 	D ~ E ~ S ~ T ~ R ~ U ~ C ~ T ~ O ~ R
@@ -813,17 +877,16 @@ void Triangle::updateSTEntry() const{
 */
 Triangle::~Triangle(){
 
-	(*v0).removeTriangle(this);
-	(*v1).removeTriangle(this);
-	(*v2).removeTriangle(this);
+	// Test triangles have no assigned edges and are not registered at their vertices
+	if(e0 != NULL){
+		(*v0).removeTriangle(this);
+		(*v1).removeTriangle(this);
+		(*v2).removeTriangle(this);
 
-	// Some test triangles may not have assigned edges
-	if(e0 != NULL)
 		(*e0).removeTriangle(this);
-	if(e0 != NULL)
 		(*e1).removeTriangle(this);
-	if(e0 != NULL)
 		(*e2).removeTriangle(this);
+	}
 
 	existing--;
 
@@ -856,25 +919,37 @@ unsigned long long Triangle::getNumberOfExistingTriangles(){
 */
 bool Triangle::insideTriangle(Vertex  *v0, Vertex *v1, Vertex *v2, Vertex *v){
 	double area0, area1;
-	Triangle *t;
-
-	t = new Triangle(v0, v1, v);
-	area0 = (*t).signedArea();
-	delete t;
 
-	t = new Triangle(v1, v2, v);
-	area1 = (*t).signedArea();
-	delete t;
+	area0 = signedArea(v0, v1, v);
+	area1 = signedArea(v1, v2, v);
 
 	if(signbit(area0) != signbit(area1))
 		return false;
 
-	t = new Triangle(v2, v0, v);
-	area1 = (*t).signedArea();
-	delete t;
+	area1 = signedArea(v2, v0, v);
 
 	if(signbit(area0) != signbit(area1))
 		return false;
 
 	return true;
 }
+
+/*
+	The function signedArea() computes an estimate of the signed area of the triangle
+	formed by the vertices V0, V1 and V2 like the member function signedArea(), but
+	without building a test triangle.
+
+	@param 	V0 	The first vertex of the triangle
+	@param 	V1 	The second vertex of the triangle
+	@param 	V2 	The third vertex of the triangle
+	@return 	The estimate for the signed area
+
+	Note:
+		In fact, it computes two times the signed area of the triangle.
+*/
+double Triangle::signedArea(Vertex * const V0, Vertex * const V1, Vertex * const V2){
+	if(Settings::arithmetics == Arithmetics::EXACT)
+		return signedAreaExact(V0, V1, V2);
+	else
+		return signedAreaDouble(V0, V1, V2);
+}
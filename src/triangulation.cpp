@@ -16,6 +16,7 @@
  */
 
 #include "triangulation.h"
+#include "statistics.h"
 
 /*
 	C ~ O ~ N ~ S ~ T ~ R ~ U ~ C ~ T ~ O ~ R ~ S
@@ -28,7 +29,7 @@
 */
 Triangulation::Triangulation() :
 	internalTriangles(NULL), Rectangle0(NULL), Rectangle1(NULL), Rectangle2(NULL),
-	Rectangle3(NULL), N(0) { 
+	Rectangle3(NULL), N(0), arena(NULL), relayoutSize(0) { 
 
 	// Calculate the total number of vertices
 	N = Settings::outerSize;
@@ -38,7 +39,7 @@ Triangulation::Triangulation() :
 	vertices.reserve(N);
 
 	// Generate outer polygon instance
-	outerPolygon = new TPolygon(this, Settings::outerSize);
+	outerPolygon = new TPolygon(this, 0, Settings::outerSize);
 
 	innerPolygons.reserve(Settings::nrInnerPolygons);
 
@@ -80,6 +81,7 @@ void Triangulation::addVertex(Vertex * const v, const unsigned int pID){
 
 	// Do not forget to register the triangulation at the vertex
 	(*v).setTriangulation(this);
+	(*v).setIndex(vertices.size() - 1);
 }
 
 /*
@@ -118,13 +120,15 @@ void Triangulation::changeVertex(const int i, const unsigned int fromP, const un
 	@param 	pID 	For polygon edges the ID of the polygon, for other edges no meaning
 */
 void Triangulation::addEdge(TEdge * const e , const unsigned int pID){
-	if(Settings::triangulationOutputRequired)
+	if(Settings::triangulationOutputRequired){
+		std::lock_guard<std::mutex> lock(edgesMutex);
 		edges.insert(std::pair<int, TEdge*>((*e).getID(), e));
+	}
 
 	// Do not forget to register the triangulation at the edge
 	(*e).setTriangulation(this);
 
-	if(Settings::weightedEdgeSelection && (*e).getEdgeType() == EdgeType::POLYGON){
+	if((*e).getEdgeType() == EdgeType::POLYGON){
 		if(pID == 0)
 			(*outerPolygon).addEdge(e);
 		else if(pID > 0 && pID <= Settings::nrInnerPolygons)
@@ -240,7 +244,9 @@ Vertex *Triangulation::getVertex(const int i) const{
 
 /*
 	@param 	pID 	The ID of the polygon of interest
-	@return 		Any edge of the polygon selected uniformly at random by its length
+	@return 		Any edge of the polygon suitable for insertions selected uniformly at
+					random, weighted by its length if weighted edge selection is enabled,
+					NULL if there is no such edge
 */
 TEdge *Triangulation::getRandomEdgeWeighted(const unsigned int pID) const{
 
@@ -286,8 +292,10 @@ void Triangulation::removeVertex(const int index){
 	@param	e 	The edge to be removed
 */
 void Triangulation::removeEdge(TEdge * const e){
-	if(Settings::triangulationOutputRequired)
+	if(Settings::triangulationOutputRequired){
+		std::lock_guard<std::mutex> lock(edgesMutex);
 		edges.erase((*e).getID());
+	}
 }
 
 
@@ -483,6 +491,33 @@ void Triangulation::writePolygonToLine(const char *filename) const {
 	};
 }
 
+/*
+	The function writePolygonToBinary() writes all polygons to a binary file which can
+	be read again by --input without loss of precision (see polygonReader.h)
+
+	@param 	filename 	The name of the binary file
+*/
+void Triangulation::writePolygonToBinary(const char *filename) const {
+	FILE *f;
+	uint32_t nrRings = 1 + innerPolygons.size();
+
+	f = fopen(filename, "wb");
+	if(f == NULL){
+		fprintf(stderr, "Opening %s failed: %s\n", filename, strerror(errno));
+		exit(13);
+	}
+
+	fwrite(polygonMagic, 1, sizeof(polygonMagic), f);
+	fwrite(&nrRings, sizeof(nrRings), 1, f);
+
+	outerPolygon->writeToBinary(f);
+	for(auto const& i : innerPolygons){
+		i->writeToBinary(f);
+	};
+
+	fclose(f);
+}
+
 
 /*
 	O ~ T ~ H ~ E ~ R ~ S
@@ -500,6 +535,7 @@ void Triangulation::writePolygonToLine(const char *filename) const {
 	@return 	true if everything is alright, otherwise false
 */
 bool Triangulation::check() const{
+	ScopedTimer timer(ProfileSection::GLOBALCHECK);
 	EdgeType type;
 	int n;
 	TEdge *e;
@@ -549,6 +585,14 @@ bool Triangulation::check() const{
 		if(!part){
 			fprintf(stderr, "Triangulation error: vertex %llu is outside of its surrounding polygon\n", (*i).getID());
 		}
+
+		// Check whether the weight of the next polygon edge in the SelectionTree is up to date
+		e = (*i).getToNext();
+		if(e != NULL && (*e).getSTEntry() != NULL && !(*(*e).getSTEntry()).isUpToDate()){
+			fprintf(stderr, "Triangulation error: edge %llu has an outdated weight in the SelectionTree\n",
+				(*e).getID());
+			ok = false;
+		}
 	}
 
 	// Check the simplicity of the polygon
@@ -673,3 +717,129 @@ void Triangulation::checkSimplicity() const{
 		toCheck = (*v).getToNext();
 	}
 }
+
+/*
+	The function relayout() moves all vertices, edges and triangles of the triangulation
+	into a new arena, such that entities close to each other in the plane are close to
+	each other in memory. The vertices get placed in the order of their positions along
+	a Hilbert curve through the bounding box, each one followed by its edges and triangles
+	whose other vertices have already been placed. All pointers to the entities, i.e. the
+	ones of the entities themselves, of the vertex vectors and of the SelectionTrees, get
+	updated and the previous arena gets freed.
+
+	Note:
+		- The IDs of the entities and the indices of the vertices do not change, so the
+			relayout does not change the generated polygon
+		- Must not be called while any translation or insertion is in progress
+*/
+void Triangulation::relayout(){
+	std::vector<std::pair<unsigned long long, Vertex*>> order;
+	std::vector<TEdge*> es;
+	std::vector<Triangle*> ts;
+	unsigned long long nrTriangles = 0;
+	double minX, minY, maxX, maxY, size;
+	double startTime = (*Settings::timer).elapsedTime();
+	Arena *newArena;
+
+	// The bounding box contains all vertices
+	minX = maxX = (*Rectangle0).getX();
+	minY = maxY = (*Rectangle0).getY();
+	for(auto const& i : {Rectangle1, Rectangle2, Rectangle3}){
+		minX = std::min(minX, (*i).getX());
+		maxX = std::max(maxX, (*i).getX());
+		minY = std::min(minY, (*i).getY());
+		maxY = std::max(maxY, (*i).getY());
+	}
+	size = std::max(maxX - minX, maxY - minY);
+
+	// Sort the vertices along a Hilbert curve, vertices in the same cell keep the order of
+	// their IDs
+	order.reserve(vertices.size() + 4);
+	for(auto const& i : {Rectangle0, Rectangle1, Rectangle2, Rectangle3})
+		order.push_back(std::make_pair((*i).getHilbertIndex(minX, minY, size), i));
+	for(auto const& i : vertices){
+		if(i != NULL)
+			order.push_back(std::make_pair((*i).getHilbertIndex(minX, minY, size), i));
+	}
+
+	std::sort(order.begin(), order.end(),
+		[](std::pair<unsigned long long, Vertex*> const &a, std::pair<unsigned long long, Vertex*> const &b){
+			if(a.first != b.first)
+				return a.first < b.first;
+			return (*a.second).getID() < (*b.second).getID();
+		});
+
+	// Each triangle is counted at its three vertices, the number of edges follows from
+	// Euler's formula
+	for(auto const& i : order)
+		nrTriangles = nrTriangles + (*i.second).getNumberOfTriangles();
+	nrTriangles = nrTriangles / 3;
+
+	es.reserve(order.size() + nrTriangles - 1);
+	ts.reserve(nrTriangles);
+
+	newArena = new Arena(order.size() * Arena::getAlignedSize(sizeof(Vertex)) +
+		(order.size() + nrTriangles - 1) * Arena::getAlignedSize(sizeof(TEdge)) +
+		nrTriangles * Arena::getAlignedSize(sizeof(Triangle)));
+
+	// Place each vertex followed by its edges and triangles which are complete then
+	for(auto const& i : order)
+		(*i.second).relocate(newArena, es, ts);
+
+	// Link the copies among each other
+	for(auto const& i : es)
+		(*i).relocateReferences();
+	for(auto const& i : order)
+		(*i.second).relocateReferences();
+
+	// Update the references of the triangulation and the polygons
+	for(auto& i : vertices){
+		if(i != NULL)
+			i = (*i).getRelocated();
+	}
+	Rectangle0 = (*Rectangle0).getRelocated();
+	Rectangle1 = (*Rectangle1).getRelocated();
+	Rectangle2 = (*Rectangle2).getRelocated();
+	Rectangle3 = (*Rectangle3).getRelocated();
+
+	for(auto& i : edges)
+		i.second = (*i.second).getRelocated();
+
+	(*outerPolygon).relocateVertices();
+	for(auto const& i : innerPolygons)
+		(*i).relocateVertices();
+
+	// The original edges and triangles are not referenced by anything else anymore, so they
+	// get freed without their destructors, which would just unlink them from each other
+	for(auto const& i : ts)
+		Triangle::operator delete(i, sizeof(Triangle));
+	for(auto const& i : es)
+		TEdge::operator delete(i, sizeof(TEdge));
+	for(auto const& i : order)
+		delete i.second;
+
+	if(arena != NULL)
+		delete arena;
+	arena = newArena;
+	(*arena).activate();
+
+	relayoutSize = getActualNumberOfVertices();
+
+	Statistics::relayouts++;
+	Statistics::relayoutTime += (*Settings::timer).elapsedTime() - startTime;
+}
+
+/*
+	The function relayoutIfGrown() calls relayout() if the relayout is enabled and the
+	number of polygon vertices has at least doubled since the last relayout.
+
+	Note:
+		Triangulations with less than minRelayoutSize vertices do not get relayouted, as
+		they fit into the caches anyway
+*/
+void Triangulation::relayoutIfGrown(){
+	int n = getActualNumberOfVertices();
+
+	if(Settings::relayout && n >= minRelayoutSize && n >= 2 * relayoutSize)
+		relayout();
+}
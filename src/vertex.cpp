@@ -24,12 +24,12 @@
 /*
 	The number of already generated vertices
 */
-unsigned long long Vertex::n = 0;
+std::atomic<unsigned long long> Vertex::n(0);
 
 /*
 	The number of deleted vertices
 */
-unsigned long long Vertex::deleted = 0;
+std::atomic<unsigned long long> Vertex::deleted(0);
 
 
 /*
@@ -62,6 +62,132 @@ void Vertex::getEnvironment(std::map<const unsigned long long, const TEdge*> &es
 	
 }
 
+/*
+	The function getRays() returns the two other vertices of a triangle incident to the
+	vertex in counter-clockwise order as seen from the vertex.
+
+	@param 	t 	The triangle of interest
+	@param 	a 	The other vertex of the first edge of t incident to the vertex
+	@param 	b 	The other vertex of the second edge of t incident to the vertex
+*/
+void Vertex::getRays(Triangle const * const t, Vertex *&a, Vertex *&b) const{
+	Vertex *v;
+	int i;
+
+	a = NULL;
+	b = NULL;
+	for(i = 0; i < 3; i++){
+		v = (*t).getVertex(i);
+		if(v == this)
+			continue;
+
+		if(a == NULL)
+			a = v;
+		else
+			b = v;
+	}
+
+	// Swap the vertices if b is not counter-clockwise of a
+	if(crossProduct2D((*a).x - x, (*a).y - y, (*b).x - x, (*b).y - y) < 0){
+		v = a;
+		a = b;
+		b = v;
+	}
+}
+
+/*
+	The function isInWedge() checks whether a direction lies between the two edges of a
+	triangle incident to the vertex.
+
+	@param 	t 	The triangle of interest
+	@param 	dx 	The x-component of the direction
+	@param 	dy 	The y-component of the direction
+	@return 	True if the direction lies inside the triangle or on one of its edges,
+				otherwise false
+*/
+bool Vertex::isInWedge(Triangle const * const t, const double dx, const double dy) const{
+	Vertex *a, *b;
+
+	getRays(t, a, b);
+
+	return crossProduct2D((*a).x - x, (*a).y - y, dx, dy) >= 0 &&
+		crossProduct2D(dx, dy, (*b).x - x, (*b).y - y) >= 0;
+}
+
+/*
+	The function sortStar() rebuilds the star of the vertex from its triangles list by
+	sorting the triangles by the pseudo-angles of their first edges.
+*/
+void Vertex::sortStar() const{
+	double key;
+	Vertex *a, *b;
+	int n = 0, j;
+
+	star.resize(triangles.size());
+	starRays.resize(triangles.size());
+
+	// Insertion sort, as stars are small
+	for(auto const& i : triangles){
+		getRays(i, a, b);
+		key = getPseudoAngle((*a).x - x, (*a).y - y);
+
+		for(j = n; j > 0 && getPseudoAngle((*starRays[j - 1]).x - x, (*starRays[j - 1]).y - y) > key; j--){
+			star[j] = star[j - 1];
+			starRays[j] = starRays[j - 1];
+		}
+		star[j] = i;
+		starRays[j] = a;
+		n++;
+	}
+}
+
+/*
+	The function getPseudoAngle() computes a pseudo-angle of a direction, i.e. a value
+	which is monotone in the angle of the direction to the positive x-axis, but needs no
+	trigonometric function.
+
+	@param 	dx 	The x-component of the direction
+	@param 	dy 	The y-component of the direction
+	@return 	The pseudo-angle in the range [0, 4)
+*/
+double Vertex::getPseudoAngle(const double dx, const double dy){
+	double s = fabs(dx) + fabs(dy);
+
+	if(s == 0)
+		return 0;
+
+	if(dy >= 0){
+		if(dx >= 0)
+			return dy / s;
+		else
+			return 1 - dx / s;
+	}else{
+		if(dx <= 0)
+			return 2 - dy / s;
+		else
+			return 3 + dx / s;
+	}
+}
+
+/*
+	Constructor:
+	Generates a copy of the vertex v for the relayout of the triangulation. The copy
+	takes over the ID, the position and the assignments to the triangulation and the
+	polygon of v, whereas v gets unregistered from the triangulation.
+
+	@param 	v 	The vertex to be copied
+*/
+Vertex::Vertex(Vertex * const v) :
+	T((*v).T), P((*v).P), x((*v).x), y((*v).y), toPrev(NULL), toNext(NULL),
+	rectangleVertex((*v).rectangleVertex), id((*v).id), region((*v).region), index((*v).index),
+	version((*v).version), starState(StarState::STALE), relocated(NULL) {
+
+	(*v).T = NULL;
+
+	// The deletion of the original vertex does not reduce the number of vertices
+	deleted--;
+}
+
 
 /*
 	C ~ O ~ N ~ S ~ T ~ R ~ U ~ C ~ T ~ O ~ R ~ S
@@ -76,10 +202,8 @@ void Vertex::getEnvironment(std::map<const unsigned long long, const TEdge*> &es
 	@param 	Y 	The y coordinate of the vertex
 */
 Vertex::Vertex(const double X, const double Y) :
-	T(NULL), P(NULL), x(X), y(Y), toPrev(NULL), toNext(NULL), rectangleVertex(false), id(n) {
-
-	n++;
-}
+	T(NULL), P(NULL), x(X), y(Y), toPrev(NULL), toNext(NULL), rectangleVertex(false), id(n++),
+	region(-1), index(-1), version(0), starState(StarState::STALE), relocated(NULL) {}
 
 /*
 	Constructor:
@@ -91,10 +215,8 @@ Vertex::Vertex(const double X, const double Y) :
 	@param 	RV 	Determines whether the new vertex is part of the bounding box
 */
 Vertex::Vertex(const double X, const double Y, const bool RV) :
-	T(NULL), P(NULL), x(X), y(Y), toPrev(NULL), toNext(NULL), rectangleVertex(RV), id(n) {
-
-	n++;
-}
+	T(NULL), P(NULL), x(X), y(Y), toPrev(NULL), toNext(NULL), rectangleVertex(RV), id(n++),
+	region(-1), index(-1), version(0), starState(StarState::STALE), relocated(NULL) {}
 
 /*
 	The function getTranslated() is an implicit constructor which generates a new vertex
@@ -138,6 +260,7 @@ void Vertex::setPolygon(TPolygon *p){
 void Vertex::setPosition(const double X, const double Y){
 	x = X;
 	y = Y;
+	version++;
 }
 
 /*
@@ -166,6 +289,8 @@ void Vertex::addEdge(TEdge * const e){
 */
 void Vertex::addTriangle(Triangle * const t){
 	triangles.push_back(t);
+	version++;
+	starState.store(StarState::STALE, std::memory_order_relaxed);
 }
 
 /*
@@ -179,6 +304,7 @@ void Vertex::addTriangle(Triangle * const t){
 */
 void Vertex::setToPrev(TEdge * const e){
 	toPrev = e;
+	version++;
 }
 
 /*
@@ -192,6 +318,21 @@ void Vertex::setToPrev(TEdge * const e){
 */
 void Vertex::setToNext(TEdge * const e){
 	toNext = e;
+	version++;
+}
+
+/*
+	@param 	r 	The region of the triangulation the vertex is assigned to
+*/
+void Vertex::setRegion(const int r){
+	region = r;
+}
+
+/*
+	@param 	i 	The index of the vertex in the vertices vector of the triangulation
+*/
+void Vertex::setIndex(const int i){
+	index = i;
 }
 
 
@@ -294,6 +435,30 @@ bool Vertex::isRectangleVertex() const{
 	return rectangleVertex;
 }
 
+/*
+	@return 	The region of the triangulation the vertex is assigned to (-1 if it is
+				not assigned to any region)
+*/
+int Vertex::getRegion() const{
+	return region;
+}
+
+/*
+	@return 	The index of the vertex in the vertices vector of the triangulation (-1 if
+				it is not part of it)
+*/
+int Vertex::getIndex() const{
+	return index;
+}
+
+/*
+	@return 	The version of the vertex, which changes whenever the vertex gets moved or
+				its star in the triangulation or its polygon edges change
+*/
+unsigned long long Vertex::getVersion() const{
+	return version;
+}
+
 /*
 	The function getMediumEdgeLength() computes the mean of the lengths of all
 	incident edges to the vertex. This can be used as estimate for appropriate 
@@ -329,16 +494,15 @@ double Vertex::getMediumEdgeLength() const{
 		expensive to compute
 */
 double Vertex::getDirectedEdgeLength(const double alpha) const{
-	double length;
+	Triangle *t;
+	Vertex *a, *b;
 
-	for(auto const& i : triangles){
-		// The function getRange() checks whether the triangle is in direction
-		// alpha and returns the range if true, otherwise it returns -1
-		length = (*i).getRange(this, alpha);
+	t = getTriangleInDirection(cos(alpha), sin(alpha));
 
-		if(length > 0){
-			return length;
-		}
+	if(t != NULL){
+		getRays(t, a, b);
+		return ((*(*t).getEdgeContaining(this, a)).length() +
+			(*(*t).getEdgeContaining(this, b)).length()) / 2;
 	}
 	
 	if(Settings::feedback == FeedbackMode::VERBOSE)
@@ -347,6 +511,152 @@ double Vertex::getDirectedEdgeLength(const double alpha) const{
 	return - getMediumEdgeLength();
 }
 
+/*
+	The function getFreeDistance() casts a ray from the vertex in direction alpha through the
+	triangulation and returns the distance to the first polygon or frame edge it hits. It
+	walks the triangles along the ray in the same way checkEdge() of the translations does.
+	A vertex lying exactly on the ray stops the walk, too.
+
+	@param 	alpha 	Direction of the ray (alpha = 0 corresponds to the positive x-direction)
+	@return 		The distance the vertex can move in direction alpha without crossing a
+					polygon edge, 0 if the walk could not be started
+
+	Note:
+		This bounds just the path of the vertex itself, its new polygon edges still can
+		sweep over other vertices
+*/
+double Vertex::getFreeDistance(const double alpha) const{
+	double dx = cos(alpha), dy = sin(alpha);
+	double ax, ay, bx, by, sideA, sideB, sideW, denom, s;
+	Triangle *t = NULL;
+	TEdge *e;
+	Vertex *a, *b, *w;
+
+	// Find the triangle in direction alpha
+	t = getTriangleInDirection(dx, dy);
+
+	if(t == NULL)
+		return 0;
+
+	e = (*t).getEdgeNotContaining(this);
+
+	while(true){
+		a = (*e).getV0();
+		b = (*e).getV1();
+		ax = (*a).getX() - x;
+		ay = (*a).getY() - y;
+		bx = (*b).getX() - x;
+		by = (*b).getY() - y;
+
+		// The sides of the ray the vertices of the edge lie on
+		sideA = dx * ay - dy * ax;
+		sideB = dx * by - dy * bx;
+
+		// The ray hits a vertex of the edge
+		if(sideA == 0)
+			return ax * dx + ay * dy;
+		if(sideB == 0)
+			return bx * dx + by * dy;
+
+		// The ray hits a polygon or frame edge
+		if((*e).getEdgeType() != EdgeType::TRIANGULATION)
+			break;
+
+		// Continue in the next triangle, the ray leaves it through the edge between the
+		// third vertex and the vertex of e on the other side of the ray
+		t = (*e).getOtherTriangle(t);
+		w = (*t).getOtherVertex(e);
+		sideW = dx * ((*w).getY() - y) - dy * ((*w).getX() - x);
+
+		if(sideW == 0)
+			return ((*w).getX() - x) * dx + ((*w).getY() - y) * dy;
+
+		if(signbit(sideW) == signbit(sideA))
+			e = (*t).getEdgeContaining(w, b);
+		else
+			e = (*t).getEdgeContaining(w, a);
+	}
+
+	// Intersect the ray with the supporting line of the edge
+	denom = dx * (by - ay) - dy * (bx - ax);
+	if(denom == 0)
+		return 0;
+
+	s = (ax * (by - ay) - ay * (bx - ax)) / denom;
+
+	return s > 0 ? s : 0;
+}
+
+/*
+	The function getTriangleInDirection() finds the triangle incident to the vertex
+	which contains the direction (dx, dy). It does a binary search in the angularly
+	sorted star of the vertex and scans the triangles list if the star is being built by
+	another thread or the result of the search can not be verified.
+
+	@param 	dx 	The x-component of the direction
+	@param 	dy 	The y-component of the direction
+	@return 	The triangle in direction (dx, dy), NULL if there is none
+
+	Note:
+		- The search uses pseudo-angles and orientation tests, so it needs no
+			trigonometric function
+		- The vertices of the bounding box always scan their triangles, as their star
+			does not surround them
+*/
+Triangle *Vertex::getTriangleInDirection(const double dx, const double dy) const{
+	StarState expected = StarState::STALE;
+	double rx, ry, ax, ay, p;
+	int low, high, mid;
+
+	if(!rectangleVertex && !triangles.empty()){
+		// Rebuild the star if it is outdated and no other thread is doing it
+		if(starState.load(std::memory_order_acquire) == StarState::STALE &&
+			starState.compare_exchange_strong(expected, StarState::BUILDING)){
+			sortStar();
+			starState.store(StarState::SORTED, std::memory_order_release);
+		}
+
+		if(starState.load(std::memory_order_acquire) == StarState::SORTED){
+			// The pseudo-angles relative to the first edge of the star increase along
+			// the star
+			rx = (*starRays[0]).x - x;
+			ry = (*starRays[0]).y - y;
+			p = getPseudoAngle(rx * dx + ry * dy, crossProduct2D(rx, ry, dx, dy));
+
+			// Search the last edge which is not counter-clockwise of the direction
+			low = 0;
+			high = star.size() - 1;
+			while(low < high){
+				mid = (low + high + 1) / 2;
+				ax = (*starRays[mid]).x - x;
+				ay = (*starRays[mid]).y - y;
+
+				if(getPseudoAngle(rx * ax + ry * ay, crossProduct2D(rx, ry, ax, ay)) <= p)
+					low = mid;
+				else
+					high = mid - 1;
+			}
+
+			if(isInWedge(star[low], dx, dy))
+				return star[low];
+		}
+	}
+
+	for(auto const& i : triangles){
+		if(isInWedge(i, dx, dy))
+			return i;
+	}
+
+	return NULL;
+}
+
+/*
+	@return 	The number of triangles incident to the vertex
+*/
+unsigned int Vertex::getNumberOfTriangles() const{
+	return triangles.size();
+}
+
 /*
 	@return 	The edge to the predecessor of the vertex in the polygon
 */
@@ -505,6 +815,65 @@ double Vertex::getNormalDirectionOutside() const{
 	return normalAngle;
 }
 
+/*
+	The function getHilbertIndex() computes the position of the vertex along a Hilbert
+	curve of order 16 filling a square. Vertices close to each other along the curve are
+	close to each other in the plane.
+
+	@param 	minX 	The x-coordinate of the lower left corner of the square
+	@param 	minY 	The y-coordinate of the lower left corner of the square
+	@param 	size 	The side length of the square
+	@return 		The index of the cell of the vertex along the curve
+
+	Note:
+		Vertices outside of the square are treated as lying on its boundary
+*/
+unsigned long long Vertex::getHilbertIndex(const double minX, const double minY,
+	const double size) const{
+
+	const unsigned long long side = 1ULL << 16;
+	unsigned long long hx, hy, rx, ry, s, swap;
+	unsigned long long index = 0;
+	double fx, fy;
+
+	// Get the cell of the vertex
+	fx = (x - minX) / size;
+	fy = (y - minY) / size;
+	fx = fx < 0 ? 0 : (fx > 1 ? 1 : fx);
+	fy = fy < 0 ? 0 : (fy > 1 ? 1 : fy);
+	hx = (unsigned long long)(fx * (side - 1));
+	hy = (unsigned long long)(fy * (side - 1));
+
+	// Descend the quadrants from the coarsest to the finest one
+	for(s = side / 2; s > 0; s = s / 2){
+		rx = (hx & s) > 0;
+		ry = (hy & s) > 0;
+		index = index + s * s * ((3 * rx) ^ ry);
+
+		// Rotate the quadrant such that the curve inside of it has the standard orientation
+		if(ry == 0){
+			if(rx == 1){
+				hx = side - 1 - hx;
+				hy = side - 1 - hy;
+			}
+
+			swap = hx;
+			hx = hy;
+			hy = swap;
+		}
+	}
+
+	return index;
+}
+
+/*
+	@return 	The copy of the vertex generated by the running relayout, NULL if the
+				vertex has not been relocated
+*/
+Vertex *Vertex::getRelocated() const{
+	return relocated;
+}
+
 
 /*
 	R ~ E ~ M ~ O ~ V ~ E ~ R
@@ -522,6 +891,8 @@ void Vertex::removeEdge(TEdge * const e){
 */
 void Vertex::removeTriangle(Triangle * const t){
 	triangles.remove(t);
+	version++;
+	starState.store(StarState::STALE, std::memory_order_relaxed);
 }
 
 
@@ -692,7 +1063,8 @@ void Vertex::writeSurroundingTriangulation(const char *filename) const{
 	vertices to stdout.
 */
 void Vertex::printStats(){
-	fprintf(stderr, "created: %llu deleted: %llu still existing: %llu \n", n, deleted, n - deleted);
+	fprintf(stderr, "created: %llu deleted: %llu still existing: %llu \n", n.load(), deleted.load(),
+		n.load() - deleted.load());
 }
 
 
@@ -871,6 +1243,65 @@ double Vertex::getDistanceToOrigin() const{
 	return sqrt(x * x + y * y);
 }
 
+/*
+	The function relocate() places a copy of the vertex in an arena during a relayout of
+	the triangulation. Edges of the vertex whose other vertex already has been relocated
+	and triangles of the vertex whose other vertices already have been relocated get
+	relocated right after it.
+
+	@param 	a 	The arena of the relayout
+	@param 	es 	The vector the relocated edges get added to
+	@param 	ts 	The vector the relocated triangles get added to
+	@return 	The copy of the vertex
+
+	Note:
+		- The copy takes over the ID, the position and the assignments to the
+			triangulation and the polygon, the vertex itself gets unregistered from the
+			triangulation
+		- The lists of the copy get set by relocateReferences() as soon as all vertices
+			are relocated
+*/
+Vertex *Vertex::relocate(Arena * const a, std::vector<TEdge*> &es, std::vector<Triangle*> &ts){
+	relocated = ::new((*a).allocate(sizeof(Vertex))) Vertex(this);
+
+	for(auto const& i : edges){
+		if((*(*i).getOtherVertex(this)).relocated != NULL){
+			(*i).relocate(a);
+			es.push_back(i);
+		}
+	}
+
+	for(auto const& i : triangles){
+		if((*(*i).getVertex(0)).relocated != NULL && (*(*i).getVertex(1)).relocated != NULL &&
+			(*(*i).getVertex(2)).relocated != NULL){
+
+			(*i).relocate(a);
+			ts.push_back(i);
+		}
+	}
+
+	return relocated;
+}
+
+/*
+	The function relocateReferences() sets the edges, the triangles and the polygon edges
+	of the copy of the vertex to the copies of its own ones. Afterwards the vertex itself
+	is not linked to any edge or triangle anymore, so it can be deleted.
+*/
+void Vertex::relocateReferences(){
+	(*relocated).toPrev = toPrev == NULL ? NULL : (*toPrev).getRelocated();
+	(*relocated).toNext = toNext == NULL ? NULL : (*toNext).getRelocated();
+
+	// The copy takes over the list nodes
+	(*relocated).edges.swap(edges);
+	for(auto& i : (*relocated).edges)
+		i = (*i).getRelocated();
+
+	(*relocated).triangles.swap(triangles);
+	for(auto& i : (*relocated).triangles)
+		i = (*i).getRelocated();
+}
+
 
 /*
 	D ~ E ~ S ~ T ~ R ~ U ~ C ~ T ~ O ~ R
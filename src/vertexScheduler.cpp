@@ -0,0 +1,208 @@
+/*
+ * Copyright 2021 Philipp Mayer - pmayer@cs.sbg.ac.at
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "vertexScheduler.h"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+#include "triangulation.h"
+#include "vertex.h"
+#include "settings.h"
+
+/*
+	P ~ R ~ I ~ V ~ A ~ T ~ E 	M ~ E ~ M ~ B ~ E ~ R 	F ~ U ~ N ~ C ~ T ~ I ~ O ~ N ~ S
+*/
+
+/*
+	The function getPhaseDispersion() computes the index of dispersion, i.e. the variance
+	divided by the mean, of the number of selections of the vertex indices in the actual
+	translation phase.
+
+	@return 	The index of dispersion of the selections, 0 if there were none
+*/
+double VertexScheduler::getPhaseDispersion() const{
+	double mean, var = 0;
+
+	if(phaseSelections == 0)
+		return 0;
+
+	mean = (double)phaseSelections / selections.size();
+
+	for(auto const& i : selections)
+		var = var + (i - mean) * (i - mean);
+	var = var / selections.size();
+
+	return var / mean;
+}
+
+
+/*
+	C ~ O ~ N ~ S ~ T ~ R ~ U ~ C ~ T ~ O ~ R ~ S
+*/
+
+/*
+	Constructor:
+
+	@param 	b 	The number of vertices of a bucket and of selections of a block
+*/
+VertexScheduler::VertexScheduler(const unsigned int b) :
+	blockSize(b), bucketStart(0), bucketSize(0), remaining(0), blocks(0), phaseSelections(0),
+	dispersionSum(0), dispersionWeight(0) {}
+
+
+/*
+	G ~ E ~ T ~ T ~ E ~ R ~ S
+*/
+
+/*
+	@return 	The number of vertices of a bucket and of selections of a block
+*/
+unsigned int VertexScheduler::getBlockSize() const{
+	return blockSize;
+}
+
+/*
+	@return 	The number of blocks started so far
+*/
+unsigned long long VertexScheduler::getNumberOfBlocks() const{
+	return blocks;
+}
+
+/*
+	The function getSelectionDispersion() computes the index of dispersion, i.e. the
+	variance divided by the mean, of the number of selections of the vertex indices in
+	each translation phase and averages it over all phases weighted by their number of
+	selections.
+
+	@return 	The average index of dispersion of the selections, 0 if there were none
+
+	Note:
+		Independent uniform selections result in an index of dispersion of about 1,
+		selections in blocks increase it, as the vertices of a bucket get selected in
+		bursts
+*/
+double VertexScheduler::getSelectionDispersion() const{
+	double sum = dispersionSum + getPhaseDispersion() * phaseSelections;
+	unsigned long long weight = dispersionWeight + phaseSelections;
+
+	if(weight == 0)
+		return 0;
+
+	return sum / weight;
+}
+
+
+/*
+	O ~ T ~ H ~ E ~ R ~ S
+*/
+
+/*
+	The function prepare() sorts the vertices of the triangulation along a Hilbert curve
+	over their bounding box. It must be called at the start of each translation phase,
+	as the order deteriorates with the translations.
+
+	@param 	T 	The triangulation the polygon lives in
+
+	Note:
+		- Vertices in the same cell of the Hilbert curve keep the order of their indices
+		- Empty indices of the vertices vector are kept at the end of the order, such
+			that they are selected as often as without the scheduler
+		- The actual block gets dropped and the counting of the selections of a new
+			translation phase starts
+*/
+void VertexScheduler::prepare(Triangulation const * const T){
+	int i, n = (*T).getActualNumberOfVertices();
+	std::vector<std::pair<unsigned long long, int>> keys;
+	double minX, minY, maxX, maxY;
+	bool first = true;
+	Vertex *v;
+
+	// Get the bounding box of the vertices
+	minX = maxX = minY = maxY = 0;
+	for(i = 0; i < n; i++){
+		v = (*T).getVertex(i);
+		if(v == NULL)
+			continue;
+
+		if(first){
+			minX = maxX = (*v).getX();
+			minY = maxY = (*v).getY();
+			first = false;
+		}else{
+			minX = std::min(minX, (*v).getX());
+			maxX = std::max(maxX, (*v).getX());
+			minY = std::min(minY, (*v).getY());
+			maxY = std::max(maxY, (*v).getY());
+		}
+	}
+
+	keys.reserve(n);
+	for(i = 0; i < n; i++){
+		v = (*T).getVertex(i);
+		if(v == NULL)
+			keys.push_back(std::make_pair(std::numeric_limits<unsigned long long>::max(), i));
+		else
+			keys.push_back(std::make_pair((*v).getHilbertIndex(minX, minY,
+				std::max(maxX - minX, maxY - minY)), i));
+	}
+
+	std::sort(keys.begin(), keys.end());
+
+	order.resize(n);
+	rank.resize(n);
+	for(i = 0; i < n; i++){
+		order[i] = keys[i].second;
+		rank[keys[i].second] = i;
+	}
+
+	// Finish the counting of the previous phase
+	dispersionSum = dispersionSum + getPhaseDispersion() * phaseSelections;
+	dispersionWeight = dispersionWeight + phaseSelections;
+	selections.assign(n, 0);
+	phaseSelections = 0;
+
+	remaining = 0;
+}
+
+/*
+	The function getIndex() selects the next vertex.
+
+	@return 	The index of the selected vertex in the vertices vector of the
+				triangulation
+*/
+int VertexScheduler::getIndex(){
+	int index;
+
+	// Start a new block at the bucket of a uniformly selected vertex
+	if(remaining == 0){
+		bucketStart = rank[(*Settings::generator).getRandomIndex(order.size())];
+		bucketStart = bucketStart - bucketStart % blockSize;
+		bucketSize = std::min((int)blockSize, (int)order.size() - bucketStart);
+
+		remaining = blockSize;
+		blocks++;
+	}
+
+	remaining--;
+
+	index = order[bucketStart + (*Settings::generator).getRandomIndex(bucketSize)];
+	selections[index]++;
+	phaseSelections++;
+
+	return index;
+}
@@ -0,0 +1,160 @@
+/*
+ * Copyright 2021 Philipp Mayer - pmayer@cs.sbg.ac.at
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "workerPool.h"
+
+/*
+	P ~ R ~ I ~ V ~ A ~ T ~ E 	M ~ E ~ M ~ B ~ E ~ R 	F ~ U ~ N ~ C ~ T ~ I ~ O ~ N ~ S
+*/
+
+/*
+	The function work() is the main loop of a worker thread.
+
+	@param 	w 	The index of the worker
+*/
+void WorkerPool::work(const unsigned int w){
+	unsigned long long seen = 0;
+
+	while(true){
+		{
+			std::unique_lock<std::mutex> lock(m);
+			startCV.wait(lock, [&]{ return stop || step != seen; });
+
+			if(stop)
+				return;
+
+			seen = step;
+		}
+
+		process();
+
+		// Hand over the counters of this thread
+		counters[w] = Statistics::collectCounters();
+		Statistics::resetCounters();
+
+		{
+			std::lock_guard<std::mutex> lock(m);
+			running--;
+			if(running == 0)
+				finishedCV.notify_one();
+		}
+	}
+}
+
+/*
+	The function process() calls the task for indices until all indices of the actual
+	step are assigned.
+*/
+void WorkerPool::process(){
+	int i;
+
+	while((i = next++) < nrTasks)
+		task(i);
+}
+
+
+/*
+	C ~ O ~ N ~ S ~ T ~ R ~ U ~ C ~ T ~ O ~ R ~ S
+*/
+
+/*
+	Constructor:
+	Starts nrThreads - 1 worker threads, as the thread calling run() works as well.
+
+	@param 	nrThreads 	The total number of threads working on a step
+*/
+WorkerPool::WorkerPool(const unsigned int nrThreads) :
+	nrTasks(0), next(0), step(0), running(0), stop(false), counters(nrThreads){
+
+	unsigned int w;
+
+	for(w = 1; w < nrThreads; w++)
+		threads.push_back(std::thread(&WorkerPool::work, this, w));
+}
+
+
+/*
+	G ~ E ~ T ~ T ~ E ~ R ~ S
+*/
+
+/*
+	@return 	The total number of threads working on a step
+*/
+unsigned int WorkerPool::getNrThreads() const{
+	return threads.size() + 1;
+}
+
+
+/*
+	O ~ T ~ H ~ E ~ R ~ S
+*/
+
+/*
+	The function run() calls f for all indices from 0 to n - 1 distributed over all
+	threads of the pool and returns after all calls are finished. Afterwards it merges
+	the translation counters of the workers into the ones of the calling thread.
+
+	@param 	n 	The number of indices
+	@param 	f 	The task to be called for each index
+
+	Note:
+		The calls of f run concurrently, so f must not change anything another call
+		reads
+*/
+void WorkerPool::run(const int n, std::function<void(const int)> f){
+	unsigned int w;
+
+	{
+		std::lock_guard<std::mutex> lock(m);
+		task = f;
+		nrTasks = n;
+		next = 0;
+		running = threads.size();
+		step++;
+	}
+	startCV.notify_all();
+
+	// The calling thread works as well
+	process();
+
+	{
+		std::unique_lock<std::mutex> lock(m);
+		finishedCV.wait(lock, [&]{ return running == 0; });
+	}
+
+	for(w = 1; w < counters.size(); w++)
+		Statistics::addCounters(counters[w]);
+}
+
+
+/*
+	D ~ E ~ S ~ T ~ R ~ U ~ C ~ T ~ O ~ R
+*/
+
+/*
+	Destructor:
+	Stops and joins all worker threads.
+*/
+WorkerPool::~WorkerPool(){
+	{
+		std::lock_guard<std::mutex> lock(m);
+		stop = true;
+	}
+	startCV.notify_all();
+
+	for(auto& t : threads)
+		t.join();
+}